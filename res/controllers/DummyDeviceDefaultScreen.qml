@@ -39,8 +39,10 @@ Mixxx.ControllerScreen {
         loader.sourceComponent = splash
     }
 
-    // function transformFrame(input: ArrayBuffer, timestamp: date) {
-    transformFrame: function(input, timestamp) {
+    // function transformFrame(input: ArrayBuffer, timestamp: date, dirtyRect: {x, y, width, height}) {
+    // Only frames that differ from the previous frame are passed. Devices
+    // that support partial updates may only send the dirtyRect region.
+    transformFrame: function(input, timestamp, dirtyRect) {
         return new ArrayBuffer(0);
     }
 
@@ -13,6 +13,25 @@
 #include "track/beatfactory.h"
 #include "track/track.h"
 
+namespace {
+
+QString provisionalSubVersionEntry() {
+    return QString::fromLatin1(mixxx::kProvisionalAnalysisVersionKey) +
+            QStringLiteral("=1");
+}
+
+bool isProvisionalSubVersion(const QString& subVersion) {
+    return subVersion.split(QChar('|')).contains(provisionalSubVersionEntry());
+}
+
+QString removeProvisionalSubVersion(const QString& subVersion) {
+    QStringList entries = subVersion.split(QChar('|'));
+    entries.removeAll(provisionalSubVersionEntry());
+    return entries.join(QChar('|'));
+}
+
+} // namespace
+
 // static
 QList<mixxx::AnalyzerPluginInfo> AnalyzerBeats::availablePlugins() {
     QList<mixxx::AnalyzerPluginInfo> plugins;
@@ -37,6 +56,7 @@ AnalyzerBeats::AnalyzerBeats(UserSettingsPointer pConfig, bool enforceBpmDetecti
           m_bPreferencesFixedTempo(true),
           m_bPreferencesFastAnalysis(false),
           m_maxFramesToProcess(0),
+          m_provisionalFramesToProcess(0),
           m_currentFrame(0) {
 }
 
@@ -102,17 +122,9 @@ bool AnalyzerBeats::initialize(const AnalyzerTrack& track,
     bool bShouldAnalyze = shouldAnalyze(track.getTrack());
 
     DEBUG_ASSERT(!m_pPlugin);
+    DEBUG_ASSERT(!m_pProvisionalPlugin);
     if (bShouldAnalyze) {
-        if (m_pluginId == mixxx::AnalyzerQueenMaryBeats::pluginInfo().id()) {
-            m_pPlugin = std::make_unique<mixxx::AnalyzerQueenMaryBeats>();
-        } else if (m_pluginId == mixxx::AnalyzerSoundTouchBeats::pluginInfo().id()) {
-            m_pPlugin = std::make_unique<mixxx::AnalyzerSoundTouchBeats>();
-        } else {
-            // This must not happen, because we have already verified above
-            // that the PlugInId is valid
-            DEBUG_ASSERT(false);
-        }
-
+        m_pPlugin = createPlugin();
         if (m_pPlugin) {
             if (m_pPlugin->initialize(m_sampleRate)) {
                 qDebug() << "Beat calculation started with plugin" << m_pluginId;
@@ -125,9 +137,38 @@ bool AnalyzerBeats::initialize(const AnalyzerTrack& track,
             bShouldAnalyze = false;
         }
     }
+
+    // Without any beat grid sync and quantize are unavailable until the
+    // whole track has been analyzed. A second plugin instance only analyzes
+    // the beginning of the track like in fast analysis mode and publishes
+    // its result in the meantime.
+    m_provisionalFramesToProcess = mixxx::kFastAnalysisSecondsToAnalyze * m_sampleRate;
+    if (bShouldAnalyze &&
+            track.getOptions().publishProvisionalResults &&
+            m_maxFramesToProcess > m_provisionalFramesToProcess &&
+            !track.getTrack()->getBeats()) {
+        m_pProvisionalPlugin = createPlugin();
+        if (m_pProvisionalPlugin && m_pProvisionalPlugin->initialize(m_sampleRate)) {
+            m_pProvisionalTrack = track.getTrack();
+        } else {
+            m_pProvisionalPlugin.reset();
+        }
+    }
     return bShouldAnalyze;
 }
 
+std::unique_ptr<mixxx::AnalyzerBeatsPlugin> AnalyzerBeats::createPlugin() const {
+    if (m_pluginId == mixxx::AnalyzerQueenMaryBeats::pluginInfo().id()) {
+        return std::make_unique<mixxx::AnalyzerQueenMaryBeats>();
+    } else if (m_pluginId == mixxx::AnalyzerSoundTouchBeats::pluginInfo().id()) {
+        return std::make_unique<mixxx::AnalyzerSoundTouchBeats>();
+    }
+    // This must not happen, because we have already verified
+    // that the PlugInId is valid
+    DEBUG_ASSERT(false);
+    return nullptr;
+}
+
 bool AnalyzerBeats::shouldAnalyze(TrackPointer pTrack) const {
     bool bpmLock = pTrack->isBpmLocked();
     if (bpmLock) {
@@ -160,6 +201,10 @@ bool AnalyzerBeats::shouldAnalyze(TrackPointer pTrack) const {
     }
 
     QString subVersion = pBeats->getSubVersion();
+    if (isProvisionalSubVersion(subVersion)) {
+        qDebug() << "Re-analyzing track with provisional beats.";
+        return true;
+    }
     if (subVersion == mixxx::rekordboxconstants::beatsSubversion) {
         return m_bPreferencesReanalyzeImported;
     }
@@ -232,11 +277,22 @@ bool AnalyzerBeats::processSamples(const CSAMPLE* pIn, SINT count) {
     }
 
     m_currentFrame += numFrames;
-    if (m_currentFrame > m_maxFramesToProcess) {
-        return true; // silently ignore all remaining samples
+    if (m_pProvisionalPlugin) {
+        if (m_currentFrame <= m_provisionalFramesToProcess) {
+            if (!m_pProvisionalPlugin->processSamples(pBeatInput, count)) {
+                // Only the provisional result is lost
+                m_pProvisionalPlugin.reset();
+            }
+        } else {
+            publishProvisionalBeats();
+        }
     }
 
-    bool ret = m_pPlugin->processSamples(pBeatInput, count);
+    bool ret = true;
+    // Silently ignore all remaining samples
+    if (m_currentFrame <= m_maxFramesToProcess) {
+        ret = m_pPlugin->processSamples(pBeatInput, count);
+    }
     if (pDrumChannel) {
         SampleUtil::free(pDrumChannel);
     }
@@ -244,7 +300,49 @@ bool AnalyzerBeats::processSamples(const CSAMPLE* pIn, SINT count) {
 }
 
 void AnalyzerBeats::cleanup() {
+    if (m_pProvisionalBeats) {
+        keepModifiedProvisionalBeats();
+    }
     m_pPlugin.reset();
+    m_pProvisionalPlugin.reset();
+    m_pProvisionalTrack.reset();
+    m_pProvisionalBeats.reset();
+}
+
+void AnalyzerBeats::publishProvisionalBeats() {
+    DEBUG_ASSERT(m_pProvisionalPlugin);
+    DEBUG_ASSERT(m_pProvisionalTrack);
+    const auto pPlugin = std::move(m_pProvisionalPlugin);
+    if (!pPlugin->finalize()) {
+        qWarning() << "Provisional beat/BPM analysis failed";
+        return;
+    }
+    if (m_pProvisionalTrack->getBeats()) {
+        // Don't override beats that have been set in the meantime
+        return;
+    }
+    // The provisional beats are kept if the analysis of the whole track is
+    // aborted. Their sub-version ensures that the track is analyzed again.
+    m_pProvisionalBeats = makeBeats(pPlugin.get(), true, true, m_pProvisionalTrack);
+    if (m_pProvisionalBeats && m_pProvisionalTrack->trySetBeats(m_pProvisionalBeats)) {
+        qDebug() << "AnalyzerBeats published provisional beats";
+    } else {
+        m_pProvisionalBeats.reset();
+    }
+}
+
+void AnalyzerBeats::keepModifiedProvisionalBeats() {
+    DEBUG_ASSERT(m_pProvisionalTrack);
+    // Beats that have been adjusted by the user inherit the provisional
+    // sub-version. The track must not be analyzed again because of that,
+    // otherwise the next analysis would silently replace the adjustments.
+    const mixxx::BeatsPointer pBeats = m_pProvisionalTrack->getBeats();
+    if (!pBeats || pBeats == m_pProvisionalBeats ||
+            !isProvisionalSubVersion(pBeats->getSubVersion())) {
+        return;
+    }
+    m_pProvisionalTrack->trySetBeats(pBeats->withSubVersion(
+            removeProvisionalSubVersion(pBeats->getSubVersion())));
 }
 
 void AnalyzerBeats::storeResults(TrackPointer pTrack) {
@@ -257,11 +355,26 @@ void AnalyzerBeats::storeResults(TrackPointer pTrack) {
         return;
     }
 
+    if (m_pProvisionalBeats && pTrack->getBeats() != m_pProvisionalBeats) {
+        qDebug() << "Beat/BPM analysis result discarded, because the"
+                 << "provisional beats have been modified";
+        return;
+    }
+
+    const mixxx::BeatsPointer pBeats = makeBeats(
+            m_pPlugin.get(), m_bPreferencesFastAnalysis, false, pTrack);
+    pTrack->trySetBeats(pBeats);
+}
+
+mixxx::BeatsPointer AnalyzerBeats::makeBeats(mixxx::AnalyzerBeatsPlugin* pPlugin,
+        bool bFastAnalysis,
+        bool bProvisional,
+        const TrackPointer& pTrack) const {
     mixxx::BeatsPointer pBeats;
-    if (m_pPlugin->supportsBeatTracking()) {
-        QVector<mixxx::audio::FramePos> beats = m_pPlugin->getBeats();
-        QHash<QString, QString> extraVersionInfo = getExtraVersionInfo(
-                m_pluginId, m_bPreferencesFastAnalysis);
+    const QHash<QString, QString> extraVersionInfo = getExtraVersionInfo(
+            m_pluginId, bFastAnalysis, bProvisional);
+    if (pPlugin->supportsBeatTracking()) {
+        QVector<mixxx::audio::FramePos> beats = pPlugin->getBeats();
         pBeats = BeatFactory::makePreferredBeats(
                 beats,
                 extraVersionInfo,
@@ -276,21 +389,32 @@ void AnalyzerBeats::storeResults(TrackPointer pTrack) {
                                               pBeats->getSampleRate()})
                             : mixxx::Bpm());
     } else {
-        mixxx::Bpm bpm = m_pPlugin->getBpm();
+        mixxx::Bpm bpm = pPlugin->getBpm();
         qDebug() << "AnalyzerBeats plugin detected constant BPM: " << bpm;
-        pBeats = mixxx::Beats::fromConstTempo(m_sampleRate, mixxx::audio::kStartFramePos, bpm);
+        if (bProvisional) {
+            pBeats = mixxx::Beats::fromConstTempo(m_sampleRate,
+                    mixxx::audio::kStartFramePos,
+                    bpm,
+                    BeatFactory::getPreferredSubVersion(extraVersionInfo));
+        } else {
+            pBeats = mixxx::Beats::fromConstTempo(
+                    m_sampleRate, mixxx::audio::kStartFramePos, bpm);
+        }
     }
 
-    pTrack->trySetBeats(pBeats);
+    return pBeats;
 }
 
 // static
 QHash<QString, QString> AnalyzerBeats::getExtraVersionInfo(
-        const QString& pluginId, bool bPreferencesFastAnalysis) {
+        const QString& pluginId, bool bPreferencesFastAnalysis, bool bProvisional) {
     QHash<QString, QString> extraVersionInfo;
     extraVersionInfo["vamp_plugin_id"] = pluginId;
     if (bPreferencesFastAnalysis) {
         extraVersionInfo["fast_analysis"] = "1";
     }
+    if (bProvisional) {
+        extraVersionInfo[mixxx::kProvisionalAnalysisVersionKey] = "1";
+    }
     return extraVersionInfo;
 }
@@ -8,6 +8,7 @@
 #include "analyzer/plugins/analyzerplugin.h"
 #include "preferences/beatdetectionsettings.h"
 #include "preferences/usersettings.h"
+#include "track/beats.h"
 
 class AnalyzerBeats : public Analyzer {
   public:
@@ -29,11 +30,25 @@ class AnalyzerBeats : public Analyzer {
 
   private:
     bool shouldAnalyze(TrackPointer pTrack) const;
+    std::unique_ptr<mixxx::AnalyzerBeatsPlugin> createPlugin() const;
+    mixxx::BeatsPointer makeBeats(mixxx::AnalyzerBeatsPlugin* pPlugin,
+            bool bFastAnalysis,
+            bool bProvisional,
+            const TrackPointer& pTrack) const;
+    void publishProvisionalBeats();
+    void keepModifiedProvisionalBeats();
     static QHash<QString, QString> getExtraVersionInfo(
-            const QString& pluginId, bool bPreferencesFastAnalysis);
+            const QString& pluginId,
+            bool bPreferencesFastAnalysis,
+            bool bProvisional = false);
 
     BeatDetectionSettings m_bpmSettings;
     std::unique_ptr<mixxx::AnalyzerBeatsPlugin> m_pPlugin;
+    // Analyzes only the beginning of the track to publish a provisional
+    // beat grid until the analysis of the whole track is finished
+    std::unique_ptr<mixxx::AnalyzerBeatsPlugin> m_pProvisionalPlugin;
+    TrackPointer m_pProvisionalTrack;
+    mixxx::BeatsPointer m_pProvisionalBeats;
     const bool m_enforceBpmDetection;
     QString m_pluginId;
     bool m_bPreferencesReanalyzeOldBpm;
@@ -44,5 +59,6 @@ class AnalyzerBeats : public Analyzer {
     mixxx::audio::SampleRate m_sampleRate;
     mixxx::audio::ChannelCount m_channelCount;
     SINT m_maxFramesToProcess;
+    SINT m_provisionalFramesToProcess;
     SINT m_currentFrame;
 };
@@ -1,5 +1,7 @@
 #include "analyzer/analyzerebur128.h"
 
+#include <QThread>
+#include <QtConcurrentRun>
 #include <QtDebug>
 
 #include "analyzer/analyzertrack.h"
@@ -9,12 +11,51 @@
 #include "util/timer.h"
 
 namespace {
+
 constexpr double kReplayGain2ReferenceLUFS = -18;
+
+// The gating blocks of 400 ms overlap by 75%
+constexpr SINT kBlockHops = 4;
+
+// A segment needs to start with the last 3 hops of its predecessor to
+// complete the blocks that span the segment boundary
+constexpr SINT kOverlapHops = kBlockHops - 1;
+
+// Long enough to keep the overhead of the overlap and of the thread
+// handoff small, short enough to keep the memory of the pending segments
+// bounded and to split even short tracks
+constexpr SINT kSegmentHops = 100; // 10 s
+
+ebur128_state* measureSegment(
+        std::vector<CSAMPLE> samples,
+        mixxx::audio::SampleRate sampleRate,
+        mixxx::audio::ChannelCount channelCount) {
+    ScopedTimer t(QStringLiteral("AnalyzerEbur128::measureSegment()"));
+    ebur128_state* pState = ebur128_init(
+            channelCount,
+            sampleRate,
+            EBUR128_MODE_I);
+    if (!pState) {
+        return nullptr;
+    }
+    int e = ebur128_add_frames_float(pState,
+            samples.data(),
+            samples.size() / channelCount);
+    VERIFY_OR_DEBUG_ASSERT(e == EBUR128_SUCCESS) {
+        qWarning() << "AnalyzerEbur128::measureSegment() failed with" << e;
+        ebur128_destroy(&pState);
+        return nullptr;
+    }
+    return pState;
+}
+
 } // anonymous namespace
 
 AnalyzerEbur128::AnalyzerEbur128(UserSettingsPointer pConfig)
         : m_rgSettings(pConfig),
-          m_pState(nullptr) {
+          m_hopFrames(0),
+          m_segmentFrames(0),
+          m_overlapFrames(0) {
 }
 
 AnalyzerEbur128::~AnalyzerEbur128() {
@@ -30,42 +71,110 @@ bool AnalyzerEbur128::initialize(
         qDebug() << "Skipping AnalyzerEbur128";
         return false;
     }
-    DEBUG_ASSERT(m_pState == nullptr);
-    m_pState = ebur128_init(
-            channelCount,
-            sampleRate,
-            EBUR128_MODE_I);
-    return m_pState != nullptr;
+    DEBUG_ASSERT(m_segmentStates.empty());
+    DEBUG_ASSERT(m_pendingSegments.empty());
+    m_sampleRate = sampleRate;
+    m_channelCount = channelCount;
+    // Same rounding as in libebur128
+    m_hopFrames = (sampleRate + 5) / 10;
+    m_segmentFrames = kSegmentHops * m_hopFrames;
+    m_segmentSamples.clear();
+    m_segmentSamples.reserve((m_segmentFrames + kOverlapHops * m_hopFrames) * channelCount);
+    m_overlapFrames = 0;
+    return m_hopFrames > 0;
 }
 
 void AnalyzerEbur128::cleanup() {
-    if (m_pState) {
-        ebur128_destroy(&m_pState);
-        // ebur128_destroy clears the pointer but let's not rely on that.
-        m_pState = nullptr;
+    while (!m_pendingSegments.empty()) {
+        waitForSegment();
+    }
+    for (ebur128_state* pState : m_segmentStates) {
+        ebur128_destroy(&pState);
+    }
+    m_segmentStates.clear();
+    m_segmentSamples.clear();
+    m_segmentSamples.shrink_to_fit();
+    m_overlapFrames = 0;
+}
+
+bool AnalyzerEbur128::waitForSegment() {
+    DEBUG_ASSERT(!m_pendingSegments.empty());
+    ebur128_state* pState = m_pendingSegments.front().result();
+    m_pendingSegments.pop_front();
+    if (!pState) {
+        return false;
     }
+    m_segmentStates.push_back(pState);
+    return true;
+}
+
+void AnalyzerEbur128::submitSegment() {
+    const SINT overlapSamples = kOverlapHops * m_hopFrames * m_channelCount;
+    DEBUG_ASSERT(static_cast<SINT>(m_segmentSamples.size()) >= overlapSamples);
+    std::vector<CSAMPLE> nextSegmentSamples;
+    nextSegmentSamples.reserve(m_segmentSamples.capacity());
+    nextSegmentSamples.assign(m_segmentSamples.end() - overlapSamples,
+            m_segmentSamples.end());
+    m_pendingSegments.push_back(QtConcurrent::run(measureSegment,
+            std::move(m_segmentSamples),
+            m_sampleRate,
+            m_channelCount));
+    m_segmentSamples = std::move(nextSegmentSamples);
+    m_overlapFrames = kOverlapHops * m_hopFrames;
 }
 
 bool AnalyzerEbur128::processSamples(const CSAMPLE* pIn, SINT count) {
-    VERIFY_OR_DEBUG_ASSERT(m_pState) {
+    VERIFY_OR_DEBUG_ASSERT(m_hopFrames > 0) {
         return false;
     }
     ScopedTimer t(QStringLiteral("AnalyzerEbur128::processSamples()"));
-    size_t frames = count / m_pState->channels;
-    int e = ebur128_add_frames_float(m_pState, pIn, frames);
-    VERIFY_OR_DEBUG_ASSERT(e == EBUR128_SUCCESS) {
-        qWarning() << "AnalyzerEbur128::processSamples() failed with" << e;
-        return false;
+    while (count > 0) {
+        const SINT segmentSamples =
+                (m_overlapFrames + m_segmentFrames) * m_channelCount;
+        const SINT copySamples = math_min(count,
+                segmentSamples - static_cast<SINT>(m_segmentSamples.size()));
+        m_segmentSamples.insert(m_segmentSamples.end(), pIn, pIn + copySamples);
+        pIn += copySamples;
+        count -= copySamples;
+        if (static_cast<SINT>(m_segmentSamples.size()) < segmentSamples) {
+            break;
+        }
+        // Limit the number of pending segments, their samples are kept
+        // in memory until they have been measured
+        while (static_cast<int>(m_pendingSegments.size()) >=
+                math_max(1, QThread::idealThreadCount())) {
+            if (!waitForSegment()) {
+                return false;
+            }
+        }
+        submitSegment();
     }
     return true;
 }
 
 void AnalyzerEbur128::storeResults(TrackPointer pTrack) {
-    VERIFY_OR_DEBUG_ASSERT(m_pState) {
+    // The last segment is measured on the analyzer thread while the
+    // pending segments are finished
+    if (static_cast<SINT>(m_segmentSamples.size()) > m_overlapFrames * m_channelCount) {
+        ebur128_state* pState = measureSegment(
+                std::move(m_segmentSamples), m_sampleRate, m_channelCount);
+        m_segmentSamples.clear();
+        VERIFY_OR_DEBUG_ASSERT(pState) {
+            return;
+        }
+        m_segmentStates.push_back(pState);
+    }
+    while (!m_pendingSegments.empty()) {
+        VERIFY_OR_DEBUG_ASSERT(waitForSegment()) {
+            return;
+        }
+    }
+    VERIFY_OR_DEBUG_ASSERT(!m_segmentStates.empty()) {
         return;
     }
     double averageLufs;
-    int e = ebur128_loudness_global(m_pState, &averageLufs);
+    int e = ebur128_loudness_global_multiple(
+            m_segmentStates.data(), m_segmentStates.size(), &averageLufs);
     VERIFY_OR_DEBUG_ASSERT(e == EBUR128_SUCCESS) {
         qWarning() << "AnalyzerEbur128::storeResults() failed with" << e;
         return;
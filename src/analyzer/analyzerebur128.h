@@ -2,9 +2,23 @@
 
 #include <ebur128.h>
 
+#include <QFuture>
+#include <deque>
+#include <vector>
+
 #include "analyzer/analyzer.h"
 #include "preferences/replaygainsettings.h"
 
+/// Measures the integrated loudness according to EBU R128 for ReplayGain 2.0.
+///
+/// The track is split into segments that are measured independently on the
+/// global thread pool while the analyzer thread continues decoding and
+/// running the other analyzers. Each segment starts with the last 300 ms
+/// of its predecessor. Segment boundaries are aligned to the 100 ms hop
+/// between the overlapping 400 ms gating blocks, so together the segments
+/// produce the same gating blocks as a single pass over the whole track.
+/// The blocks of all segments are gated together when the results are
+/// stored.
 class AnalyzerEbur128 : public Analyzer {
   public:
     AnalyzerEbur128(UserSettingsPointer pConfig);
@@ -23,6 +37,19 @@ class AnalyzerEbur128 : public Analyzer {
     void cleanup() override;
 
   private:
+    void submitSegment();
+    bool waitForSegment();
+
     ReplayGainSettings m_rgSettings;
-    ebur128_state* m_pState;
+    mixxx::audio::SampleRate m_sampleRate;
+    mixxx::audio::ChannelCount m_channelCount;
+    SINT m_hopFrames;
+    SINT m_segmentFrames;
+    // Samples of the segment that is currently filled, including the
+    // overlap with the previous segment
+    std::vector<CSAMPLE> m_segmentSamples;
+    // Frames of m_segmentSamples that overlap with the previous segment
+    SINT m_overlapFrames;
+    std::deque<QFuture<ebur128_state*>> m_pendingSegments;
+    std::vector<ebur128_state*> m_segmentStates;
 };
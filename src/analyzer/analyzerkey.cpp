@@ -14,6 +14,12 @@
 
 namespace {
 constexpr int excludeFirstChannelMask = 0x1;
+
+bool isProvisionalSubVersion(const QString& subVersion) {
+    return subVersion.split(QChar('|')).contains(
+            QString::fromLatin1(mixxx::kProvisionalAnalysisVersionKey) +
+            QStringLiteral("=1"));
+}
 } // namespace
 
 // static
@@ -39,6 +45,7 @@ AnalyzerKey::AnalyzerKey(const KeyDetectionSettings& keySettings)
           m_sampleRate(0),
           m_totalFrames(0),
           m_maxFramesToProcess(0),
+          m_provisionalFramesToProcess(0),
           m_currentFrame(0),
           m_bPreferencesKeyDetectionEnabled(true),
           m_bPreferencesFastAnalysisEnabled(false),
@@ -95,19 +102,9 @@ bool AnalyzerKey::initialize(const AnalyzerTrack& track,
     bool bShouldAnalyze = shouldAnalyze(track.getTrack());
 
     DEBUG_ASSERT(!m_pPlugin);
+    DEBUG_ASSERT(!m_pProvisionalPlugin);
     if (bShouldAnalyze) {
-        if (m_pluginId == mixxx::AnalyzerQueenMaryKey::pluginInfo().id()) {
-            m_pPlugin = std::make_unique<mixxx::AnalyzerQueenMaryKey>();
-#if defined __KEYFINDER__
-        } else if (m_pluginId == mixxx::AnalyzerKeyFinder::pluginInfo().id()) {
-            m_pPlugin = std::make_unique<mixxx::AnalyzerKeyFinder>();
-#endif
-        } else {
-            // This must not happen, because we have already verified above
-            // that the PlugInId is valid
-            DEBUG_ASSERT(false);
-        }
-
+        m_pPlugin = createPlugin();
         if (m_pPlugin) {
             if (m_pPlugin->initialize(mixxx::audio::SampleRate(m_sampleRate))) {
                 qDebug() << "Key calculation started with plugin" << m_pluginId;
@@ -120,9 +117,38 @@ bool AnalyzerKey::initialize(const AnalyzerTrack& track,
             bShouldAnalyze = false;
         }
     }
+
+    // Like AnalyzerBeats publish the key of the beginning of the track
+    // while the whole track is still being analyzed
+    m_provisionalFramesToProcess = mixxx::kFastAnalysisSecondsToAnalyze * m_sampleRate;
+    if (bShouldAnalyze &&
+            track.getOptions().publishProvisionalResults &&
+            m_maxFramesToProcess > m_provisionalFramesToProcess &&
+            track.getTrack()->getKeys().getGlobalKey() == mixxx::track::io::key::INVALID) {
+        m_pProvisionalPlugin = createPlugin();
+        if (m_pProvisionalPlugin && m_pProvisionalPlugin->initialize(m_sampleRate)) {
+            m_pProvisionalTrack = track.getTrack();
+        } else {
+            m_pProvisionalPlugin.reset();
+        }
+    }
     return bShouldAnalyze;
 }
 
+std::unique_ptr<mixxx::AnalyzerKeyPlugin> AnalyzerKey::createPlugin() const {
+    if (m_pluginId == mixxx::AnalyzerQueenMaryKey::pluginInfo().id()) {
+        return std::make_unique<mixxx::AnalyzerQueenMaryKey>();
+#if defined __KEYFINDER__
+    } else if (m_pluginId == mixxx::AnalyzerKeyFinder::pluginInfo().id()) {
+        return std::make_unique<mixxx::AnalyzerKeyFinder>();
+#endif
+    }
+    // This must not happen, because we have already verified
+    // that the PlugInId is valid
+    DEBUG_ASSERT(false);
+    return nullptr;
+}
+
 bool AnalyzerKey::shouldAnalyze(TrackPointer pTrack) const {
     bool bPreferencesFastAnalysisEnabled = m_keySettings.getFastAnalysis();
     QString pluginID = m_keySettings.getKeyPluginId();
@@ -134,6 +160,10 @@ bool AnalyzerKey::shouldAnalyze(TrackPointer pTrack) const {
     if (keys.getGlobalKey() != mixxx::track::io::key::INVALID) {
         QString version = keys.getVersion();
         QString subVersion = keys.getSubVersion();
+        if (isProvisionalSubVersion(subVersion)) {
+            qDebug() << "Re-analyzing track with provisional keys.";
+            return true;
+        }
 
         QHash<QString, QString> extraVersionInfo = getExtraVersionInfo(
                 pluginID, bPreferencesFastAnalysisEnabled);
@@ -164,6 +194,10 @@ bool AnalyzerKey::processSamples(const CSAMPLE* pIn, SINT count) {
     SINT numFrames = count / m_channelCount;
     m_currentFrame += numFrames;
 
+    if (m_pProvisionalPlugin && m_currentFrame > m_provisionalFramesToProcess) {
+        publishProvisionalKeys();
+    }
+
     if (m_currentFrame > m_maxFramesToProcess) {
         return true; // silently ignore remaining samples
     }
@@ -201,6 +235,10 @@ bool AnalyzerKey::processSamples(const CSAMPLE* pIn, SINT count) {
         return false;
     }
 
+    if (m_pProvisionalPlugin && !m_pProvisionalPlugin->processSamples(pKeyInput, count)) {
+        // Only the provisional result is lost
+        m_pProvisionalPlugin.reset();
+    }
     bool ret = m_pPlugin->processSamples(pKeyInput, count);
     if (pHarmonicMixedChannel) {
         SampleUtil::free(pHarmonicMixedChannel);
@@ -210,6 +248,33 @@ bool AnalyzerKey::processSamples(const CSAMPLE* pIn, SINT count) {
 
 void AnalyzerKey::cleanup() {
     m_pPlugin.reset();
+    m_pProvisionalPlugin.reset();
+    m_pProvisionalTrack.reset();
+    m_provisionalKeys.reset();
+}
+
+void AnalyzerKey::publishProvisionalKeys() {
+    DEBUG_ASSERT(m_pProvisionalPlugin);
+    DEBUG_ASSERT(m_pProvisionalTrack);
+    const auto pPlugin = std::move(m_pProvisionalPlugin);
+    if (!pPlugin->finalize()) {
+        qWarning() << "Provisional key detection failed";
+        return;
+    }
+    if (m_pProvisionalTrack->getKeys().getGlobalKey() != mixxx::track::io::key::INVALID) {
+        // Don't override a key that has been set in the meantime
+        return;
+    }
+    // The provisional keys are kept if the analysis of the whole track is
+    // aborted. Their sub-version ensures that the track is analyzed again.
+    const QHash<QString, QString> extraVersionInfo =
+            getExtraVersionInfo(m_pluginId, true, true);
+    m_provisionalKeys = KeyFactory::makePreferredKeys(pPlugin->getKeyChanges(),
+            extraVersionInfo,
+            m_sampleRate,
+            m_totalFrames);
+    m_pProvisionalTrack->setKeys(*m_provisionalKeys);
+    qDebug() << "AnalyzerKey published provisional keys";
 }
 
 void AnalyzerKey::storeResults(TrackPointer tio) {
@@ -222,6 +287,12 @@ void AnalyzerKey::storeResults(TrackPointer tio) {
         return;
     }
 
+    if (m_provisionalKeys && !(tio->getKeys() == *m_provisionalKeys)) {
+        qDebug() << "Key detection result discarded, because the"
+                 << "provisional key has been modified";
+        return;
+    }
+
     KeyChangeList key_changes = m_pPlugin->getKeyChanges();
     QHash<QString, QString> extraVersionInfo = getExtraVersionInfo(
             m_pluginId, m_bPreferencesFastAnalysisEnabled);
@@ -232,11 +303,14 @@ void AnalyzerKey::storeResults(TrackPointer tio) {
 
 // static
 QHash<QString, QString> AnalyzerKey::getExtraVersionInfo(
-        const QString& pluginId, bool bPreferencesFastAnalysis) {
+        const QString& pluginId, bool bPreferencesFastAnalysis, bool bProvisional) {
     QHash<QString, QString> extraVersionInfo;
     extraVersionInfo["vamp_plugin_id"] = pluginId;
     if (bPreferencesFastAnalysis) {
         extraVersionInfo["fast_analysis"] = "1";
     }
+    if (bProvisional) {
+        extraVersionInfo[mixxx::kProvisionalAnalysisVersionKey] = "1";
+    }
     return extraVersionInfo;
 }
@@ -4,10 +4,12 @@
 #include <QList>
 #include <QString>
 #include <memory>
+#include <optional>
 
 #include "analyzer/analyzer.h"
 #include "analyzer/plugins/analyzerplugin.h"
 #include "preferences/keydetectionsettings.h"
+#include "track/keys.h"
 #include "track/track_decl.h"
 
 class AnalyzerKey : public Analyzer {
@@ -28,17 +30,27 @@ class AnalyzerKey : public Analyzer {
 
   private:
     static QHash<QString, QString> getExtraVersionInfo(
-            const QString& pluginId, bool bPreferencesFastAnalysis);
+            const QString& pluginId,
+            bool bPreferencesFastAnalysis,
+            bool bProvisional = false);
 
     bool shouldAnalyze(TrackPointer tio) const;
+    std::unique_ptr<mixxx::AnalyzerKeyPlugin> createPlugin() const;
+    void publishProvisionalKeys();
 
     KeyDetectionSettings m_keySettings;
     std::unique_ptr<mixxx::AnalyzerKeyPlugin> m_pPlugin;
+    // Analyzes only the beginning of the track to publish a provisional
+    // key until the analysis of the whole track is finished
+    std::unique_ptr<mixxx::AnalyzerKeyPlugin> m_pProvisionalPlugin;
+    TrackPointer m_pProvisionalTrack;
+    std::optional<Keys> m_provisionalKeys;
     QString m_pluginId;
     mixxx::audio::SampleRate m_sampleRate;
     mixxx::audio::ChannelCount m_channelCount;
     SINT m_totalFrames;
     SINT m_maxFramesToProcess;
+    SINT m_provisionalFramesToProcess;
     SINT m_currentFrame;
 
     bool m_bPreferencesKeyDetectionEnabled;
@@ -10,6 +10,11 @@ class AnalyzerTrack {
     struct Options {
         /// If set, overrides whether the analysis should assume constant BPM.
         std::optional<bool> useFixedTempo;
+        /// If set, analyzers publish provisional results as soon as the
+        /// beginning of the track has been analyzed, e.g. for a track that
+        /// has just been loaded into a deck. The results of the whole track
+        /// replace them when the analysis is finished.
+        bool publishProvisionalResults = false;
     };
 
     explicit AnalyzerTrack(TrackPointer track, Options options = Options());
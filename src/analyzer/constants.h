@@ -14,7 +14,14 @@ constexpr SINT kAnalysisFramesPerChunk = 4096;
 constexpr SINT kAnalysisSamplesPerChunk =
         kAnalysisFramesPerChunk * kAnalysisMaxChannels;
 
-// Only analyze the first minute in fast-analysis mode.
+// Only analyze the first minute in fast-analysis mode. Provisional
+// results are published after the same duration.
 constexpr SINT kFastAnalysisSecondsToAnalyze = 60;
 
+// The sub-version of provisional results contains this key with the value
+// "1". They are replaced by the next analysis regardless of the
+// re-analysis preferences, e.g. if the analysis of the whole track has
+// been aborted.
+constexpr const char* kProvisionalAnalysisVersionKey = "provisional";
+
 }  // namespace mixxx
@@ -26,6 +26,12 @@ class ControlObjectScript : public ControlProxy {
             return m_scriptConnections.first(); };
     void disconnectAllConnectionsToFunction(const QJSValue& function);
 
+    /// Returns the ControlObject of the control, without looking it up by
+    /// its key. Null if the ControlObject has been deleted.
+    ControlObject* getControlObject() const {
+        return m_pControl ? m_pControl->getCreatorCO() : nullptr;
+    }
+
     // Called from update();
     void emitValueChanged() override {
         emit trigger(get(), this);
@@ -3,6 +3,7 @@
 #include <hidapi.h>
 
 #include "controllers/defs_controllers.h"
+#include "controllers/scripting/legacy/controllerscriptenginelegacy.h"
 #include "moc_hidcontroller.cpp"
 
 class LegacyControllerMapping;
@@ -194,6 +195,96 @@ int HidController::close() {
     return 0;
 }
 
+void HidController::receive(const QByteArray& data, mixxx::Duration timestamp) {
+    if (!m_inputReportParser.isEmpty()) {
+        auto pEngine = getScriptEngine();
+        if (!pEngine) {
+            return;
+        }
+        // Exposes the arrival time to engine.scratchTick() in field callbacks
+        pEngine->setInputTimestamp(timestamp);
+        const bool parsed = m_inputReportParser.parse(data);
+        pEngine->setInputTimestamp(mixxx::Duration::empty());
+        if (parsed) {
+            triggerActivity();
+            return;
+        }
+    }
+    Controller::receive(data, timestamp);
+}
+
+void HidController::slotBeforeEngineShutdown() {
+    Controller::slotBeforeEngineShutdown();
+    // The callbacks belong to the engine, the mapping declares the fields
+    // again when it is initialized
+    m_inputReportParser.clear();
+}
+
+bool HidController::registerInputReportField(const QJSValue& options) {
+    auto pEngine = getScriptEngine();
+    VERIFY_OR_DEBUG_ASSERT(pEngine) {
+        return false;
+    }
+    if (!options.isObject()) {
+        pEngine->throwJSError(QStringLiteral(
+                "controller.registerInputReportField expects an object"));
+        return false;
+    }
+
+    const QJSValue offset = options.property(QStringLiteral("offset"));
+    if (!offset.isNumber()) {
+        pEngine->throwJSError(QStringLiteral(
+                "controller.registerInputReportField: offset must be a number"));
+        return false;
+    }
+    const QJSValue packValue = options.property(QStringLiteral("pack"));
+    const auto pack = HidInputReportParser::packFromString(
+            packValue.isUndefined() ? QStringLiteral("B") : packValue.toString());
+    if (!pack) {
+        pEngine->throwJSError(QStringLiteral(
+                "controller.registerInputReportField: Invalid pack format %1")
+                                      .arg(packValue.toString()));
+        return false;
+    }
+
+    HidInputReportParser::Field field;
+    field.reportId = static_cast<quint8>(options.property(QStringLiteral("reportId")).toUInt());
+    field.offset = offset.toInt();
+    field.pack = *pack;
+    field.bitmask = options.property(QStringLiteral("bitmask")).toUInt();
+    const QJSValue min = options.property(QStringLiteral("min"));
+    if (min.isNumber()) {
+        field.min = min.toNumber();
+    }
+    const QJSValue max = options.property(QStringLiteral("max"));
+    if (max.isNumber()) {
+        field.max = max.toNumber();
+    }
+    const QJSValue group = options.property(QStringLiteral("group"));
+    const QJSValue name = options.property(QStringLiteral("name"));
+    if (group.isString() && name.isString()) {
+        field.control = ConfigKey(group.toString(), name.toString());
+    }
+
+    const QJSValue callback = options.property(QStringLiteral("callback"));
+    if (callback.isCallable()) {
+        const std::weak_ptr<ControllerScriptEngineLegacy> pWeakEngine = pEngine;
+        field.callback = [pWeakEngine, callback, group, name](double value) mutable {
+            auto pEngine = pWeakEngine.lock();
+            if (!pEngine) {
+                return;
+            }
+            pEngine->executeFunction(&callback, QJSValueList{value, group, name});
+        };
+    } else if (!callback.isUndefined()) {
+        pEngine->throwJSError(QStringLiteral(
+                "controller.registerInputReportField: callback must be a function"));
+        return false;
+    }
+
+    return m_inputReportParser.addField(field);
+}
+
 /// This function is only for class compatibility with the (midi)controller
 /// and will not do the same as for MIDI devices,
 /// because sending of raw bytes is not a supported HIDAPI feature.
@@ -2,6 +2,7 @@
 
 #include "controllers/controller.h"
 #include "controllers/hid/hiddevice.h"
+#include "controllers/hid/hidinputreportparser.h"
 #include "controllers/hid/hidiothread.h"
 #include "controllers/hid/legacyhidcontrollermapping.h"
 
@@ -76,16 +77,23 @@ class HidController final : public Controller {
   private slots:
     int open() override;
     int close() override;
+    /// Decodes reports with declared field layouts natively and passes all
+    /// other reports to the incomingData function of the mapping
+    void receive(const QByteArray& data, mixxx::Duration timestamp) override;
+    void slotBeforeEngineShutdown() override;
 
   private:
     // For devices which only support a single report, reportID must be set to
     // 0x0.
     bool sendBytes(const QByteArray& data) override;
 
+    bool registerInputReportField(const QJSValue& options);
+
     const mixxx::hid::DeviceInfo m_deviceInfo;
 
     std::unique_ptr<HidIoThread> m_pHidIoThread;
     std::shared_ptr<LegacyHidControllerMapping> m_pMapping;
+    HidInputReportParser m_inputReportParser;
 
     friend class HidControllerJSProxy;
 };
@@ -196,6 +204,29 @@ class HidControllerJSProxy : public ControllerJSProxy {
         return m_pHidController->m_pHidIoThread->getFeatureReport(reportID);
     }
 
+    /// @brief Declares a field of an InputReport, that is decoded natively
+    /// @details InputReports with declared fields are no longer passed to the
+    ///          incomingData function of the mapping. Each field is unpacked
+    ///          and compared to the previous report and only changed fields are
+    ///          dispatched. This is much cheaper than decoding every report in
+    ///          JavaScript, e.g. with common-hid-packet-parser.js.
+    /// @param options Object with the properties
+    ///  - reportId (optional): 1...255 for HID devices that use ReportIDs,
+    ///    0 (default) for devices which don't use ReportIDs
+    ///  - offset: Byte offset of the field, including the ReportID byte
+    ///  - pack (optional): "b", "B" (default), "h", "H", "i" or "I" as in
+    ///    common-hid-packet-parser.js
+    ///  - bitmask (optional): Selects the bits of the field
+    ///  - min, max (optional): Value range that is mapped onto the parameter
+    ///    range of the control, defaults to the range of pack and bitmask
+    ///  - group, name: The control that is set to the new parameter value
+    ///  - callback (optional): Called with (value, group, name) instead of
+    ///    setting the control
+    /// @return Returns false if the field is invalid
+    Q_INVOKABLE bool registerInputReportField(const QJSValue& options) {
+        return m_pHidController->registerInputReportField(options);
+    }
+
   private:
     HidController* m_pHidController;
 };
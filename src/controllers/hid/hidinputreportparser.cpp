@@ -0,0 +1,216 @@
+#include "controllers/hid/hidinputreportparser.h"
+
+#include <QtDebug>
+#include <limits>
+
+#include "util/assert.h"
+
+namespace {
+
+int packSize(HidInputReportParser::Pack pack) {
+    switch (pack) {
+    case HidInputReportParser::Pack::Int8:
+    case HidInputReportParser::Pack::UInt8:
+        return 1;
+    case HidInputReportParser::Pack::Int16:
+    case HidInputReportParser::Pack::UInt16:
+        return 2;
+    case HidInputReportParser::Pack::Int32:
+    case HidInputReportParser::Pack::UInt32:
+        return 4;
+    }
+    DEBUG_ASSERT(!"unreachable");
+    return 1;
+}
+
+template<typename T>
+void setPackRange(double* pMin, double* pMax) {
+    *pMin = std::numeric_limits<T>::min();
+    *pMax = std::numeric_limits<T>::max();
+}
+
+void packRange(HidInputReportParser::Pack pack, double* pMin, double* pMax) {
+    switch (pack) {
+    case HidInputReportParser::Pack::Int8:
+        setPackRange<qint8>(pMin, pMax);
+        return;
+    case HidInputReportParser::Pack::UInt8:
+        setPackRange<quint8>(pMin, pMax);
+        return;
+    case HidInputReportParser::Pack::Int16:
+        setPackRange<qint16>(pMin, pMax);
+        return;
+    case HidInputReportParser::Pack::UInt16:
+        setPackRange<quint16>(pMin, pMax);
+        return;
+    case HidInputReportParser::Pack::Int32:
+        setPackRange<qint32>(pMin, pMax);
+        return;
+    case HidInputReportParser::Pack::UInt32:
+        setPackRange<quint32>(pMin, pMax);
+        return;
+    }
+}
+
+qint64 unpack(const uchar* pData, HidInputReportParser::Pack pack) {
+    switch (pack) {
+    case HidInputReportParser::Pack::Int8:
+        return static_cast<qint8>(pData[0]);
+    case HidInputReportParser::Pack::UInt8:
+        return pData[0];
+    case HidInputReportParser::Pack::Int16:
+        return static_cast<qint16>(pData[0] | (pData[1] << 8));
+    case HidInputReportParser::Pack::UInt16:
+        return static_cast<quint16>(pData[0] | (pData[1] << 8));
+    case HidInputReportParser::Pack::Int32:
+        return static_cast<qint32>(static_cast<quint32>(pData[0]) |
+                (static_cast<quint32>(pData[1]) << 8) |
+                (static_cast<quint32>(pData[2]) << 16) |
+                (static_cast<quint32>(pData[3]) << 24));
+    case HidInputReportParser::Pack::UInt32:
+        return static_cast<quint32>(pData[0]) |
+                (static_cast<quint32>(pData[1]) << 8) |
+                (static_cast<quint32>(pData[2]) << 16) |
+                (static_cast<quint32>(pData[3]) << 24);
+    }
+    return 0;
+}
+
+} // namespace
+
+// static
+std::optional<HidInputReportParser::Pack> HidInputReportParser::packFromString(
+        const QString& pack) {
+    if (pack == QLatin1String("b")) {
+        return Pack::Int8;
+    } else if (pack == QLatin1String("B")) {
+        return Pack::UInt8;
+    } else if (pack == QLatin1String("h")) {
+        return Pack::Int16;
+    } else if (pack == QLatin1String("H")) {
+        return Pack::UInt16;
+    } else if (pack == QLatin1String("i")) {
+        return Pack::Int32;
+    } else if (pack == QLatin1String("I")) {
+        return Pack::UInt32;
+    }
+    return std::nullopt;
+}
+
+bool HidInputReportParser::addField(const Field& field) {
+    if (m_parsing) {
+        // The fields are iterated while parsing
+        qWarning() << "HidInputReportParser: Fields can't be added from a field callback";
+        return false;
+    }
+    if (field.offset < 0) {
+        qWarning() << "HidInputReportParser: Invalid offset" << field.offset;
+        return false;
+    }
+    if (!field.callback && !field.control.isValid()) {
+        qWarning() << "HidInputReportParser: Field at offset" << field.offset
+                   << "has neither a callback nor a valid control";
+        return false;
+    }
+
+    CompiledField compiledField;
+    compiledField.offset = field.offset;
+    compiledField.size = packSize(field.pack);
+    compiledField.pack = field.pack;
+    compiledField.bitmask = field.bitmask;
+    compiledField.shift = 0;
+    if (field.bitmask != 0) {
+        while (((field.bitmask >> compiledField.shift) & 1) == 0) {
+            ++compiledField.shift;
+        }
+        compiledField.min = 0;
+        compiledField.max = field.bitmask >> compiledField.shift;
+    } else {
+        packRange(field.pack, &compiledField.min, &compiledField.max);
+    }
+    compiledField.min = field.min.value_or(compiledField.min);
+    compiledField.max = field.max.value_or(compiledField.max);
+    if (compiledField.min == compiledField.max) {
+        qWarning() << "HidInputReportParser: Empty value range of field at offset"
+                   << field.offset;
+        return false;
+    }
+    compiledField.callback = field.callback;
+    if (!field.callback) {
+        compiledField.pControl = std::make_unique<PollingControlProxy>(
+                field.control, ControlFlag::AllowMissingOrInvalid);
+        if (!compiledField.pControl->valid()) {
+            qWarning() << "HidInputReportParser: Unknown control" << field.control;
+            return false;
+        }
+    }
+
+    m_layouts[field.reportId].fields.push_back(std::move(compiledField));
+    return true;
+}
+
+void HidInputReportParser::clear() {
+    VERIFY_OR_DEBUG_ASSERT(!m_parsing) {
+        return;
+    }
+    m_layouts.clear();
+}
+
+HidInputReportParser::Layout* HidInputReportParser::findLayout(const QByteArray& report) {
+    if (report.isEmpty() || m_layouts.empty()) {
+        return nullptr;
+    }
+    // Devices that use ReportIDs send the ReportID as first byte
+    const auto reportId = static_cast<quint8>(report.at(0));
+    if (reportId != 0) {
+        const auto it = m_layouts.find(reportId);
+        if (it != m_layouts.end()) {
+            return &it->second;
+        }
+    }
+    const auto it = m_layouts.find(0);
+    if (it != m_layouts.end()) {
+        return &it->second;
+    }
+    return nullptr;
+}
+
+bool HidInputReportParser::parse(const QByteArray& report) {
+    Layout* pLayout = findLayout(report);
+    if (!pLayout) {
+        return false;
+    }
+    if (report == pLayout->previousReport) {
+        return true;
+    }
+
+    m_parsing = true;
+    const auto* pData = reinterpret_cast<const uchar*>(report.constData());
+    for (auto& field : pLayout->fields) {
+        if (field.offset + field.size > report.size()) {
+            continue;
+        }
+        qint64 value = unpack(pData + field.offset, field.pack);
+        if (field.bitmask != 0) {
+            value = (value & field.bitmask) >> field.shift;
+        }
+        if (field.value == value) {
+            continue;
+        }
+        const bool initialized = field.value.has_value();
+        field.value = value;
+        if (!initialized) {
+            continue;
+        }
+
+        if (field.callback) {
+            field.callback(static_cast<double>(value));
+        } else {
+            field.pControl->setParameter(
+                    (static_cast<double>(value) - field.min) / (field.max - field.min));
+        }
+    }
+    m_parsing = false;
+    pLayout->previousReport = report;
+    return true;
+}
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <QByteArray>
+#include <QString>
+#include <functional>
+#include <map>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "control/pollingcontrolproxy.h"
+#include "preferences/configobject.h"
+
+/// Decodes HID InputReports according to field layouts declared by the
+/// mapping, as an alternative to decoding them in JavaScript with
+/// common-hid-packet-parser.js.
+///
+/// Each field is unpacked and compared to its value from the previous
+/// report of the same ReportID. Only fields that changed are dispatched,
+/// either by setting the parameter of the target control directly or by
+/// invoking the callback of the field. The first report of each ReportID
+/// only initializes the field values, like the JavaScript parser does.
+class HidInputReportParser {
+  public:
+    HidInputReportParser()
+            : m_parsing(false) {
+    }
+
+    /// Packing formats of common-hid-packet-parser.js, little endian
+    enum class Pack {
+        Int8,   // "b"
+        UInt8,  // "B"
+        Int16,  // "h"
+        UInt16, // "H"
+        Int32,  // "i"
+        UInt32, // "I"
+    };
+
+    static std::optional<Pack> packFromString(const QString& pack);
+
+    using Callback = std::function<void(double value)>;
+
+    struct Field {
+        /// 1...255 for devices that use ReportIDs, 0 for devices that don't.
+        /// Fields with ReportID 0 receive all reports that don't match
+        /// any other ReportID.
+        quint8 reportId = 0;
+        /// Byte offset into the report data, including the ReportID byte
+        /// if the device uses ReportIDs
+        int offset = 0;
+        Pack pack = Pack::UInt8;
+        /// Selects the bits of the unpacked value, 0 selects all bits. The
+        /// masked value is shifted down to the lowest bit of the mask.
+        quint32 bitmask = 0;
+        /// Value range that is mapped onto the parameter range 0...1 of
+        /// the control. Defaults to the value range of the pack format and
+        /// the bitmask.
+        std::optional<double> min;
+        std::optional<double> max;
+        /// The control that receives the value as parameter
+        ConfigKey control;
+        /// Invoked instead of setting the control, if set
+        Callback callback;
+    };
+
+    /// Returns false if the field is invalid
+    bool addField(const Field& field);
+    void clear();
+
+    bool isEmpty() const {
+        return m_layouts.empty();
+    }
+
+    /// Dispatches the changed fields of the report. Returns false if no
+    /// fields are declared for the ReportID of the report.
+    bool parse(const QByteArray& report);
+
+  private:
+    struct CompiledField {
+        int offset;
+        int size;
+        Pack pack;
+        quint32 bitmask;
+        int shift;
+        double min;
+        double max;
+        std::unique_ptr<PollingControlProxy> pControl;
+        Callback callback;
+        std::optional<qint64> value;
+    };
+
+    struct Layout {
+        std::vector<CompiledField> fields;
+        QByteArray previousReport;
+    };
+
+    Layout* findLayout(const QByteArray& report);
+
+    std::map<quint8, Layout> m_layouts;
+    bool m_parsing;
+};
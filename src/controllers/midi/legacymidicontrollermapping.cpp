@@ -13,17 +13,20 @@ bool LegacyMidiControllerMapping::isMappable() const {
 
 void LegacyMidiControllerMapping::addInputMapping(uint16_t key, const MidiInputMapping& mapping) {
     m_inputMappings.insert(key, mapping);
+    ++m_inputMappingsRevision;
     setDirty(true);
 }
 
 void LegacyMidiControllerMapping::removeInputMapping(uint16_t key) {
     m_inputMappings.remove(key);
+    ++m_inputMappingsRevision;
     setDirty(true);
 }
 
 bool LegacyMidiControllerMapping::removeInputMapping(
         uint16_t key, const MidiInputMapping& mapping) {
     auto result = m_inputMappings.remove(key, mapping);
+    ++m_inputMappingsRevision;
     setDirty(true);
     return result > 0;
 }
@@ -38,6 +41,7 @@ void LegacyMidiControllerMapping::setInputMappings(
     if (m_inputMappings != mappings) {
         m_inputMappings.clear();
         m_inputMappings.unite(mappings);
+        ++m_inputMappingsRevision;
         setDirty(true);
     }
 }
@@ -81,4 +85,5 @@ void LegacyMidiControllerMapping::removeInputHandlerMappings() {
         }
     }
 #endif
+    ++m_inputMappingsRevision;
 }
@@ -9,7 +9,9 @@
 /// it up.
 class LegacyMidiControllerMapping : public LegacyControllerMapping {
   public:
-    LegacyMidiControllerMapping(){};
+    LegacyMidiControllerMapping()
+            : m_inputMappingsRevision(0) {
+    }
     virtual ~LegacyMidiControllerMapping(){};
 
     std::shared_ptr<LegacyControllerMapping> clone() const override {
@@ -27,6 +29,11 @@ class LegacyMidiControllerMapping : public LegacyControllerMapping {
     void removeInputHandlerMappings();
     const QMultiHash<uint16_t, MidiInputMapping>& getInputMappings() const;
     void setInputMappings(const QMultiHash<uint16_t, MidiInputMapping>& mappings);
+    /// Changes whenever the input mappings are modified. Allows to cache
+    /// data derived from the input mappings.
+    int inputMappingsRevision() const {
+        return m_inputMappingsRevision;
+    }
 
     // Output mappings
     void addOutputMapping(const ConfigKey& key, const MidiOutputMapping& mapping);
@@ -37,5 +44,6 @@ class LegacyMidiControllerMapping : public LegacyControllerMapping {
   private:
     // MIDI input and output mappings.
     QMultiHash<uint16_t, MidiInputMapping> m_inputMappings;
+    int m_inputMappingsRevision;
     QMultiHash<ConfigKey, MidiOutputMapping> m_outputMappings;
 };
@@ -3,6 +3,7 @@
 #include <QJSValue>
 #include <algorithm>
 
+#include "control/control.h"
 #include "control/controlobject.h"
 #include "control/controlpotmeter.h"
 #include "controllers/defs_controllers.h"
@@ -15,6 +16,19 @@
 #include "moc_midicontroller.cpp"
 #include "util/make_const_iterator.h"
 #include "util/math.h"
+#include "util/time.h"
+
+namespace {
+
+// Minimum interval between two output frames. Bounds the rate at which a
+// burst of output changes is sent to the device.
+constexpr mixxx::Duration kOutputFrameInterval = mixxx::Duration::fromMillis(2);
+
+// Remaining messages are sent with the next frames, so a slow device is not
+// flooded, e.g. when all LEDs are initialized at once
+constexpr int kMaxMessagesPerOutputFrame = 64;
+
+} // namespace
 
 const QString kMakeInputHandlerError = QStringLiteral(
         "Invalid timer callback provided to midi.makeInputHandler. "
@@ -32,7 +46,14 @@ bool MidiInputHandleJSProxy::disconnect() {
 }
 
 MidiController::MidiController(const QString& deviceName)
-        : Controller(deviceName) {
+        : Controller(deviceName),
+          m_outputFrameTimer(this),
+          m_compiledInputMappingsRevision(-1) {
+    m_outputFrameTimer.setSingleShot(true);
+    connect(&m_outputFrameTimer,
+            &QTimer::timeout,
+            this,
+            &MidiController::slotSendOutputFrame);
 }
 
 void MidiController::slotBeforeEngineShutdown() {
@@ -56,6 +77,66 @@ QString MidiController::mappingExtension() {
 
 void MidiController::setMapping(std::shared_ptr<LegacyControllerMapping> pMapping) {
     m_pMapping = downcastAndTakeOwnership<LegacyMidiControllerMapping>(std::move(pMapping));
+    compileInputMappings();
+}
+
+void MidiController::compileInputMappings() {
+    m_compiledInputMappings.clear();
+    for (auto& pRanges : m_compiledInputMappingTable) {
+        pRanges.reset();
+    }
+    if (!m_pMapping) {
+        m_compiledInputMappingsRevision = -1;
+        return;
+    }
+
+    const auto& inputMappings = m_pMapping->getInputMappings();
+    m_compiledInputMappings.reserve(inputMappings.size());
+    const auto keys = inputMappings.uniqueKeys();
+    for (const uint16_t key : keys) {
+        MidiKey midiKey;
+        midiKey.key = key;
+        auto& pRanges = m_compiledInputMappingTable[midiKey.status];
+        if (!pRanges) {
+            pRanges = std::make_unique<CompiledInputMappingRanges>();
+        }
+        CompiledInputMappingRange& range = (*pRanges)[midiKey.control];
+        range.begin = static_cast<quint32>(m_compiledInputMappings.size());
+        // Dispatch in the order of QMultiHash::constFind()
+        for (auto it = inputMappings.constFind(key);
+                it != inputMappings.constEnd() && it.key() == key;
+                ++it) {
+            CompiledInputMapping compiledMapping{it.value(), {}};
+            const auto* pConfigKey = std::get_if<ConfigKey>(&it.value().control);
+            if (pConfigKey && !it.value().options.testFlag(MidiOption::Script)) {
+                compiledMapping.pControl = ControlDoublePrivate::getControl(
+                        *pConfigKey, ControlFlag::NoWarnIfMissing);
+            }
+            m_compiledInputMappings.push_back(std::move(compiledMapping));
+        }
+        range.end = static_cast<quint32>(m_compiledInputMappings.size());
+    }
+    m_compiledInputMappingsRevision = m_pMapping->inputMappingsRevision();
+}
+
+ControlObject* MidiController::resolveControl(CompiledInputMapping* pCompiledMapping) {
+    if (const auto pControl = pCompiledMapping->pControl.lock()) {
+        ControlObject* pCO = pControl->getCreatorCO();
+        if (pCO) {
+            return pCO;
+        }
+    }
+    // The control has been created or recreated after compiling
+    const auto* pConfigKey = std::get_if<ConfigKey>(&pCompiledMapping->mapping.control);
+    VERIFY_OR_DEBUG_ASSERT(pConfigKey) {
+        return nullptr;
+    }
+    const auto pControl = ControlDoublePrivate::getControl(*pConfigKey);
+    pCompiledMapping->pControl = pControl;
+    if (!pControl) {
+        return nullptr;
+    }
+    return pControl->getCreatorCO();
 }
 
 std::shared_ptr<LegacyControllerMapping> MidiController::cloneMapping() {
@@ -66,10 +147,63 @@ std::shared_ptr<LegacyControllerMapping> MidiController::cloneMapping() {
 }
 
 int MidiController::close() {
+    // Sub-classes close the port afterwards, so the last LED states must be
+    // sent now
+    flushOutputFrame();
     destroyOutputHandlers();
     return 0;
 }
 
+void MidiController::send(const QList<int>& data, unsigned int length) {
+    Controller::send(data, length);
+    // The raw bytes might have changed the state of any LED
+    m_outputFrame.forgetSentValues();
+}
+
+void MidiController::queueOutputMessage(
+        unsigned char status, unsigned char control, unsigned char value) {
+    if (!m_outputFrame.queueMessage(status, control, value) ||
+            m_outputFrameTimer.isActive()) {
+        return;
+    }
+    // Coalesce all changes of the current event loop iteration, but don't
+    // delay the first frame after an idle period
+    const mixxx::Duration sinceLastFrame = mixxx::Time::elapsed() - m_lastOutputFrameTime;
+    m_outputFrameTimer.start(sinceLastFrame < kOutputFrameInterval
+                    ? static_cast<int>((kOutputFrameInterval - sinceLastFrame)
+                                      .toIntegerMillis())
+                    : 0);
+}
+
+void MidiController::slotSendOutputFrame() {
+    m_lastOutputFrameTime = mixxx::Time::elapsed();
+    if (!isOpen()) {
+        m_outputFrame.clear();
+        return;
+    }
+    m_outputFrame.flush(kMaxMessagesPerOutputFrame,
+            [this](unsigned char status, unsigned char control, unsigned char value) {
+                sendShortMsg(status, control, value);
+            });
+    if (m_outputFrame.hasPendingMessages()) {
+        m_outputFrameTimer.start(static_cast<int>(kOutputFrameInterval.toIntegerMillis()));
+    }
+}
+
+void MidiController::flushOutputFrame() {
+    m_outputFrameTimer.stop();
+    if (!isOpen()) {
+        m_outputFrame.clear();
+        return;
+    }
+    while (m_outputFrame.hasPendingMessages()) {
+        m_outputFrame.flush(kMaxMessagesPerOutputFrame,
+                [this](unsigned char status, unsigned char control, unsigned char value) {
+                    sendShortMsg(status, control, value);
+                });
+    }
+}
+
 bool MidiController::matchMapping(const MappingInfo& mapping) {
     // Product info mapping not implemented for MIDI devices yet
     Q_UNUSED(mapping);
@@ -189,6 +323,9 @@ void MidiController::destroyOutputHandlers() {
     while (m_outputs.size() > 0) {
         delete m_outputs.takeLast();
     }
+    // New output handlers must send their initial values in any case
+    m_outputFrameTimer.stop();
+    m_outputFrame.clear();
 }
 
 void MidiController::learnTemporaryInputMappings(const MidiInputMappings& mappings) {
@@ -286,9 +423,26 @@ void MidiController::receivedShortMessage(unsigned char status,
         }
     }
 
-    auto it = m_pMapping->getInputMappings().constFind(mappingKey.key);
-    for (; it != m_pMapping->getInputMappings().constEnd() && it.key() == mappingKey.key; ++it) {
-        processInputMapping(it.value(), status, control, value, timestamp);
+    if (m_pMapping &&
+            m_compiledInputMappingsRevision != m_pMapping->inputMappingsRevision()) {
+        // Modified by the mapping script or the learning wizard
+        compileInputMappings();
+    }
+    const auto& pRanges = m_compiledInputMappingTable[mappingKey.status];
+    if (!pRanges) {
+        return;
+    }
+    const CompiledInputMappingRange range = (*pRanges)[mappingKey.control];
+    for (quint32 i = range.begin; i < range.end; ++i) {
+        CompiledInputMapping& compiledMapping = m_compiledInputMappings[i];
+        if (compiledMapping.mapping.options.testFlag(MidiOption::Script)) {
+            processInputMapping(compiledMapping.mapping, status, control, value, timestamp);
+            continue;
+        }
+        ControlObject* pCO = resolveControl(&compiledMapping);
+        if (pCO) {
+            processControlInputMapping(compiledMapping.mapping, pCO, status, control, value);
+        }
     }
 }
 
@@ -297,9 +451,7 @@ void MidiController::processInputMapping(const MidiInputMapping& mapping,
         unsigned char control,
         unsigned char value,
         mixxx::Duration timestamp) {
-    Q_UNUSED(timestamp)
     unsigned char channel = MidiUtils::channelFromStatus(status);
-    MidiOpCode opCode = MidiUtils::opCodeFromStatus(status);
 
     if (mapping.options.testFlag(MidiOption::Script)) {
         auto pEngine = getScriptEngine();
@@ -307,7 +459,9 @@ void MidiController::processInputMapping(const MidiInputMapping& mapping,
             return;
         }
 
-        return std::visit(
+        // Exposes the arrival time to engine.scratchTick()
+        pEngine->setInputTimestamp(timestamp);
+        std::visit(
                 MidiUtils::overloaded{
                         [pEngine, this, channel, status, control, value](
                                 const ConfigKey& target) {
@@ -344,6 +498,8 @@ void MidiController::processInputMapping(const MidiInputMapping& mapping,
                             }
                         }},
                 mapping.control);
+        pEngine->setInputTimestamp(mixxx::Duration::empty());
+        return;
     }
 
     VERIFY_OR_DEBUG_ASSERT(std::holds_alternative<ConfigKey>(mapping.control)) {
@@ -351,12 +507,20 @@ void MidiController::processInputMapping(const MidiInputMapping& mapping,
     }
 
     // Only pass values on to valid ControlObjects.
-    auto configKey = std::get<ConfigKey>(mapping.control);
-    ControlObject* pCO = ControlObject::getControl(configKey);
+    ControlObject* pCO = ControlObject::getControl(std::get<ConfigKey>(mapping.control));
     if (pCO == nullptr) {
         return;
     }
+    processControlInputMapping(mapping, pCO, status, control, value);
+}
 
+void MidiController::processControlInputMapping(const MidiInputMapping& mapping,
+        ControlObject* pCO,
+        unsigned char status,
+        unsigned char control,
+        unsigned char value) {
+    MidiOpCode opCode = MidiUtils::opCodeFromStatus(status);
+    const auto& configKey = std::get<ConfigKey>(mapping.control);
     double newValue = value;
 
     const bool mapping_is_14bit = mapping.options &
@@ -604,7 +768,9 @@ void MidiController::processInputMapping(const MidiInputMapping& mapping,
         if (pEngine == nullptr) {
             return;
         }
+        pEngine->setInputTimestamp(timestamp);
         pEngine->handleIncomingData(data);
+        pEngine->setInputTimestamp(mixxx::Duration::empty());
         return;
     }
     qCWarning(m_logBase) << "MidiController: No script function specified for"
@@ -1,12 +1,21 @@
 #pragma once
 
 #include <QJSValue>
+#include <QTimer>
+#include <QWeakPointer>
+#include <array>
+#include <memory>
+#include <vector>
 
 #include "controllers/controller.h"
 #include "controllers/midi/legacymidicontrollermapping.h"
 #include "controllers/midi/midimessage.h"
+#include "controllers/midi/midioutputframe.h"
 #include "controllers/softtakeover.h"
+#include "util/duration.h"
 
+class ControlDoublePrivate;
+class ControlObject;
 class MidiOutputHandler;
 
 class MidiInputHandleJSProxy final : public QObject {
@@ -72,6 +81,8 @@ class MidiController : public Controller {
 
     QJSValue makeInputHandler(int status, int midino, const QJSValue& scriptCode);
 
+    void send(const QList<int>& data, unsigned int length = 0) override;
+
   protected slots:
     virtual void receivedShortMessage(
             unsigned char status,
@@ -90,30 +101,68 @@ class MidiController : public Controller {
     void clearTemporaryInputMappings();
     void commitTemporaryInputMappings();
 
+    void slotSendOutputFrame();
+
   private:
+    /// An input mapping of m_pMapping with its control resolved in advance
+    struct CompiledInputMapping {
+        MidiInputMapping mapping;
+        /// Null for script mappings and for controls that did not exist
+        /// while compiling. Weak, so the control can be recreated.
+        QWeakPointer<ControlDoublePrivate> pControl;
+    };
+    /// The range of m_compiledInputMappings for a single MIDI key
+    struct CompiledInputMappingRange {
+        quint32 begin = 0;
+        quint32 end = 0;
+    };
+    using CompiledInputMappingRanges = std::array<CompiledInputMappingRange, 256>;
+
+    /// Builds the dispatch table from the input mappings of m_pMapping
+    void compileInputMappings();
+    ControlObject* resolveControl(CompiledInputMapping* pCompiledMapping);
+
     void processInputMapping(
             const MidiInputMapping& mapping,
             unsigned char status,
             unsigned char control,
             unsigned char value,
             mixxx::Duration timestamp);
+    void processControlInputMapping(
+            const MidiInputMapping& mapping,
+            ControlObject* pCO,
+            unsigned char status,
+            unsigned char control,
+            unsigned char value);
     void processInputMapping(
             const MidiInputMapping& mapping,
             const QByteArray& data,
             mixxx::Duration timestamp);
 
     double computeValue(MidiOptions options, double _prevmidivalue, double _newmidivalue);
+    /// Sends the message of a static output mapping with the next output frame
+    void queueOutputMessage(unsigned char status, unsigned char control, unsigned char value);
+    /// Sends all pending messages of the output frame immediately
+    void flushOutputFrame();
     void createOutputHandlers();
     void updateAllOutputs();
     void destroyOutputHandlers();
 
     QHash<uint16_t, MidiInputMapping> m_temporaryInputMappings;
     QList<MidiOutputHandler*> m_outputs;
+    MidiOutputFrame m_outputFrame;
+    QTimer m_outputFrameTimer;
+    mixxx::Duration m_lastOutputFrameTime;
     std::shared_ptr<LegacyMidiControllerMapping> m_pMapping;
+    std::vector<CompiledInputMapping> m_compiledInputMappings;
+    /// Indexed by the status byte and then by the control byte. The ranges
+    /// are only allocated for status bytes that are mapped.
+    std::array<std::unique_ptr<CompiledInputMappingRanges>, 256> m_compiledInputMappingTable;
+    int m_compiledInputMappingsRevision;
     SoftTakeoverCtrl m_st;
     QList<QPair<MidiInputMapping, unsigned char>> m_fourteen_bit_queued_mappings;
 
-    // So it can access sendShortMsg()
+    // So it can access queueOutputMessage()
     friend class MidiOutputHandler;
     friend class MidiControllerTest;
     friend class MidiControllerJSProxy;
@@ -133,7 +182,9 @@ class MidiControllerJSProxy : public ControllerJSProxy {
     Q_INVOKABLE void sendShortMsg(unsigned char status,
             unsigned char byte1,
             unsigned char byte2) {
+        // Not deferred, the script may rely on the order of its messages
         m_pMidiController->sendShortMsg(status, byte1, byte2);
+        m_pMidiController->m_outputFrame.messageSent(status, byte1, byte2);
     }
 
     Q_INVOKABLE void sendSysexMsg(const QList<int>& data, unsigned int length = 0) {
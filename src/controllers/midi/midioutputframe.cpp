@@ -0,0 +1,64 @@
+#include "controllers/midi/midioutputframe.h"
+
+bool MidiOutputFrame::queueMessage(
+        unsigned char status, unsigned char control, unsigned char value) {
+    Entry& entry = m_entries[key(status, control)];
+    if (entry.pendingValue < 0 && entry.sentValue == value) {
+        return false;
+    }
+    if (entry.sentValue == value) {
+        // Reverted within the frame, the device already shows this value
+        entry.pendingValue = -1;
+        return false;
+    }
+    entry.pendingValue = value;
+    if (!entry.queued) {
+        entry.queued = true;
+        m_pendingKeys.push_back(key(status, control));
+    }
+    return true;
+}
+
+void MidiOutputFrame::messageSent(
+        unsigned char status, unsigned char control, unsigned char value) {
+    const auto it = m_entries.find(key(status, control));
+    if (it == m_entries.end()) {
+        // Only track pairs of the output mappings
+        return;
+    }
+    it->pendingValue = -1;
+    it->sentValue = value;
+}
+
+void MidiOutputFrame::forgetSentValues() {
+    for (auto& entry : m_entries) {
+        entry.sentValue = -1;
+    }
+}
+
+int MidiOutputFrame::flush(int maxMessages, const SendFunction& send) {
+    int sentMessages = 0;
+    while (sentMessages < maxMessages && !m_pendingKeys.empty()) {
+        const quint16 pendingKey = m_pendingKeys.front();
+        m_pendingKeys.pop_front();
+        Entry& entry = m_entries[pendingKey];
+        entry.queued = false;
+        if (entry.pendingValue < 0) {
+            // Discarded after it has been queued
+            continue;
+        }
+        const auto value = static_cast<unsigned char>(entry.pendingValue);
+        entry.sentValue = entry.pendingValue;
+        entry.pendingValue = -1;
+        send(static_cast<unsigned char>(pendingKey >> 8),
+                static_cast<unsigned char>(pendingKey & 0xFF),
+                value);
+        ++sentMessages;
+    }
+    return sentMessages;
+}
+
+void MidiOutputFrame::clear() {
+    m_entries.clear();
+    m_pendingKeys.clear();
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <QHash>
+#include <deque>
+#include <functional>
+
+/// Collects the short messages of the static output mappings of a MIDI
+/// controller between two output frames.
+///
+/// Only the latest value of each status/control pair is kept and values
+/// that equal the value last sent to the device are dropped. This turns a
+/// burst of control changes, e.g. while a track is loaded, into a single
+/// message per LED. Pending messages are sent in the order in which they
+/// became pending.
+class MidiOutputFrame {
+  public:
+    using SendFunction = std::function<void(
+            unsigned char status, unsigned char control, unsigned char value)>;
+
+    /// Returns false if the message is redundant and has not been queued
+    bool queueMessage(unsigned char status, unsigned char control, unsigned char value);
+
+    /// Records a message that has been sent directly, e.g. by the mapping
+    /// script. A pending message with the same status and control would
+    /// overwrite the newer value and is discarded.
+    void messageSent(unsigned char status, unsigned char control, unsigned char value);
+
+    /// Forgets the sent values but keeps the pending messages. Must be
+    /// called after raw bytes have been sent, e.g. a SysEx message that
+    /// changes the LED states, because the values last sent are unknown
+    /// afterwards.
+    void forgetSentValues();
+
+    /// Sends up to maxMessages pending messages. Returns the number of
+    /// messages that have been sent.
+    int flush(int maxMessages, const SendFunction& send);
+
+    bool hasPendingMessages() const {
+        return !m_pendingKeys.empty();
+    }
+
+    /// Discards the pending messages and forgets the sent values, so the
+    /// next message of each status/control pair is sent in any case
+    void clear();
+
+  private:
+    struct Entry {
+        // -1 if no value is pending or has been sent
+        int pendingValue = -1;
+        int sentValue = -1;
+        bool queued = false;
+    };
+
+    static quint16 key(unsigned char status, unsigned char control) {
+        return static_cast<quint16>((status << 8) | control);
+    }
+
+    QHash<quint16, Entry> m_entries;
+    std::deque<quint16> m_pendingKeys;
+};
@@ -47,11 +47,14 @@ void MidiOutputHandler::controlChanged(double value) {
     if (!m_pController->isOpen()) {
         qCWarning(m_logger) << "MIDI device" << m_pController->getName() << "not open for output!";
     } else if (byte3 != 0xFF) {
-        qCDebug(m_logger) << "sending MIDI bytes:" << m_mapping.output.status
+        qCDebug(m_logger) << "queueing MIDI bytes:" << m_mapping.output.status
                           << "," << m_mapping.output.control << ","
                           << byte3;
-        m_pController->sendShortMsg(m_mapping.output.status,
-                                    m_mapping.output.control, byte3);
+        // Redundant messages of other handlers with the same status and
+        // control are dropped by the output frame of the controller
+        m_pController->queueOutputMessage(m_mapping.output.status,
+                m_mapping.output.control,
+                byte3);
         m_lastVal = static_cast<int>(byte3);
     }
 }
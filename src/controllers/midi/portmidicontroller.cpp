@@ -1,7 +1,10 @@
 #include "controllers/midi/portmidicontroller.h"
 
+#include <porttime.h>
+
 #include "controllers/midi/midiutils.h"
 #include "moc_portmidicontroller.cpp"
+#include "util/time.h"
 
 namespace {
 const QString kUnknownControllerName = QStringLiteral("Unknown PortMidiController");
@@ -81,6 +84,19 @@ int PortMidiController::open() {
 
     setOpen(true);
     startEngine();
+
+    if (m_pInputDevice && m_pInputDevice->isOpen()) {
+        // Start reading after the mapping has been initialized
+        m_pInput = std::make_unique<PortMidiInput>(
+                m_pInputDevice.data(), m_logInput);
+        connect(m_pInput.get(),
+                &PortMidiInput::eventsAvailable,
+                this,
+                &PortMidiController::slotProcessInputEvents,
+                Qt::QueuedConnection);
+        m_pInputThread = PortMidiInputThread::instance();
+        m_pInputThread->addInput(m_pInput.get());
+    }
     return 0;
 }
 
@@ -90,6 +106,13 @@ int PortMidiController::close() {
         return -1;
     }
 
+    if (m_pInput) {
+        // The input device must not be read anymore when it is closed
+        m_pInputThread->removeInput(m_pInput.get());
+        m_pInputThread.reset();
+        m_pInput.reset();
+    }
+
     stopEngine();
     MidiController::close();
 
@@ -130,65 +153,86 @@ bool PortMidiController::poll() {
         return false;
     }
 
+    const PmTimestamp portTimeNow = Pt_Time();
+    const mixxx::Duration elapsedNow = mixxx::Time::elapsed();
     for (int i = 0; i < numEvents; i++) {
-        unsigned char status = Pm_MessageStatus(m_midiBuffer[i].message);
-        mixxx::Duration timestamp = mixxx::Duration::fromMillis(m_midiBuffer[i].timestamp);
+        processEvent(m_midiBuffer[i].message,
+                PortMidiInputThread::toElapsedTime(
+                        m_midiBuffer[i].timestamp, portTimeNow, elapsedNow));
+    }
+    return numEvents > 0;
+}
 
-        if ((status & 0xF8) == 0xF8) {
-            // Handle real-time MIDI messages at any time
-            receivedShortMessage(status, 0, 0, timestamp);
-            continue;
-        }
+void PortMidiController::slotProcessInputEvents() {
+    if (!m_pInput) {
+        // Closed while the signal was queued
+        return;
+    }
+    // Acknowledge first, events that arrive while processing
+    // trigger another signal
+    m_pInput->acknowledgeEvents();
+    PortMidiInputEvent event;
+    while (m_pInput->popEvent(&event)) {
+        processEvent(event.message, event.timestamp);
+    }
+}
 
-        reprocessMessage:
-
-        if (!m_bInSysex) {
-            if (status == 0xF0) {
-                m_bInSysex = true;
-                status = 0;
-            } else {
-                //unsigned char channel = status & 0x0F;
-                unsigned char note = Pm_MessageData1(m_midiBuffer[i].message);
-                unsigned char velocity = Pm_MessageData2(m_midiBuffer[i].message);
-                receivedShortMessage(status, note, velocity, timestamp);
-            }
+void PortMidiController::processEvent(PmMessage message, mixxx::Duration timestamp) {
+    unsigned char status = Pm_MessageStatus(message);
+
+    if ((status & 0xF8) == 0xF8) {
+        // Handle real-time MIDI messages at any time
+        receivedShortMessage(status, 0, 0, timestamp);
+        return;
+    }
+
+reprocessMessage:
+
+    if (!m_bInSysex) {
+        if (status == 0xF0) {
+            m_bInSysex = true;
+            status = 0;
+        } else {
+            //unsigned char channel = status & 0x0F;
+            unsigned char note = Pm_MessageData1(message);
+            unsigned char velocity = Pm_MessageData2(message);
+            receivedShortMessage(status, note, velocity, timestamp);
         }
+    }
 
-        if (m_bInSysex) {
-            // Abort (drop) the current System Exclusive message if a
-            //  non-realtime status byte was received
-            if (status > 0x7F && status < 0xF7) {
-                m_bInSysex = false;
-                m_cReceiveMsg_index = 0;
-                qCWarning(m_logInput) << "Buggy MIDI device: SysEx interrupted!";
-                goto reprocessMessage;    // Don't lose the new message
-            }
+    if (m_bInSysex) {
+        // Abort (drop) the current System Exclusive message if a
+        //  non-realtime status byte was received
+        if (status > 0x7F && status < 0xF7) {
+            m_bInSysex = false;
+            m_cReceiveMsg_index = 0;
+            qCWarning(m_logInput) << "Buggy MIDI device: SysEx interrupted!";
+            goto reprocessMessage; // Don't lose the new message
+        }
 
-            // Collect bytes from PmMessage
-            uint8_t data = 0;
-            for (int shift = 0; shift < 32 &&
-                    (data != MidiUtils::opCodeValue(MidiOpCode::EndOfExclusive));
-                    shift += 8) {
-                // TODO(rryan): This prevents buffer overflow if the sysex is
-                // larger than 1024 bytes. I don't want to radically change
-                // anything before the 2.0 release so this will do for now.
-                data = (m_midiBuffer[i].message >> shift) & 0xFF;
-                if (m_cReceiveMsg_index < MIXXX_SYSEX_BUFFER_LEN) {
-                    m_cReceiveMsg[m_cReceiveMsg_index++] = data;
-                }
+        // Collect bytes from PmMessage
+        uint8_t data = 0;
+        for (int shift = 0; shift < 32 &&
+                (data != MidiUtils::opCodeValue(MidiOpCode::EndOfExclusive));
+                shift += 8) {
+            // TODO(rryan): This prevents buffer overflow if the sysex is
+            // larger than 1024 bytes. I don't want to radically change
+            // anything before the 2.0 release so this will do for now.
+            data = (message >> shift) & 0xFF;
+            if (m_cReceiveMsg_index < MIXXX_SYSEX_BUFFER_LEN) {
+                m_cReceiveMsg[m_cReceiveMsg_index++] = data;
             }
+        }
 
-            // End System Exclusive message if the EOX byte was received
-            if (data == MidiUtils::opCodeValue(MidiOpCode::EndOfExclusive)) {
-                m_bInSysex = false;
-                const char* buffer = reinterpret_cast<const char*>(m_cReceiveMsg);
-                receive(QByteArray::fromRawData(buffer, m_cReceiveMsg_index),
-                        timestamp);
-                m_cReceiveMsg_index = 0;
-            }
+        // End System Exclusive message if the EOX byte was received
+        if (data == MidiUtils::opCodeValue(MidiOpCode::EndOfExclusive)) {
+            m_bInSysex = false;
+            const char* buffer = reinterpret_cast<const char*>(m_cReceiveMsg);
+            receive(QByteArray::fromRawData(buffer, m_cReceiveMsg_index),
+                    timestamp);
+            m_cReceiveMsg_index = 0;
         }
     }
-    return numEvents > 0;
 }
 
 void PortMidiController::sendShortMsg(unsigned char status, unsigned char byte1,
@@ -3,9 +3,11 @@
 #include <portmidi.h>
 
 #include <QScopedPointer>
+#include <memory>
 
 #include "controllers/midi/midicontroller.h"
 #include "controllers/midi/portmididevice.h"
+#include "controllers/midi/portmidiinputthread.h"
 
 // Note:
 // A standard Midi device runs at 31.25 kbps, with 10 bits / byte
@@ -90,6 +92,9 @@ class PortMidiController : public MidiController {
     int close() override;
     bool poll() override;
 
+    /// Processes the events received by the input thread
+    void slotProcessInputEvents();
+
   protected:
     // MockPortMidiController needs this to not be private.
     void sendShortMsg(unsigned char status, unsigned char byte1,
@@ -100,10 +105,14 @@ class PortMidiController : public MidiController {
     // 0xf7.
     bool sendBytes(const QByteArray& data) override;
 
+    /// Input is read by the shared PortMidiInputThread while the device
+    /// is open
     bool isPolling() const override {
-        return true;
+        return !m_pInput;
     }
 
+    void processEvent(PmMessage message, mixxx::Duration timestamp);
+
     // For testing only so that test fixtures can install mock PortMidiDevices.
     void setPortMidiInputDevice(PortMidiDevice* device) {
         m_pInputDevice.reset(device);
@@ -114,6 +123,8 @@ class PortMidiController : public MidiController {
 
     QScopedPointer<PortMidiDevice> m_pInputDevice;
     QScopedPointer<PortMidiDevice> m_pOutputDevice;
+    std::unique_ptr<PortMidiInput> m_pInput;
+    std::shared_ptr<PortMidiInputThread> m_pInputThread;
 
     PmEvent m_midiBuffer[MIXXX_PORTMIDI_BUFFER_LEN];
 
@@ -0,0 +1,191 @@
+#include "controllers/midi/portmidiinputthread.h"
+
+#include <porttime.h>
+
+#include <algorithm>
+
+#include "controllers/midi/portmididevice.h"
+#include "moc_portmidiinputthread.cpp"
+#include "util/assert.h"
+#include "util/compatibility/qmutex.h"
+#include "util/time.h"
+#include "util/trace.h"
+
+namespace {
+
+// Capacity of the queue to the controller thread. Holds several full reads,
+// so the controller thread may fall behind for a moment without dropping
+// events, e.g. while a mapping script is busy.
+constexpr std::size_t kEventQueueCapacity = 4096;
+
+// Poll interval while any device is busy, e.g. while a jog wheel is turned.
+// Bounds the input latency.
+constexpr unsigned long kPollIntervalWhenActiveMillis = 1;
+
+// Poll interval while all devices are idle. Bounds the latency of the first
+// event after an idle period only. This results in 200 wakeups per second
+// at most, independent of the number of devices.
+constexpr unsigned long kPollIntervalWhenIdleMillis = 5;
+
+// The short poll interval is used for this long after the last event
+constexpr mixxx::Duration kActivePeriod = mixxx::Duration::fromMillis(500);
+
+// Timestamps that are older are not on the PortTime clock
+constexpr PmTimestamp kMaxTimestampAgeMillis = 1000;
+
+} // namespace
+
+PortMidiInput::PortMidiInput(PortMidiDevice* pInputDevice,
+        const RuntimeLoggingCategory& logInput)
+        : m_pInputDevice(pInputDevice),
+          m_logInput(logInput),
+          m_events(kEventQueueCapacity),
+          m_eventsAvailableSignalPending(false),
+          m_readErrorLogged(false),
+          m_queueOverflowLogged(false) {
+    for (int i = 0; i < kReadBufferLength; ++i) {
+        m_readBuffer[i] = {0, 0};
+    }
+}
+
+int PortMidiInput::readEvents() {
+    const int numEvents = m_pInputDevice->read(m_readBuffer, kReadBufferLength);
+    if (numEvents <= 0) {
+        if (numEvents < 0 && !m_readErrorLogged) {
+            qCWarning(m_logInput) << "PortMidi error:"
+                                  << Pm_GetErrorText(static_cast<PmError>(numEvents))
+                                  << "Note that, this message is only logged once "
+                                     "until reading succeeds again.";
+            // Avoid flooding the log at the rate of the run loop
+            m_readErrorLogged = true;
+        }
+        return numEvents;
+    }
+    m_readErrorLogged = false;
+
+    Trace read("PortMidiInput readEvents");
+    // Both clocks are sampled once per read, the PortMidi timestamps
+    // preserve the spacing of the events within a read
+    const PmTimestamp portTimeNow = Pt_Time();
+    const mixxx::Duration elapsedNow = mixxx::Time::elapsed();
+    for (int i = 0; i < numEvents; ++i) {
+        const PortMidiInputEvent event{m_readBuffer[i].message,
+                PortMidiInputThread::toElapsedTime(
+                        m_readBuffer[i].timestamp, portTimeNow, elapsedNow)};
+        if (!m_events.try_push(event)) {
+            if (!m_queueOverflowLogged) {
+                qCWarning(m_logInput)
+                        << "Dropped" << numEvents - i
+                        << "MIDI events, because the controller thread "
+                           "does not keep up";
+                m_queueOverflowLogged = true;
+            }
+            return i;
+        }
+    }
+    m_queueOverflowLogged = false;
+    return numEvents;
+}
+
+void PortMidiInput::notifyEventsAvailable() {
+    if (!m_eventsAvailableSignalPending.exchange(true, std::memory_order_acq_rel)) {
+        emit eventsAvailable();
+    }
+}
+
+bool PortMidiInput::popEvent(PortMidiInputEvent* pEvent) {
+    const PortMidiInputEvent* pFront = m_events.front();
+    if (!pFront) {
+        return false;
+    }
+    *pEvent = *pFront;
+    m_events.pop();
+    return true;
+}
+
+// static
+std::weak_ptr<PortMidiInputThread> PortMidiInputThread::s_pInstance;
+
+// static
+std::shared_ptr<PortMidiInputThread> PortMidiInputThread::instance() {
+    auto pInstance = s_pInstance.lock();
+    if (!pInstance) {
+        pInstance = std::shared_ptr<PortMidiInputThread>(new PortMidiInputThread());
+        pInstance->setObjectName(QStringLiteral("PortMidiInput"));
+        pInstance->start(QThread::HighPriority);
+        s_pInstance = pInstance;
+    }
+    return pInstance;
+}
+
+PortMidiInputThread::PortMidiInputThread()
+        : m_stop(false) {
+}
+
+PortMidiInputThread::~PortMidiInputThread() {
+    {
+        const auto locker = lockMutex(&m_mutex);
+        DEBUG_ASSERT(m_inputs.empty());
+        m_stop = true;
+        m_wakeup.wakeAll();
+    }
+    wait();
+}
+
+void PortMidiInputThread::addInput(PortMidiInput* pInput) {
+    const auto locker = lockMutex(&m_mutex);
+    DEBUG_ASSERT(std::find(m_inputs.cbegin(), m_inputs.cend(), pInput) == m_inputs.cend());
+    m_inputs.push_back(pInput);
+    m_wakeup.wakeAll();
+}
+
+void PortMidiInputThread::removeInput(PortMidiInput* pInput) {
+    const auto locker = lockMutex(&m_mutex);
+    m_inputs.erase(std::remove(m_inputs.begin(), m_inputs.end(), pInput),
+            m_inputs.end());
+}
+
+// static
+mixxx::Duration PortMidiInputThread::toElapsedTime(PmTimestamp timestamp,
+        PmTimestamp portTimeNow,
+        mixxx::Duration elapsedNow) {
+    const PmTimestamp age = portTimeNow - timestamp;
+    if (age < 0 || age > kMaxTimestampAgeMillis) {
+        return elapsedNow;
+    }
+    return elapsedNow - mixxx::Duration::fromMillis(age);
+}
+
+void PortMidiInputThread::run() {
+    const auto locker = lockMutex(&m_mutex);
+    mixxx::Duration lastEventTime;
+    while (!m_stop) {
+        if (m_inputs.empty()) {
+            m_wakeup.wait(&m_mutex);
+            // Start with the short interval, because the mapping usually
+            // initializes the device right after opening it
+            lastEventTime = mixxx::Time::elapsed();
+            continue;
+        }
+        bool moreEventsBuffered = false;
+        for (auto* pInput : m_inputs) {
+            const int numEvents = pInput->readEvents();
+            if (numEvents > 0) {
+                lastEventTime = mixxx::Time::elapsed();
+                pInput->notifyEventsAvailable();
+                if (numEvents == PortMidiInput::kReadBufferLength) {
+                    moreEventsBuffered = true;
+                }
+            }
+        }
+        if (moreEventsBuffered) {
+            continue;
+        }
+        // Waiting releases the mutex, so inputs can be added and removed
+        if (mixxx::Time::elapsed() - lastEventTime < kActivePeriod) {
+            m_wakeup.wait(&m_mutex, kPollIntervalWhenActiveMillis);
+        } else {
+            m_wakeup.wait(&m_mutex, kPollIntervalWhenIdleMillis);
+        }
+    }
+}
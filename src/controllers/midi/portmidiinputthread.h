@@ -0,0 +1,111 @@
+#pragma once
+
+#include <portmidi.h>
+
+#include <QMutex>
+#include <QObject>
+#include <QThread>
+#include <QWaitCondition>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "rigtorp/SPSCQueue.h"
+#include "util/duration.h"
+#include "util/runtimeloggingcategory.h"
+
+class PortMidiDevice;
+
+/// A MIDI event received by PortMidiInputThread
+struct PortMidiInputEvent {
+    PmMessage message;
+    /// Arrival time on the mixxx::Time clock
+    mixxx::Duration timestamp;
+};
+
+/// The input stream of a single PortMidi device while it is read by
+/// PortMidiInputThread. Hands the received events over to the thread of
+/// the controller.
+class PortMidiInput : public QObject {
+    Q_OBJECT
+  public:
+    PortMidiInput(PortMidiDevice* pInputDevice,
+            const RuntimeLoggingCategory& logInput);
+
+    /// Pops the next pending event. Must only be called from the thread
+    /// that receives eventsAvailable().
+    bool popEvent(PortMidiInputEvent* pEvent);
+
+    /// Allows the next eventsAvailable() signal. Must be called before
+    /// popping the pending events.
+    void acknowledgeEvents() {
+        m_eventsAvailableSignalPending.store(false, std::memory_order_release);
+    }
+
+  signals:
+    /// Emitted once when events are available after the previous signal
+    /// has been acknowledged.
+    void eventsAvailable();
+
+  private:
+    friend class PortMidiInputThread;
+
+    /// Reads the pending events of the device. Returns the number of
+    /// received events or a negative PmError. Only called by the thread.
+    int readEvents();
+    void notifyEventsAvailable();
+
+    PortMidiDevice* const m_pInputDevice;
+    const RuntimeLoggingCategory m_logInput;
+
+    // Same size as the PortMidi input buffer, see MIXXX_PORTMIDI_BUFFER_LEN
+    static constexpr int kReadBufferLength = 1024;
+    PmEvent m_readBuffer[kReadBufferLength];
+    rigtorp::SPSCQueue<PortMidiInputEvent> m_events;
+    std::atomic<bool> m_eventsAvailableSignalPending;
+    bool m_readErrorLogged;
+    bool m_queueOverflowLogged;
+};
+
+/// Reads the input streams of all open PortMidi devices in a single
+/// thread, because PortMidi is not thread-safe.
+///
+/// PortMidi offers no blocking read or event source, so the thread polls all
+/// streams at once. It polls at a short interval while any device is busy,
+/// e.g. while a jog wheel is turned, and backs off while all devices are
+/// idle. Without open inputs the thread waits without any wakeups.
+class PortMidiInputThread : public QThread {
+    Q_OBJECT
+  public:
+    /// Returns the shared thread and starts it if needed. The thread is
+    /// stopped when the last reference is released. Must only be called
+    /// from the controller thread.
+    static std::shared_ptr<PortMidiInputThread> instance();
+
+    ~PortMidiInputThread() override;
+
+    /// Starts reading the input. The stream must be open.
+    void addInput(PortMidiInput* pInput);
+    /// Stops reading the input. The stream is not accessed anymore when
+    /// this returns, so it may be closed.
+    void removeInput(PortMidiInput* pInput);
+
+    /// Converts a PortTime timestamp of PortMidi into the mixxx::Time clock.
+    static mixxx::Duration toElapsedTime(PmTimestamp timestamp,
+            PmTimestamp portTimeNow,
+            mixxx::Duration elapsedNow);
+
+  protected:
+    void run() override;
+
+  private:
+    PortMidiInputThread();
+
+    static std::weak_ptr<PortMidiInputThread> s_pInstance;
+
+    // Guards m_inputs and m_stop. Held while the inputs are read.
+    QMutex m_mutex;
+    QWaitCondition m_wakeup;
+    std::vector<PortMidiInput*> m_inputs;
+    bool m_stop;
+};
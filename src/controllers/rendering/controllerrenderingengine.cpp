@@ -10,6 +10,7 @@
 #include <QQuickRenderTarget>
 #include <QQuickWindow>
 #include <QThread>
+#include <cstring>
 
 #include "controllers/controller.h"
 #include "controllers/controllerenginethreadcontrol.h"
@@ -44,6 +45,7 @@ ControllerRenderingEngine::ControllerRenderingEngine(
           m_screenInfo(info),
           m_GLDataFormat(GL_RGBA),
           m_GLDataType(GL_UNSIGNED_BYTE),
+          m_sceneChanged(true),
           m_isValid(true),
           m_pEngineThreadControl(engineThreadControl) {
     switch (m_screenInfo.pixelFormat) {
@@ -214,6 +216,19 @@ void ControllerRenderingEngine::setup(std::shared_ptr<QQmlEngine> qmlEngine) {
 
     m_renderControl = std::make_unique<QQuickRenderControl>(this);
     m_quickWindow = std::make_unique<QQuickWindow>(m_renderControl.get());
+    // Static screens don't need to be rendered again
+    connect(m_renderControl.get(),
+            &QQuickRenderControl::renderRequested,
+            this,
+            [this] {
+                m_sceneChanged = true;
+            });
+    connect(m_renderControl.get(),
+            &QQuickRenderControl::sceneChanged,
+            this,
+            [this] {
+                m_sceneChanged = true;
+            });
 
     if (!qmlEngine->incubationController()) {
         qmlEngine->setIncubationController(m_quickWindow->incubationController());
@@ -259,6 +274,11 @@ void ControllerRenderingEngine::renderFrame() {
         return;
     }
 
+    if (!m_sceneChanged && m_fbo) {
+        skipFrame();
+        return;
+    }
+
     VERIFY_OR_TERMINATE(m_offscreenSurface->isValid(), "OffscreenSurface isn't valid anymore.");
     VERIFY_OR_TERMINATE(m_context->isValid(), "GLContext isn't valid anymore.");
     VERIFY_OR_TERMINATE(m_context->makeCurrent(m_offscreenSurface.get()),
@@ -291,6 +311,8 @@ void ControllerRenderingEngine::renderFrame() {
     }
 
     m_nextFrameStart = Clock::now();
+    // Changes during polish and sync request another frame
+    m_sceneChanged = false;
 
     m_renderControl->beginFrame();
 
@@ -361,9 +383,72 @@ void ControllerRenderingEngine::renderFrame() {
 
     fboImage.mirror(false, true);
 
-    emit frameRendered(m_screenInfo, fboImage.copy(), timestamp);
-
     m_context->doneCurrent();
+
+    const QRect dirtyRect = damagedRect(m_previousFrame, fboImage);
+    if (dirtyRect.isEmpty()) {
+        // E.g. an animation that has not moved by a full pixel
+        skipFrame();
+        return;
+    }
+    m_previousFrame = fboImage;
+    emit frameRendered(m_screenInfo, fboImage, timestamp, dirtyRect);
+}
+
+void ControllerRenderingEngine::skipFrame() {
+    // Paces the next frame like a frame that has been sent
+    send(nullptr, QByteArray());
+}
+
+// static
+QRect ControllerRenderingEngine::damagedRect(const QImage& previousFrame, const QImage& frame) {
+    if (previousFrame.size() != frame.size() || previousFrame.format() != frame.format()) {
+        return frame.rect();
+    }
+    const int bytesPerPixel = frame.depth() / 8;
+    const int bytesPerLine = frame.width() * bytesPerPixel;
+    if (bytesPerLine == 0) {
+        return QRect();
+    }
+
+    // Whole lines are compared with memcmp, which is vectorized by the C
+    // library. Unchanged lines are the common case for static screens.
+    int top = 0;
+    while (top < frame.height() &&
+            std::memcmp(previousFrame.constScanLine(top),
+                    frame.constScanLine(top),
+                    bytesPerLine) == 0) {
+        ++top;
+    }
+    if (top == frame.height()) {
+        return QRect();
+    }
+    int bottom = frame.height() - 1;
+    while (std::memcmp(previousFrame.constScanLine(bottom),
+                   frame.constScanLine(bottom),
+                   bytesPerLine) == 0) {
+        --bottom;
+    }
+
+    // Narrows the columns, each line is only scanned up to the bounds found
+    // in the lines before
+    int left = bytesPerLine;
+    int right = -1;
+    for (int y = top; y <= bottom; ++y) {
+        const uchar* pPrevious = previousFrame.constScanLine(y);
+        const uchar* pCurrent = frame.constScanLine(y);
+        int x = 0;
+        while (x < left && pPrevious[x] == pCurrent[x]) {
+            ++x;
+        }
+        left = x;
+        x = bytesPerLine - 1;
+        while (x > right && pPrevious[x] == pCurrent[x]) {
+            --x;
+        }
+        right = x;
+    }
+    return QRect(QPoint(left / bytesPerPixel, top), QPoint(right / bytesPerPixel, bottom));
 }
 
 bool ControllerRenderingEngine::stop() {
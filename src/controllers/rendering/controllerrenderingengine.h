@@ -1,8 +1,10 @@
 #pragma once
 
+#include <QImage>
 #include <QObject>
 #include <QOpenGLContext>
 #include <QOpenGLFramebufferObject>
+#include <QRect>
 #include <chrono>
 #include <gsl/pointers>
 
@@ -52,6 +54,11 @@ class ControllerRenderingEngine : public QObject {
         return m_screenInfo;
     }
 
+    /// Returns the bounding rectangle of the pixels that differ between two
+    /// frames, or the whole frame if their size or format differs. Returns an
+    /// empty rectangle if the frames are identical.
+    static QRect damagedRect(const QImage& previousFrame, const QImage& frame);
+
   public slots:
     // Request sending frame data to the device. The task will be run in the
     // rendering event loop. This method should only be called once received the
@@ -72,9 +79,12 @@ class ControllerRenderingEngine : public QObject {
     void send(Controller* controller, const QByteArray& frame);
 
   signals:
+    /// Emitted for rendered frames that differ from the previous frame.
+    /// `dirtyRect` is the region that has changed since the previous frame.
     void frameRendered(const LegacyControllerMapping::ScreenInfo& screeninfo,
             QImage frame,
-            const QDateTime& timestamp);
+            const QDateTime& timestamp,
+            const QRect& dirtyRect);
     void stopping();
     /// @brief Request the screen thread to send a frame to the device.
     /// @param controller the controller to send the frame to.
@@ -83,6 +93,8 @@ class ControllerRenderingEngine : public QObject {
 
   private:
     virtual void prepare();
+    /// Skips a frame, while keeping the frame pace
+    void skipFrame();
 
     std::chrono::time_point<std::chrono::steady_clock> m_nextFrameStart;
 
@@ -97,6 +109,11 @@ class ControllerRenderingEngine : public QObject {
 
     std::unique_ptr<QOpenGLFramebufferObject> m_fbo;
 
+    // Set when the scene needs to be polished, synced or rendered again
+    bool m_sceneChanged;
+    // The frame that has been sent last, for detecting the damaged region
+    QImage m_previousFrame;
+
     GLenum m_GLDataFormat;
     GLenum m_GLDataType;
 
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <QObject>
+#include <QString>
+
+class ControllerScriptInterfaceLegacy;
+class ControlObjectScript;
+
+/// ControlHandleJSProxy provides scripts with a handle to a single control,
+/// returned by engine.getControl(). The control is resolved once, so reading
+/// and writing the properties doesn't look up the control by group and name
+/// like engine.getValue() and engine.setValue() do on every call.
+class ControlHandleJSProxy : public QObject {
+    Q_OBJECT
+    Q_PROPERTY(QString group READ readGroup CONSTANT)
+    Q_PROPERTY(QString name READ readName CONSTANT)
+    Q_PROPERTY(double value READ readValue WRITE writeValue)
+    Q_PROPERTY(double parameter READ readParameter WRITE writeParameter)
+    Q_PROPERTY(double defaultValue READ readDefaultValue CONSTANT)
+  public:
+    ControlHandleJSProxy(ControllerScriptInterfaceLegacy* pScriptInterface,
+            ControlObjectScript* pControl)
+            : m_pScriptInterface(pScriptInterface),
+              m_pControl(pControl) {
+    }
+
+    QString readGroup() const;
+    QString readName() const;
+    double readValue() const;
+    void writeValue(double value);
+    double readParameter() const;
+    void writeParameter(double parameter);
+    double readDefaultValue() const;
+
+    Q_INVOKABLE void reset();
+    Q_INVOKABLE void trigger();
+
+  private:
+    // Both are owned by the "engine" object, which outlives the handles
+    ControllerScriptInterfaceLegacy* const m_pScriptInterface;
+    ControlObjectScript* const m_pControl;
+};
@@ -502,7 +502,8 @@ bool ControllerScriptEngineLegacy::bindSceneToScreen(
 void ControllerScriptEngineLegacy::handleScreenFrame(
         const LegacyControllerMapping::ScreenInfo& screenInfo,
         const QImage& frame,
-        const QDateTime& timestamp) {
+        const QDateTime& timestamp,
+        const QRect& dirtyRect) {
     VERIFY_OR_DEBUG_ASSERT(
             m_renderingScreens.contains(screenInfo.identifier)) {
         qCWarning(m_logger) << "Unable to find transform function info for the given screen";
@@ -563,9 +564,16 @@ void ControllerScriptEngineLegacy::handleScreenFrame(
     }
     // During the frame transformation, any QML errors are considered fatal.
     setErrorsAreFatal(true);
+    // Devices that support partial updates may only send the dirty region
+    QJSValue jsDirtyRect = m_pJSEngine->newObject();
+    jsDirtyRect.setProperty(QStringLiteral("x"), dirtyRect.x());
+    jsDirtyRect.setProperty(QStringLiteral("y"), dirtyRect.y());
+    jsDirtyRect.setProperty(QStringLiteral("width"), dirtyRect.width());
+    jsDirtyRect.setProperty(QStringLiteral("height"), dirtyRect.height());
     auto result = pScreen->getTransform().call(
             QJSValueList{m_pJSEngine->toScriptValue(input),
-                    m_pJSEngine->toScriptValue(timestamp)});
+                    m_pJSEngine->toScriptValue(timestamp),
+                    jsDirtyRect});
     if (result.isError()) {
         qCWarning(m_logger) << "Could not transform rendering buffer for screen"
                             << screenInfo.identifier;
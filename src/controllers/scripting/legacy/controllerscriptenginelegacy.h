@@ -7,11 +7,13 @@
 #include <memory>
 #ifdef MIXXX_USE_QML
 #include <QMetaMethod>
+#include <QRect>
 #include <unordered_map>
 #endif
 
 #include "controllers/legacycontrollermapping.h"
 #include "controllers/scripting/controllerscriptenginebase.h"
+#include "util/duration.h"
 
 #ifdef MIXXX_USE_QML
 class QQuickItem;
@@ -45,6 +47,15 @@ class ControllerScriptEngineLegacy : public ControllerScriptEngineBase {
         return m_pJSEngine;
     }
 
+    /// Arrival time of the controller input that is currently handled by
+    /// the mapping on the mixxx::Time clock, empty outside of input handlers.
+    mixxx::Duration inputTimestamp() const {
+        return m_inputTimestamp;
+    }
+    void setInputTimestamp(mixxx::Duration timestamp) {
+        m_inputTimestamp = timestamp;
+    }
+
   public slots:
     void setScriptFiles(const QList<LegacyControllerMapping::ScriptFileInfo>& scripts);
 
@@ -68,7 +79,8 @@ class ControllerScriptEngineLegacy : public ControllerScriptEngineBase {
     void handleScreenFrame(
             const LegacyControllerMapping::ScreenInfo& screeninfo,
             const QImage& frame,
-            const QDateTime& timestamp);
+            const QDateTime& timestamp,
+            const QRect& dirtyRect);
 
   signals:
     /// Emitted when a screen has been rendered.
@@ -131,6 +143,7 @@ class ControllerScriptEngineLegacy : public ControllerScriptEngineBase {
     QHash<QString, QJSValue> m_scriptWrappedFunctionCache;
     QList<LegacyControllerMapping::ScriptFileInfo> m_scriptFiles;
     QHash<QString, QJSValue> m_settings;
+    mixxx::Duration m_inputTimestamp;
 
     QFileSystemWatcher m_fileWatcher;
 
@@ -1,11 +1,13 @@
 #include "controllerscriptinterfacelegacy.h"
 
 #include <QStringEncoder>
+#include <algorithm>
 #include <gsl/pointers>
 
 #include "control/controlobject.h"
 #include "control/controlobjectscript.h"
 #include "control/controlpotmeter.h"
+#include "controllers/scripting/legacy/controlhandlejsproxy.h"
 #include "controllers/scripting/legacy/controllerscriptenginelegacy.h"
 #include "controllers/scripting/legacy/scriptconnectionjsproxy.h"
 #include "mixer/playermanager.h"
@@ -24,6 +26,9 @@ constexpr int kDecks = 16;
 // timer.
 constexpr int kScratchTimerMs = 1;
 constexpr double kAlphaBetaDt = kScratchTimerMs / 1000.0;
+// Longest time between two scratchTick() calls that is still considered a
+// continuous movement. The wheel is treated as stopped after a longer pause.
+constexpr mixxx::Duration kMaxScratchTickInterval = mixxx::Duration::fromMillis(20);
 // stop ramping at a rate which doesn't produce any audible output anymore
 constexpr double kBrakeRampToRate = 0.01;
 } // namespace
@@ -35,6 +40,7 @@ ControllerScriptInterfaceLegacy::ControllerScriptInterfaceLegacy(
     // Pre-allocate arrays for average number of virtual decks
     m_intervalAccumulator.resize(kDecks);
     m_lastMovement.resize(kDecks);
+    m_lastObservedMovement.resize(kDecks);
     m_dx.resize(kDecks);
     m_rampTo.resize(kDecks);
     m_ramp.resize(kDecks);
@@ -136,6 +142,21 @@ QJSValue ControllerScriptInterfaceLegacy::getSetting(const QString& name) {
     }
 }
 
+QJSValue ControllerScriptInterfaceLegacy::getControl(const QString& group, const QString& name) {
+    auto pJsEngine = m_pScriptEngineLegacy->jsEngine();
+    VERIFY_OR_DEBUG_ASSERT(pJsEngine) {
+        return QJSValue();
+    }
+    ControlObjectScript* coScript = getControlObjectScript(group, name);
+    if (coScript == nullptr) {
+        m_pScriptEngineLegacy->logOrThrowError(
+                QStringLiteral("Unknown control (%1, %2) returning null")
+                        .arg(group, name));
+        return QJSValue(QJSValue::NullValue);
+    }
+    return pJsEngine->newQObject(new ControlHandleJSProxy(this, coScript));
+}
+
 double ControllerScriptInterfaceLegacy::getValue(const QString& group, const QString& name) {
     ControlObjectScript* coScript = getControlObjectScript(group, name);
     if (coScript == nullptr) {
@@ -149,23 +170,27 @@ double ControllerScriptInterfaceLegacy::getValue(const QString& group, const QSt
 
 void ControllerScriptInterfaceLegacy::setValue(
         const QString& group, const QString& name, double newValue) {
+    ControlObjectScript* coScript = getControlObjectScript(group, name);
+
+    if (coScript != nullptr) {
+        setControlValue(coScript, newValue);
+    }
+}
+
+void ControllerScriptInterfaceLegacy::setControlValue(
+        ControlObjectScript* coScript, double newValue) {
     if (util_isnan(newValue)) {
         m_pScriptEngineLegacy->logOrThrowError(QStringLiteral(
                 "Script tried setting (%1, %2) to NotANumber (NaN)")
-                                                       .arg(group, name));
+                                                       .arg(coScript->getKey().group,
+                                                               coScript->getKey().item));
         return;
     }
-
-    ControlObjectScript* coScript = getControlObjectScript(group, name);
-
-    if (coScript != nullptr) {
-        ControlObject* pControl = ControlObject::getControl(
-                coScript->getKey(), ControlFlag::AllowMissingOrInvalid);
-        if (pControl &&
-                !m_st.ignore(
-                        pControl, coScript->getParameterForValue(newValue))) {
-            coScript->set(newValue);
-        }
+    ControlObject* pControl = coScript->getControlObject();
+    if (pControl &&
+            !m_st.ignore(
+                    pControl, coScript->getParameterForValue(newValue))) {
+        coScript->set(newValue);
     }
 }
 
@@ -182,21 +207,25 @@ double ControllerScriptInterfaceLegacy::getParameter(const QString& group, const
 
 void ControllerScriptInterfaceLegacy::setParameter(
         const QString& group, const QString& name, double newParameter) {
+    ControlObjectScript* coScript = getControlObjectScript(group, name);
+
+    if (coScript != nullptr) {
+        setControlParameter(coScript, newParameter);
+    }
+}
+
+void ControllerScriptInterfaceLegacy::setControlParameter(
+        ControlObjectScript* coScript, double newParameter) {
     if (util_isnan(newParameter)) {
         m_pScriptEngineLegacy->logOrThrowError(QStringLiteral(
                 "Script tried setting (%1, %2) to NotANumber (NaN)")
-                                                       .arg(group, name));
+                                                       .arg(coScript->getKey().group,
+                                                               coScript->getKey().item));
         return;
     }
-
-    ControlObjectScript* coScript = getControlObjectScript(group, name);
-
-    if (coScript != nullptr) {
-        ControlObject* pControl = ControlObject::getControl(
-                coScript->getKey(), ControlFlag::AllowMissingOrInvalid);
-        if (pControl && !m_st.ignore(pControl, newParameter)) {
-            coScript->setParameter(newParameter);
-        }
+    ControlObject* pControl = coScript->getControlObject();
+    if (pControl && !m_st.ignore(pControl, newParameter)) {
+        coScript->setParameter(newParameter);
     }
 }
 
@@ -701,6 +730,7 @@ void ControllerScriptInterfaceLegacy::scratchEnable(int deck,
 
     m_dx[deck] = 1.0 / intervalsPerSecond;
     m_intervalAccumulator[deck] = 0.0;
+    m_lastObservedMovement[deck] = mixxx::Duration::empty();
     m_ramp[deck] = false;
     m_rampFactor[deck] = 0.001;
     m_brakeActive[deck] = false;
@@ -752,7 +782,12 @@ void ControllerScriptInterfaceLegacy::scratchEnable(int deck,
 }
 
 void ControllerScriptInterfaceLegacy::scratchTick(int deck, int interval) {
-    m_lastMovement[deck] = mixxx::Time::elapsed();
+    // Prefer the arrival time of the MIDI message over the time it is
+    // processed, which is delayed by the event loop of the controller thread
+    const mixxx::Duration inputTimestamp = m_pScriptEngineLegacy->inputTimestamp();
+    m_lastMovement[deck] = inputTimestamp != mixxx::Duration::empty()
+            ? inputTimestamp
+            : mixxx::Time::elapsed();
     m_intervalAccumulator[deck] += interval;
 }
 
@@ -798,9 +833,25 @@ void ControllerScriptInterfaceLegacy::scratchProcess(int timerId) {
 #if SCRATCH_DEBUG_OUTPUT
         qDebug() << "     else";
 #endif
-        // This will (and should) be 0 if no net ticks have been accumulated
-        // (i.e. the wheel is stopped)
-        filter->observation(m_dx[deck] * m_intervalAccumulator[deck]);
+        // Controllers send their messages at a lower and irregular rate than
+        // this timer, so the accumulated movement is observed over the time
+        // between the timestamps of the messages instead of the timer period.
+        if (m_intervalAccumulator[deck] != 0) {
+            double dt = kAlphaBetaDt;
+            if (m_lastObservedMovement[deck] != mixxx::Duration::empty()) {
+                dt = std::clamp(
+                        (m_lastMovement[deck] - m_lastObservedMovement[deck])
+                                .toDoubleSeconds(),
+                        kAlphaBetaDt,
+                        kMaxScratchTickInterval.toDoubleSeconds());
+            }
+            filter->observation(m_dx[deck] * m_intervalAccumulator[deck], dt);
+            m_lastObservedMovement[deck] = m_lastMovement[deck];
+        } else if (mixxx::Time::elapsed() - m_lastMovement[deck] >
+                kMaxScratchTickInterval) {
+            // The wheel is stopped
+            filter->observation(0.0);
+        }
     }
 
     const double newRate = filter->predictedVelocity();
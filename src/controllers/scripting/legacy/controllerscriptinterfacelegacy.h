@@ -55,6 +55,9 @@ class ControllerScriptInterfaceLegacy : public QObject {
     virtual ~ControllerScriptInterfaceLegacy();
 
     Q_INVOKABLE QJSValue getSetting(const QString& name);
+    /// Returns a handle with value and parameter properties, that accesses
+    /// the control without looking it up again
+    Q_INVOKABLE QJSValue getControl(const QString& group, const QString& name);
     Q_INVOKABLE double getValue(const QString& group, const QString& name);
     Q_INVOKABLE void setValue(const QString& group, const QString& name, double newValue);
     Q_INVOKABLE double getParameter(const QString& group, const QString& name);
@@ -126,6 +129,8 @@ class ControllerScriptInterfaceLegacy : public QObject {
 
     QHash<ConfigKey, ControlObjectScript*> m_controlCache;
     ControlObjectScript* getControlObjectScript(const QString& group, const QString& name);
+    void setControlValue(ControlObjectScript* coScript, double newValue);
+    void setControlParameter(ControlObjectScript* coScript, double newParameter);
 
     SoftTakeoverCtrl m_st;
 
@@ -137,6 +142,8 @@ class ControllerScriptInterfaceLegacy : public QObject {
 
     QVarLengthArray<int> m_intervalAccumulator;
     QVarLengthArray<mixxx::Duration> m_lastMovement;
+    /// Timestamp of the last movement that has been fed into the filter
+    QVarLengthArray<mixxx::Duration> m_lastObservedMovement;
     QVarLengthArray<double> m_dx, m_rampTo, m_rampFactor;
     QVarLengthArray<bool> m_ramp, m_brakeActive, m_spinbackActive, m_softStartActive;
     QVarLengthArray<AlphaBetaFilter*> m_scratchFilters;
@@ -151,4 +158,7 @@ class ControllerScriptInterfaceLegacy : public QObject {
 
     ControllerScriptEngineLegacy* m_pScriptEngineLegacy;
     const RuntimeLoggingCategory m_logger;
+
+    friend class ControlHandleJSProxy;
+    friend class ControllerScriptEngineLegacyTest;
 };
@@ -13,6 +13,7 @@
 #include "controllers/controllermanager.h"
 #include "controllers/keyboard/keyboardeventfilter.h"
 #include "database/mixxxdb.h"
+#include "effects/backends/effectsbackendmanager.h"
 #include "effects/effectsmanager.h"
 #include "engine/enginemixer.h"
 #ifdef __RUBBERBAND__
@@ -47,14 +48,20 @@
 #include "qml/qmlplayerproxy.h"
 #endif
 #include "soundio/soundmanager.h"
+#ifdef __MAD__
+#include "sources/mp3seekindexcache.h"
+#endif
+#include "sources/audiosourcepcmcacheproxy.h"
 #include "sources/soundsourceproxy.h"
 #include "util/clipboard.h"
 #include "util/db/dbconnectionpooled.h"
 #include "util/font.h"
 #include "util/logger.h"
+#include "util/performancetimer.h"
 #include "util/screensavermanager.h"
 #include "util/statsmanager.h"
 #include "util/time.h"
+#include "util/tracerecorder.h"
 #include "util/translations.h"
 #include "util/versionstore.h"
 #include "vinylcontrol/vinylcontrolmanager.h"
@@ -141,6 +148,10 @@ CoreServices::CoreServices(const CmdlineArgs& args, QApplication* pApp)
     if (m_cmdlineArgs.getDeveloper()) {
         StatsManager::createInstance();
     }
+    // The trace can be saved from the developer menu at any time
+    if (m_cmdlineArgs.getDeveloper() || m_cmdlineArgs.getTraceEnabled()) {
+        TraceRecorder::setEnabled(true);
+    }
     mixxx::Translations::initializeTranslations(
             m_pSettingsManager->settings(), pApp, m_cmdlineArgs.getLocale());
     initializeKeyboard();
@@ -160,6 +171,11 @@ CoreServices::~CoreServices() {
         StatsManager::destroy();
     }
 
+    if (m_cmdlineArgs.getTraceEnabled()) {
+        TraceRecorder::setEnabled(false);
+        TraceRecorder::writeChromeTrace(m_cmdlineArgs.getTracePath());
+    }
+
     // HACK: Save config again. We saved it once before doing some dangerous
     // stuff. We only really want to save it here, but the first one was just
     // a precaution. The earlier one can be removed when stuff is more stable
@@ -255,13 +271,52 @@ void CoreServices::initialize(QApplication* pApp) {
 
     Sandbox::setPermissionsFilePath(QDir(pConfig->getSettingsPath()).filePath("sandbox.cfg"));
 
+#ifdef __MAD__
+    // Next to the analysis data, see AnalysisDao
+    mixxx::Mp3SeekIndexCache::setStorageDir(
+            QDir(pConfig->getSettingsPath()).filePath("analysis/mp3seekindex"));
+#endif
+    mixxx::AudioSourcePcmCacheProxy::setStorageDir(
+            QDir(pConfig->getSettingsPath()).filePath("cache/decodedaudio"));
+    mixxx::AudioSourcePcmCacheProxy::setMaxSizeBytes(
+            static_cast<qint64>(pConfig->getValue(
+                    mixxx::library::prefs::kDecodedAudioCacheSizeMiBConfigKey,
+                    mixxx::library::prefs::kDecodedAudioCacheSizeMiBDefault)) *
+            1024 * 1024);
+    mixxx::AudioSourcePcmCacheProxy::setEnabled(pConfig->getValue(
+            mixxx::library::prefs::kDecodedAudioCacheEnabledConfigKey,
+            mixxx::library::prefs::kDecodedAudioCacheEnabledDefault));
+
     QString resourcePath = pConfig->getResourcePath();
 
-    emit initializationProgressUpdate(0, tr("fonts"));
+    // Independent of the fonts and the database, joined when the
+    // EffectsManager and the SoundManager are created
+    EffectsBackendManager::startPluginDiscovery();
+    SoundManager::startPortAudioInitialization();
+
+    PerformanceTimer phaseTimer;
+    const char* pPhase = nullptr;
+    const auto finishPhase = [&phaseTimer, &pPhase]() {
+        if (pPhase) {
+            kLogger.info() << "Initialized" << pPhase << "in"
+                           << phaseTimer.elapsed().debugMillisWithUnit();
+        }
+    };
+    // The phase names are marked with QT_TR_NOOP, so they are logged
+    // untranslated and displayed translated
+    const auto startPhase = [this, &phaseTimer, &pPhase, &finishPhase](
+                                    int progress, const char* pNextPhase) {
+        finishPhase();
+        pPhase = pNextPhase;
+        phaseTimer.start();
+        emit initializationProgressUpdate(progress, tr(pNextPhase));
+    };
+
+    startPhase(0, QT_TR_NOOP("fonts"));
 
     FontUtils::initializeFonts(resourcePath); // takes a long time
 
-    emit initializationProgressUpdate(10, tr("database"));
+    startPhase(10, QT_TR_NOOP("database"));
     m_pDbConnectionPool = MixxxDb(pConfig).connectionPool();
     if (!m_pDbConnectionPool) {
         exit(-1);
@@ -276,7 +331,7 @@ void CoreServices::initialize(QApplication* pApp) {
 
     auto pChannelHandleFactory = std::make_shared<ChannelHandleFactory>();
 
-    emit initializationProgressUpdate(20, tr("effects"));
+    startPhase(20, QT_TR_NOOP("effects"));
     m_pEffectsManager = std::make_shared<EffectsManager>(pConfig, pChannelHandleFactory);
 
     m_pEngine = std::make_shared<EngineMixer>(
@@ -289,7 +344,7 @@ void CoreServices::initialize(QApplication* pApp) {
     RubberBandWorkerPool::createInstance(pConfig);
 #endif
 
-    emit initializationProgressUpdate(30, tr("audio interface"));
+    startPhase(30, QT_TR_NOOP("audio interface"));
     // Although m_pSoundManager is created here, m_pSoundManager->setupDevices()
     // needs to be called after m_pPlayerManager registers sound IO for each EngineChannel.
     m_pSoundManager = std::make_shared<SoundManager>(pConfig, m_pEngine.get());
@@ -309,7 +364,7 @@ void CoreServices::initialize(QApplication* pApp) {
     m_pVCManager = nullptr;
 #endif
 
-    emit initializationProgressUpdate(40, tr("decks"));
+    startPhase(40, QT_TR_NOOP("decks"));
     // Create the player manager. (long)
     m_pPlayerManager = std::make_shared<PlayerManager>(
             pConfig,
@@ -355,7 +410,7 @@ void CoreServices::initialize(QApplication* pApp) {
             m_pScreensaverManager.get(),
             &ScreensaverManager::slotCurrentPlayingDeckChanged);
 
-    emit initializationProgressUpdate(50, tr("library"));
+    startPhase(50, QT_TR_NOOP("library"));
     CoverArtCache::createInstance();
     Clipboard::createInstance();
 
@@ -398,7 +453,7 @@ void CoreServices::initialize(QApplication* pApp) {
         }
     }
 
-    emit initializationProgressUpdate(60, tr("controllers"));
+    startPhase(60, QT_TR_NOOP("controllers"));
     // Initialize controller sub-system,
     // but do not set up controllers until the end of the application startup
     // (long)
@@ -468,6 +523,7 @@ void CoreServices::initialize(QApplication* pApp) {
         }
     }
 
+    finishPhase();
     m_isInitialized = true;
 
 #ifdef MIXXX_USE_QML
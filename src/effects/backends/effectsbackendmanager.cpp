@@ -12,6 +12,22 @@
 #endif
 #include "effects/presets/effectpreset.h"
 
+#ifdef __LILV__
+// static
+std::future<EffectsBackendPointer> EffectsBackendManager::s_lv2BackendDiscovery;
+#endif
+
+// static
+void EffectsBackendManager::startPluginDiscovery() {
+#ifdef __LILV__
+    // Loading the LV2 world parses the TTL files of all installed bundles,
+    // which doesn't depend on anything else
+    s_lv2BackendDiscovery = std::async(std::launch::async, []() {
+        return EffectsBackendPointer(new LV2Backend());
+    });
+#endif
+}
+
 EffectsBackendManager::EffectsBackendManager() {
     m_pNumEffectsAvailable = std::make_unique<ControlObject>(
             ConfigKey("[Master]", "num_effectsavailable"));
@@ -22,7 +38,11 @@ EffectsBackendManager::EffectsBackendManager() {
     addBackend(createAudioUnitBackend());
 #endif
 #ifdef __LILV__
-    addBackend(EffectsBackendPointer(new LV2Backend()));
+    if (s_lv2BackendDiscovery.valid()) {
+        addBackend(s_lv2BackendDiscovery.get());
+    } else {
+        addBackend(EffectsBackendPointer(new LV2Backend()));
+    }
 #endif
 }
 
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <future>
+
 #include "effects/defs.h"
 
 class ControlObject;
@@ -12,6 +14,11 @@ class EffectsBackendManager {
     EffectsBackendManager();
     ~EffectsBackendManager() = default;
 
+    /// Starts discovering the installed plugins in a worker thread. The
+    /// next EffectsBackendManager waits for and uses the discovered
+    /// backends instead of discovering them in its constructor.
+    static void startPluginDiscovery();
+
     const QList<EffectManifestPointer>& getManifests() const {
         return m_manifests;
     };
@@ -27,6 +34,10 @@ class EffectsBackendManager {
   private:
     void addBackend(EffectsBackendPointer pEffectsBackend);
 
+#ifdef __LILV__
+    static std::future<EffectsBackendPointer> s_lv2BackendDiscovery;
+#endif
+
     std::unique_ptr<ControlObject> m_pNumEffectsAvailable;
 
     QHash<EffectBackendType, EffectsBackendPointer> m_effectsBackends;
@@ -2,15 +2,12 @@
 
 #include <rubberband/RubberBandStretcher.h>
 
-#include <QRunnable>
-#include <QSemaphore>
-#include <atomic>
-
 #include "audio/types.h"
+#include "util/spinparkevent.h"
 
 using RubberBand::RubberBandStretcher;
 
-class RubberBandTask : public RubberBandStretcher, public QRunnable {
+class RubberBandTask : public RubberBandStretcher {
   public:
     RubberBandTask(size_t sampleRate,
             size_t channels,
@@ -26,14 +23,17 @@ class RubberBandTask : public RubberBandStretcher, public QRunnable {
             size_t samples,
             bool isFinal);
 
-    // Wait for the current task to complete.
+    // Wait for the current task to complete. This spins briefly before
+    // parking the calling thread, and neither allocates nor locks.
     void waitReady();
 
+    // Process the submitted buffer and signal the completion. This is called
+    // either by a RubberBandWorker or by the engine thread itself.
     void run();
 
   private:
     // Whether or not the scheduled job as completed
-    QSemaphore m_completedSema;
+    SpinParkEvent m_completed;
 
     const float* const* m_input;
     size_t m_samples;
@@ -2,11 +2,59 @@
 
 #include <rubberband/RubberBandStretcher.h>
 
+#include "engine/bufferscalers/rubberbandtask.h"
 #include "engine/engine.h"
 #include "util/assert.h"
+#include "util/math.h"
 
-RubberBandWorkerPool::RubberBandWorkerPool(UserSettingsPointer pConfig)
-        : QThreadPool() {
+RubberBandWorker::RubberBandWorker(int index)
+        : m_pTask(nullptr),
+          m_stop(false) {
+    setObjectName(QStringLiteral("RubberBandWorker %1").arg(index));
+}
+
+RubberBandWorker::~RubberBandWorker() {
+    stop();
+}
+
+bool RubberBandWorker::tryStart(RubberBandTask* pTask) {
+    RubberBandTask* pExpected = nullptr;
+    if (!m_pTask.compare_exchange_strong(pExpected,
+                pTask,
+                std::memory_order_release,
+                std::memory_order_relaxed)) {
+        return false;
+    }
+    m_taskSubmitted.set();
+    return true;
+}
+
+void RubberBandWorker::stop() {
+    if (!isRunning()) {
+        return;
+    }
+    m_stop.store(true, std::memory_order_release);
+    m_taskSubmitted.set();
+    wait();
+}
+
+void RubberBandWorker::run() {
+    while (true) {
+        m_taskSubmitted.wait();
+        if (m_stop.load(std::memory_order_acquire)) {
+            return;
+        }
+        // Free the slot before processing, so the worker never touches it
+        // after the completion of the task has been signaled.
+        RubberBandTask* pTask = m_pTask.exchange(nullptr, std::memory_order_acquire);
+        VERIFY_OR_DEBUG_ASSERT(pTask) {
+            continue;
+        }
+        pTask->run();
+    }
+}
+
+RubberBandWorkerPool::RubberBandWorkerPool(UserSettingsPointer pConfig) {
     bool multiThreadedOnStereo = pConfig &&
             pConfig->getValue(ConfigKey(QStringLiteral("[App]"),
                                       QStringLiteral("keylock_multithreading")),
@@ -21,16 +69,26 @@ RubberBandWorkerPool::RubberBandWorkerPool(UserSettingsPointer pConfig)
 
     qDebug() << "RubberBand will use" << numRBTasks << "tasks to scale the audio signal";
 
-    setThreadPriority(QThread::HighPriority);
-    // The RB pool will only be used to scale n-1 buffer sample, so the engine
-    // thread takes care of the last buffer and doesn't have to be idle.
-    setMaxThreadCount(numRBTasks - 1);
-
-    // We allocate one runner less than the total of maximum supported channel,
+    // We allocate one worker less than the total of maximum supported channel,
     // so the engine thread will also perform a stretching operation, instead of
     // waiting all workers to complete. During performance testing, this ahas
     // show better results
-    for (int w = 0; w < maxThreadCount(); w++) {
-        reserveThread();
+    m_workers.reserve(math_max(numRBTasks - 1, 0));
+    for (int w = 0; w < numRBTasks - 1; w++) {
+        m_workers.push_back(std::make_unique<RubberBandWorker>(w));
+        m_workers.back()->start(QThread::HighPriority);
+    }
+}
+
+RubberBandWorkerPool::~RubberBandWorkerPool() {
+    for (const auto& pWorker : m_workers) {
+        pWorker->stop();
+    }
+}
+
+bool RubberBandWorkerPool::tryStart(RubberBandTask* pTask, int workerIndex) {
+    VERIFY_OR_DEBUG_ASSERT(workerIndex >= 0 && workerIndex < workerCount()) {
+        return false;
     }
+    return m_workers[workerIndex]->tryStart(pTask);
 }
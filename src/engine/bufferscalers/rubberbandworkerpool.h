@@ -1,26 +1,69 @@
 #pragma once
 
-#include <QThreadPool>
+#include <QThread>
+#include <atomic>
+#include <memory>
+#include <vector>
 
 #include "audio/types.h"
 #include "preferences/usersettings.h"
 #include "util/singleton.h"
+#include "util/spinparkevent.h"
 
-// RubberBandWorkerPool is a global pool manager for RubberBandWorkerPool. It
-// allows a the Engine thread to use a pool of agnostic RubberBandWorker which
-// can be distributed stretching job
-class RubberBandWorkerPool : public QThreadPool, public Singleton<RubberBandWorkerPool> {
+class RubberBandTask;
+
+// RubberBandWorker is a dedicated thread that processes the RubberBandTask
+// handed off by the engine thread. The hand off is lock-free: the task is
+// published in a single slot and the worker is woken up through a
+// SpinParkEvent, so the engine thread never allocates or blocks on a mutex.
+class RubberBandWorker : public QThread {
+  public:
+    explicit RubberBandWorker(int index);
+    ~RubberBandWorker() override;
+
+    /// Hands the task to the worker. Returns false without blocking if the
+    /// worker has not yet picked up a previously submitted task.
+    bool tryStart(RubberBandTask* pTask);
+
+    /// Stops the worker and waits until the thread has finished
+    void stop();
+
+  protected:
+    void run() override;
+
+  private:
+    std::atomic<RubberBandTask*> m_pTask;
+    std::atomic<bool> m_stop;
+    SpinParkEvent m_taskSubmitted;
+};
+
+// RubberBandWorkerPool is a global pool of RubberBandWorker. It allows the
+// Engine thread to distribute the stretching jobs of multi-channel signals
+// across a fixed set of threads, with each job always being scheduled on the
+// same worker.
+class RubberBandWorkerPool : public Singleton<RubberBandWorkerPool> {
   public:
     const mixxx::audio::ChannelCount& channelPerWorker() const {
         return m_channelPerWorker;
     }
 
+    /// The number of dedicated workers, without the engine thread
+    int workerCount() const {
+        return static_cast<int>(m_workers.size());
+    }
+
+    /// Hands the task to the worker with the given index. Returns false if
+    /// the worker is busy, in which case the caller should process the task
+    /// itself.
+    bool tryStart(RubberBandTask* pTask, int workerIndex);
+
   protected:
     RubberBandWorkerPool(UserSettingsPointer pConfig = nullptr);
+    ~RubberBandWorkerPool() override;
 
   private:
-    ;
     mixxx::audio::ChannelCount m_channelPerWorker;
+    std::vector<std::unique_ptr<RubberBandWorker>> m_workers;
 
     friend class Singleton<RubberBandWorkerPool>;
 };
@@ -52,7 +52,7 @@ mixxx::audio::ChannelCount getChannelPerWorker(mixxx::audio::ChannelCount chCoun
     }
     auto channelPerWorker = pPool->channelPerWorker();
     // The task count includes all the thread in the pool + the engine thread
-    auto maxThreadCount = pPool->maxThreadCount() + 1;
+    auto maxThreadCount = pPool->workerCount() + 1;
     VERIFY_OR_DEBUG_ASSERT(chCount % channelPerWorker == 0) {
         return mixxx::kEngineChannelOutputCount;
     }
@@ -181,18 +181,33 @@ void RubberBandWrapper::process(const float* const* input, size_t samples, bool
         return m_pInstances[0]->process(input, samples, isFinal);
     } else {
         RubberBandWorkerPool* pPool = RubberBandWorkerPool::instance();
-        for (auto& pInstance : m_pInstances) {
-            pInstance->set(input, samples, isFinal);
-            // We try to get the stretching job ran by the RBPool if there is a
-            // worker slot available
-            if (!pPool->tryStart(pInstance.get())) {
-                // Otherwise, it means the main thread should take care of the stretching
-                pInstance->run();
-            }
+        const int workerCount = pPool->workerCount();
+        const std::size_t lastInstance = m_pInstances.size() - 1;
+        // Each instance is always scheduled on the same worker, so its state
+        // stays in the cache of that thread. The last instance is processed by
+        // the engine thread while the workers are busy.
+        std::uint32_t runOnEngineThread = 1u << lastInstance;
+        for (std::size_t i = 0; i < m_pInstances.size(); i++) {
+            m_pInstances[i]->set(input, samples, isFinal);
             input += m_channelPerWorker;
+            if (i == lastInstance) {
+                break;
+            }
+            // If the worker is still busy, the engine thread takes care of
+            // the stretching
+            if (workerCount == 0 ||
+                    !pPool->tryStart(m_pInstances[i].get(),
+                            static_cast<int>(i) % workerCount)) {
+                runOnEngineThread |= 1u << i;
+            }
+        }
+        for (std::size_t i = 0; i < m_pInstances.size(); i++) {
+            if (runOnEngineThread & (1u << i)) {
+                m_pInstances[i]->run();
+            }
         }
         // We always perform a wait, even for task that were ran in the main
-        // thread, so it resets the semaphore
+        // thread, so it resets the completion event
         for (auto& pInstance : m_pInstances) {
             pInstance->waitReady();
         }
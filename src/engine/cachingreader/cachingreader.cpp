@@ -1,7 +1,11 @@
 #include "engine/cachingreader/cachingreader.h"
 
 #include <QtDebug>
+#include <cstdlib>
+#include <utility>
 
+#include "control/controlobject.h"
+#include "engine/cachingreader/residentsamplepool.h"
 #include "moc_cachingreader.cpp"
 #include "util/assert.h"
 #include "util/compatibility/qatomic.h"
@@ -21,7 +25,8 @@ constexpr SINT kDefaultHintFrames = 1024;
 // With CachingReaderChunk::kFrames = 8192 each chunk consumes
 // 8192 frames * 2 channels/frame * 4-bytes per sample = 65 kB for stereo frame.
 //
-//     80 chunks ->  5120 KB =  5 MB
+//     80 chunks ->  5120 KB =  5 MB (decks, samplers, preview deck)
+//     32 chunks ->  2048 KB =  2 MB (samplers with [Sampler],ResidentSamples)
 //
 // Each deck (including sample decks) will use their own CachingReader.
 // Consequently the total memory required for all allocated chunks depends
@@ -29,18 +34,47 @@ constexpr SINT kDefaultHintFrames = 1024;
 // CachingReader must be multiplied by the number of decks to calculate
 // the total amount!
 //
-// NOTE(uklotzde, 2019-09-05): Reduce this number to just few chunks
-// (kNumberOfCachedChunksInMemory = 1, 2, 3, ...) for testing purposes
+// NOTE(uklotzde, 2019-09-05): Reduce the number of cached chunks to just few
+// (CachingReader::kDefaultNumberOfCachedChunks = 1, 2, 3, ...) for testing purposes
 // to verify that the MRU/LRU cache works as expected. Even though
 // massive drop outs are expected to occur Mixxx should run reliably!
-constexpr SINT kNumberOfCachedChunksInMemory = 80;
+
+// The number of chunks that are kept in memory after each speculative hint,
+// e.g. a hotcue. This allows to continue playing after jumping to a hotcue
+// while the worker catches up with decoding the following chunks.
+constexpr SINT kSpeculativeHintChunks = 2;
+
+ReadRequestPriority priorityForHint(Hint::Type type) {
+    switch (type) {
+    case Hint::Type::SlipPosition:
+    case Hint::Type::CurrentPosition:
+        return ReadRequestPriority::CurrentPosition;
+    case Hint::Type::LoopStartEnabled:
+    case Hint::Type::LoopEndEnabled:
+    case Hint::Type::LoopStart:
+        return ReadRequestPriority::Loop;
+    case Hint::Type::MainCue:
+    case Hint::Type::HotCue:
+        return ReadRequestPriority::HotCue;
+    case Hint::Type::FirstSound:
+    case Hint::Type::IntroStart:
+    case Hint::Type::IntroEnd:
+    case Hint::Type::OutroStart:
+        return ReadRequestPriority::Cue;
+    }
+    DEBUG_ASSERT(!"unhandled Hint::Type");
+    return ReadRequestPriority::Cue;
+}
 
 } // anonymous namespace
 
 CachingReader::CachingReader(const QString& group,
         UserSettingsPointer config,
-        mixxx::audio::ChannelCount maxSupportedChannel)
+        mixxx::audio::ChannelCount maxSupportedChannel,
+        SINT numberOfCachedChunks,
+        bool residentSamples)
         : m_pConfig(config),
+          m_numberOfCachedChunks(numberOfCachedChunks),
           // Limit the number of in-flight requests to the worker. This should
           // prevent to overload the worker when it is not able to fetch those
           // requests from the FIFO timely. Otherwise outdated requests pile up
@@ -50,25 +84,36 @@ CachingReader::CachingReader(const QString& group,
           // buffer, where new requests replace old requests when full. Those
           // old requests need to be returned immediately to the CachingReader
           // that must take ownership and free them!!!
-          m_chunkReadRequestFIFO(kNumberOfCachedChunksInMemory / 4),
+          m_chunkReadRequestFIFO(numberOfCachedChunks / 4),
           // The capacity of the back channel must be equal to the number of
           // allocated chunks, because the worker use writeBlocking(). Otherwise
           // the worker could get stuck in a hot loop!!!
-          m_readerStatusUpdateFIFO(kNumberOfCachedChunksInMemory),
+          m_readerStatusUpdateFIFO(numberOfCachedChunks),
           m_state(STATE_IDLE),
           m_mruCachingReaderChunk(nullptr),
           m_lruCachingReaderChunk(nullptr),
           m_sampleBuffer(CachingReaderChunk::kFrames * maxSupportedChannel *
-                  kNumberOfCachedChunksInMemory),
+                  numberOfCachedChunks),
+          m_nextResidentChunkIndex(0),
+          m_lastResidentChunkIndex(-1),
+          m_pResidentSample(nullptr),
           m_worker(group,
                   &m_chunkReadRequestFIFO,
                   &m_readerStatusUpdateFIFO,
-                  maxSupportedChannel) {
-    m_allocatedCachingReaderChunks.reserve(kNumberOfCachedChunksInMemory);
+                  maxSupportedChannel,
+                  residentSamples),
+          m_pSeekCacheHits(std::make_unique<ControlObject>(
+                  ConfigKey(group, QStringLiteral("seek_cache_hits")))),
+          m_pSeekCacheMisses(std::make_unique<ControlObject>(
+                  ConfigKey(group, QStringLiteral("seek_cache_misses")))),
+          m_lastReadChunkIndex(-1) {
+    m_pSeekCacheHits->setReadOnly();
+    m_pSeekCacheMisses->setReadOnly();
+    m_allocatedCachingReaderChunks.reserve(m_numberOfCachedChunks);
     // Divide up the allocated raw memory buffer into total_chunks
     // chunks. Initialize each chunk to hold nothing and add it to the free
     // list.
-    for (SINT i = 0; i < kNumberOfCachedChunksInMemory; ++i) {
+    for (SINT i = 0; i < m_numberOfCachedChunks; ++i) {
         CachingReaderChunkForOwner* c =
                 new CachingReaderChunkForOwner(
                         mixxx::SampleBuffer::WritableSlice(
@@ -284,9 +329,27 @@ void CachingReader::process() {
                 }
                 // Reset the readable frame index range
                 m_readableFrameIndexRange = update.readableFrameIndexRange();
+                m_lastReadChunkIndex = -1;
+                m_pResidentSample = update.residentSample;
+                DEBUG_ASSERT(!m_pResidentSample ||
+                        m_pResidentSample->frameIndexRange() == m_readableFrameIndexRange);
+                // Keep short tracks like samples in memory entirely
+                m_nextResidentChunkIndex = 0;
+                m_lastResidentChunkIndex = -1;
+                if (!m_pResidentSample && !m_readableFrameIndexRange.empty()) {
+                    const SINT firstChunkIndex = CachingReaderChunk::indexForFrame(
+                            m_readableFrameIndexRange.start());
+                    const SINT lastChunkIndex = CachingReaderChunk::indexForFrame(
+                            m_readableFrameIndexRange.end() - 1);
+                    if (lastChunkIndex - firstChunkIndex < m_numberOfCachedChunks) {
+                        m_nextResidentChunkIndex = firstChunkIndex;
+                        m_lastResidentChunkIndex = lastChunkIndex;
+                    }
+                }
                 m_state.storeRelease(STATE_TRACK_LOADED);
             } else {
                 DEBUG_ASSERT(update.status == TRACK_UNLOADED);
+                m_pResidentSample = nullptr;
                 // This message could be processed later when a new
                 // track is already loading! In this case the TRACK_LOADED will
                 // be the very next status update.
@@ -365,6 +428,10 @@ CachingReader::ReadResult CachingReader::read(SINT startSample,
                     CachingReaderChunk::samples2frames(numSamples, channelCount));
     DEBUG_ASSERT(!remainingFrameIndexRange.empty());
 
+    if (m_pResidentSample) {
+        return readResidentSample(remainingFrameIndexRange, reverse, buffer, channelCount);
+    }
+
     auto result = ReadResult::AVAILABLE;
     if (!intersect(remainingFrameIndexRange, m_readableFrameIndexRange).empty()) {
         // Fill the buffer up to the first readable sample with
@@ -449,6 +516,13 @@ CachingReader::ReadResult CachingReader::read(SINT startSample,
 
                 mixxx::IndexRange bufferedFrameIndexRange;
                 const CachingReaderChunkForOwner* const pChunk = lookupChunkAndFreshen(chunkIndex);
+                if (chunkIndex == firstChunkIndex) {
+                    updateSeekStats(chunkIndex,
+                            pChunk &&
+                                    pChunk->getState() ==
+                                            CachingReaderChunkForOwner::READY);
+                }
+                m_lastReadChunkIndex = chunkIndex;
                 if (pChunk && (pChunk->getState() == CachingReaderChunkForOwner::READY)) {
                     if (reverse) {
                         bufferedFrameIndexRange =
@@ -536,22 +610,146 @@ CachingReader::ReadResult CachingReader::read(SINT startSample,
     return result;
 }
 
+CachingReader::ReadResult CachingReader::readResidentSample(
+        const mixxx::IndexRange& frameIndexRange,
+        bool reverse,
+        CSAMPLE* buffer,
+        mixxx::audio::ChannelCount channelCount) {
+    DEBUG_ASSERT(m_pResidentSample);
+    const SINT numSamples = CachingReaderChunk::frames2samples(
+            frameIndexRange.length(), channelCount);
+    const auto copiedFrameIndexRange = reverse
+            ? m_pResidentSample->readSampleFramesReverse(
+                      buffer + numSamples, channelCount, frameIndexRange)
+            : m_pResidentSample->readSampleFrames(
+                      buffer, channelCount, frameIndexRange);
+    if (copiedFrameIndexRange == frameIndexRange) {
+        return ReadResult::AVAILABLE;
+    }
+    if (copiedFrameIndexRange.empty()) {
+        SampleUtil::clear(buffer, numSamples);
+        return ReadResult::PARTIALLY_AVAILABLE;
+    }
+    // Fill the preroll before the start and the frames after the end of
+    // the track with silence
+    SINT leadingSamples = CachingReaderChunk::frames2samples(
+            copiedFrameIndexRange.start() - frameIndexRange.start(), channelCount);
+    SINT trailingSamples = CachingReaderChunk::frames2samples(
+            frameIndexRange.end() - copiedFrameIndexRange.end(), channelCount);
+    if (reverse) {
+        std::swap(leadingSamples, trailingSamples);
+    }
+    SampleUtil::clear(buffer, leadingSamples);
+    SampleUtil::clear(buffer + numSamples - trailingSamples, trailingSamples);
+    return ReadResult::PARTIALLY_AVAILABLE;
+}
+
+void CachingReader::updateSeekStats(SINT chunkIndex, bool cacheHit) {
+    // Reading from a chunk that is not adjacent to the previous one is
+    // considered as a seek, which is what the hints of likely seek targets
+    // should have prepared for.
+    const bool seek = m_lastReadChunkIndex >= 0 &&
+            std::abs(chunkIndex - m_lastReadChunkIndex) > 1;
+    if (!seek) {
+        return;
+    }
+    if (cacheHit) {
+        m_pSeekCacheHits->forceSet(m_pSeekCacheHits->get() + 1);
+    } else {
+        m_pSeekCacheMisses->forceSet(m_pSeekCacheMisses->get() + 1);
+    }
+}
+
+bool CachingReader::submitReadRequest(
+        CachingReaderChunkForOwner* pChunk, ReadRequestPriority priority) {
+    // Do not insert the allocated chunk into the MRU/LRU list,
+    // because it will be handed over to the worker immediately
+    const SINT chunkIndex = pChunk->getIndex();
+    CachingReaderChunkReadRequest request;
+    request.giveToWorker(pChunk, priority);
+    if (kLogger.traceEnabled()) {
+        kLogger.trace()
+                << "Requesting read of chunk"
+                << request.chunk;
+    }
+    if (m_chunkReadRequestFIFO.write(&request, 1) != 1) {
+        kLogger.warning()
+                << "Failed to submit read request for chunk"
+                << chunkIndex;
+        // Revoke the chunk from the worker and free it
+        pChunk->takeFromWorker();
+        freeChunk(pChunk);
+        return false;
+    }
+    return true;
+}
+
+bool CachingReader::preloadNextResidentChunk() {
+    if (m_nextResidentChunkIndex > m_lastResidentChunkIndex) {
+        return false;
+    }
+    // Only a single preload request is in flight at any time, so preloading
+    // never delays the read requests of the hints.
+    const auto* pPreviousChunk = lookupChunk(m_nextResidentChunkIndex - 1);
+    if (pPreviousChunk &&
+            pPreviousChunk->getState() == CachingReaderChunkForOwner::READ_PENDING) {
+        return false;
+    }
+    // Skip chunks that have already been requested by hints
+    while (lookupChunk(m_nextResidentChunkIndex)) {
+        if (++m_nextResidentChunkIndex > m_lastResidentChunkIndex) {
+            return false;
+        }
+    }
+    // The whole track fits into the cache, so a free chunk is available
+    // unless the readable range has changed. Never expire other chunks.
+    auto* pChunk = allocateChunk(m_nextResidentChunkIndex);
+    if (!pChunk) {
+        m_lastResidentChunkIndex = -1;
+        return false;
+    }
+    if (!submitReadRequest(pChunk, ReadRequestPriority::Preload)) {
+        // Retry with the next callback
+        return false;
+    }
+    ++m_nextResidentChunkIndex;
+    return true;
+}
+
 void CachingReader::hintAndMaybeWake(const HintVector& hintList) {
     // If no file is loaded, skip.
     if (atomicLoadRelaxed(m_state) != STATE_TRACK_LOADED) {
         return;
     }
+    // Resident samples are in memory entirely
+    if (m_pResidentSample) {
+        return;
+    }
 
     // For every chunk that the hints indicated, check if it is in the cache. If
     // any are not, then wake.
     bool shouldWake = false;
+    SINT speculativeChunks = 0;
 
     for (const auto& hint: hintList) {
         SINT hintFrame = hint.frame;
         SINT hintFrameCount = hint.frameCount;
 
         // Handle some special length values
-        if (hintFrameCount == Hint::kFrameCountForward) {
+        if (hintFrameCount == Hint::kFrameCountSpeculative) {
+            // Speculative hints are dropped when exceeding half of the cache
+            // per callback, so they can never evict the chunks around the
+            // play position. The hints are ordered by their likeliness, so
+            // only the least likely seek targets are affected.
+            if (speculativeChunks + kSpeculativeHintChunks > m_numberOfCachedChunks / 2) {
+                continue;
+            }
+            speculativeChunks += kSpeculativeHintChunks;
+            // Cover the remainder of the chunk with the hinted frame and the
+            // following chunks
+            hintFrameCount = kSpeculativeHintChunks * CachingReaderChunk::kFrames -
+                    hintFrame % CachingReaderChunk::kFrames;
+        } else if (hintFrameCount == Hint::kFrameCountForward) {
         	hintFrameCount = kDefaultHintFrames;
         } else if (hintFrameCount == Hint::kFrameCountBackward) {
         	hintFrame -= kDefaultHintFrames;
@@ -591,23 +789,7 @@ void CachingReader::hintAndMaybeWake(const HintVector& hintList) {
                             << "for read request";
                     continue;
                 }
-                // Do not insert the allocated chunk into the MRU/LRU list,
-                // because it will be handed over to the worker immediately
-                CachingReaderChunkReadRequest request;
-                request.giveToWorker(pChunk);
-                if (kLogger.traceEnabled()) {
-                    kLogger.trace()
-                            << "Requesting read of chunk"
-                            << request.chunk;
-                }
-                if (m_chunkReadRequestFIFO.write(&request, 1) != 1) {
-                    kLogger.warning()
-                            << "Failed to submit read request for chunk"
-                            << chunkIndex;
-                    // Revoke the chunk from the worker and free it
-                    pChunk->takeFromWorker();
-                    freeChunk(pChunk);
-                }
+                submitReadRequest(pChunk, priorityForHint(hint.type));
             } else if (pChunk->getState() == CachingReaderChunkForOwner::READY) {
                 // This will cause the chunk to be 'freshened' in the cache. The
                 // chunk will be moved to the end of the LRU list.
@@ -616,6 +798,10 @@ void CachingReader::hintAndMaybeWake(const HintVector& hintList) {
         }
     }
 
+    if (preloadNextResidentChunk()) {
+        shouldWake = true;
+    }
+
     // If there are chunks to be read, wake up.
     if (shouldWake) {
         m_worker.workReady();
@@ -6,6 +6,7 @@
 #include <QVarLengthArray>
 #include <QVector>
 #include <list>
+#include <memory>
 
 #include "engine/cachingreader/cachingreaderworker.h"
 #include "preferences/usersettings.h"
@@ -13,22 +14,26 @@
 #include "util/fifo.h"
 #include "util/types.h"
 
+class ControlObject;
+
 // A Hint is an indication to the CachingReader that a certain section of a
 // SoundSource will be used 'soon' and so it should be brought into memory by
 // the reader work thread.
 typedef struct Hint {
+    // The type determines the priority of the read requests for the hinted
+    // chunks, see ReadRequestPriority.
     enum class Type {
-        SlipPosition,     // prio 1 (so far unused Mixxx 2.3 priority for reference)
-        CurrentPosition,  // prio 1
-        LoopStartEnabled, // prio 2
-        MainCue,          // prio 10
-        HotCue,           // prio 10
-        LoopEndEnabled,   // prio 10
-        LoopStart,        // prio 10
-        FirstSound,
-        IntroStart,
-        IntroEnd,
-        OutroStart
+        SlipPosition,     // current position
+        CurrentPosition,  // current position
+        LoopStartEnabled, // loop
+        MainCue,          // hotcue
+        HotCue,           // hotcue, in the order of the hints
+        LoopEndEnabled,   // loop
+        LoopStart,        // loop
+        FirstSound,       // cue
+        IntroStart,       // cue
+        IntroEnd,         // cue
+        OutroStart        // cue
     };
 
     // The frame to ensure is present in memory.
@@ -36,13 +41,15 @@ typedef struct Hint {
     // If a range of frames should be present, use frameCount to indicate that the
     // range (frame, frame + frameCount) should be present in memory.
     SINT frameCount;
-    // Currently unused -- but in the future could be used to prioritize certain
-    // hints over others.
+    // Used to prioritize the decoding of hints over others.
     Type type;
 
     // for the default frame count in forward direction
     static constexpr SINT kFrameCountForward = 0;
     static constexpr SINT kFrameCountBackward = -1;
+    // for keeping the first chunks after a likely seek target in memory,
+    // within a budget shared by all speculative hints of a callback
+    static constexpr SINT kFrameCountSpeculative = -2;
 } Hint;
 
 // Note that we use a QVarLengthArray here instead of a QVector. Since this list
@@ -80,10 +87,20 @@ class CachingReader : public QObject {
     Q_OBJECT
 
   public:
-    // Construct a CachingReader with the given group.
+    // The number of chunks that are cached by the reader of a deck
+    static constexpr SINT kDefaultNumberOfCachedChunks = 80;
+    // Samplers in short-sample mode play short tracks from the
+    // ResidentSamplePool. The smaller chunk cache is only used for longer
+    // tracks.
+    static constexpr SINT kResidentSamplesNumberOfCachedChunks = 32;
+
+    // Construct a CachingReader with the given group. If residentSamples is
+    // set, short tracks are decoded entirely into the ResidentSamplePool.
     CachingReader(const QString& group,
             UserSettingsPointer _config,
-            mixxx::audio::ChannelCount maxSupportedChannel);
+            mixxx::audio::ChannelCount maxSupportedChannel,
+            SINT numberOfCachedChunks = kDefaultNumberOfCachedChunks,
+            bool residentSamples = false);
     ~CachingReader() override;
 
     void process();
@@ -136,7 +153,10 @@ class CachingReader : public QObject {
     void trackLoadFailed(TrackPointer pTrack, const QString& reason);
 
   private:
+    friend class CachingReaderTest;
+
     const UserSettingsPointer m_pConfig;
+    const SINT m_numberOfCachedChunks;
 
     // Thread-safe FIFOs for communication between the engine callback and
     // reader thread.
@@ -168,6 +188,24 @@ class CachingReader : public QObject {
     // Gets a chunk from the free list, frees the LRU CachingReaderChunk if none available.
     CachingReaderChunkForOwner* allocateChunkExpireLRU(SINT chunkIndex);
 
+    // Hands the chunk over to the worker. Frees the chunk and returns false
+    // if the request FIFO is full.
+    bool submitReadRequest(CachingReaderChunkForOwner* pChunk, ReadRequestPriority priority);
+
+    // Requests the next chunk of a track that fits into the cache entirely.
+    // Returns true if a read request has been submitted.
+    bool preloadNextResidentChunk();
+
+    // Reads from m_pResidentSample instead of the chunk cache
+    ReadResult readResidentSample(
+            const mixxx::IndexRange& frameIndexRange,
+            bool reverse,
+            CSAMPLE* buffer,
+            mixxx::audio::ChannelCount channelCount);
+
+    // Counts a cache hit or miss if the chunk is read after a seek.
+    void updateSeekStats(SINT chunkIndex, bool cacheHit);
+
     enum State {
         STATE_IDLE,
         STATE_TRACK_LOADING,
@@ -197,5 +235,22 @@ class CachingReader : public QObject {
     // The readable frame index range as reported by the worker.
     mixxx::IndexRange m_readableFrameIndexRange;
 
+    // The chunks of a track that fits into the cache are preloaded one by
+    // one, so a sample is played without any cache misses after it has been
+    // loaded. m_lastResidentChunkIndex is -1 if the track doesn't fit.
+    SINT m_nextResidentChunkIndex;
+    SINT m_lastResidentChunkIndex;
+
+    // The decoded track while it is loaded if it is kept in the
+    // ResidentSamplePool. Bypasses the chunk cache. Owned by the worker.
+    const ResidentSample* m_pResidentSample;
+
     CachingReaderWorker m_worker;
+
+    // Statistics about reads after a seek, i.e. whether the jump target has
+    // been decoded in advance.
+    std::unique_ptr<ControlObject> m_pSeekCacheHits;
+    std::unique_ptr<ControlObject> m_pSeekCacheMisses;
+    // The chunk index that was read last, or -1 if there was no read
+    SINT m_lastReadChunkIndex;
 };
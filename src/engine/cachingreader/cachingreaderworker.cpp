@@ -2,9 +2,12 @@
 
 #include <QAtomicInt>
 #include <QtDebug>
+#include <algorithm>
 
 #include "analyzer/analyzersilence.h"
+#include "engine/cachingreader/residentsamplepool.h"
 #include "moc_cachingreaderworker.cpp"
+#include "sources/audiosourcepcmcacheproxy.h"
 #include "sources/soundsourceproxy.h"
 #include "track/track.h"
 #include "util/compatibility/qmutex.h"
@@ -26,12 +29,17 @@ CachingReaderWorker::CachingReaderWorker(
         const QString& group,
         FIFO<CachingReaderChunkReadRequest>* pChunkReadRequestFIFO,
         FIFO<ReaderStatusUpdate>* pReaderStatusFIFO,
-        mixxx::audio::ChannelCount maxSupportedChannel)
+        mixxx::audio::ChannelCount maxSupportedChannel,
+        bool residentSamples)
         : m_group(group),
           m_tag(QString("CachingReaderWorker %1").arg(m_group)),
           m_pChunkReadRequestFIFO(pChunkReadRequestFIFO),
           m_pReaderStatusFIFO(pReaderStatusFIFO),
+          m_residentSamples(residentSamples),
           m_maxSupportedChannel(maxSupportedChannel) {
+    // Resident samples are stereo
+    DEBUG_ASSERT(!m_residentSamples ||
+            m_maxSupportedChannel == mixxx::audio::ChannelCount::stereo());
 }
 
 ReaderStatusUpdate CachingReaderWorker::processReadRequest(
@@ -146,7 +154,7 @@ void CachingReaderWorker::run() {
                 // here, the engine is already stopped
                 unloadTrack();
             }
-        } else if (m_pChunkReadRequestFIFO->read(&request, 1) == 1) {
+        } else if (takeNextReadRequest(&request)) {
             // Read the requested chunk and send the result
             const ReaderStatusUpdate update = processReadRequest(request);
             m_pReaderStatusFIFO->writeBlocking(&update, 1);
@@ -158,7 +166,32 @@ void CachingReaderWorker::run() {
     }
 }
 
+bool CachingReaderWorker::takeNextReadRequest(CachingReaderChunkReadRequest* pRequest) {
+    CachingReaderChunkReadRequest request;
+    while (m_pChunkReadRequestFIFO->read(&request, 1) == 1) {
+        m_pendingReadRequests.append(request);
+    }
+    if (m_pendingReadRequests.isEmpty()) {
+        return false;
+    }
+    // Pick the first request with the highest priority. The list is short,
+    // it is limited by the capacity of the request FIFO in most cases.
+    const auto it = std::min_element(m_pendingReadRequests.cbegin(),
+            m_pendingReadRequests.cend(),
+            [](const auto& lhs, const auto& rhs) {
+                return lhs.priority < rhs.priority;
+            });
+    *pRequest = *it;
+    m_pendingReadRequests.erase(it);
+    return true;
+}
+
 void CachingReaderWorker::discardAllPendingRequests() {
+    for (const auto& request : std::as_const(m_pendingReadRequests)) {
+        const auto update = ReaderStatusUpdate::readDiscarded(request.chunk);
+        m_pReaderStatusFIFO->writeBlocking(&update, 1);
+    }
+    m_pendingReadRequests.clear();
     CachingReaderChunkReadRequest request;
     while (m_pChunkReadRequestFIFO->read(&request, 1) == 1) {
         const auto update = ReaderStatusUpdate::readDiscarded(request.chunk);
@@ -174,6 +207,8 @@ void CachingReaderWorker::closeAudioSource() {
         m_pAudioSource->close();
         m_pAudioSource.reset();
     }
+    // Released outside of the engine thread, see ResidentSamplePool
+    m_pResidentSample.reset();
 
     // This function has to be called with the engine stopped only
     // to avoid collecting new requests for the old track
@@ -218,6 +253,17 @@ void CachingReaderWorker::loadTrack(const TrackPointer& pTrack) {
     config.setStemMask(stemMask);
 #endif
     m_pAudioSource = SoundSourceProxy(pTrack).openAudioSource(config);
+#ifdef __STEM__
+    // The cache is keyed by file, i.e. it cannot distinguish mixes of
+    // different stem selections
+    if (!stemMask)
+#endif
+    {
+        m_pAudioSource = mixxx::AudioSourcePcmCacheProxy::create(
+                std::move(m_pAudioSource),
+                pTrack->getFileInfo().asQFileInfo(),
+                pTrack->getType());
+    }
     if (!m_pAudioSource) {
         kLogger.warning()
                 << m_group
@@ -275,9 +321,21 @@ void CachingReaderWorker::loadTrack(const TrackPointer& pTrack) {
         mixxx::SampleBuffer(tempReadBufferSize).swap(m_tempReadBuffer);
     }
 
+#ifdef __STEM__
+    // The pool is keyed by file, like the PCM cache
+    if (m_residentSamples && !stemMask)
+#else
+    if (m_residentSamples)
+#endif
+    {
+        m_pResidentSample = ResidentSamplePool::acquire(
+                pTrack->getLocation(), m_pAudioSource);
+    }
+
     const auto update =
             ReaderStatusUpdate::trackLoaded(
-                    m_pAudioSource->frameIndexRange());
+                    m_pAudioSource->frameIndexRange(),
+                    m_pResidentSample.get());
     m_pReaderStatusFIFO->writeBlocking(&update, 1);
 
     // Emit that the track is loaded.
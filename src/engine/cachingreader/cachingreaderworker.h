@@ -2,6 +2,8 @@
 
 #include <QMutex>
 #include <QString>
+#include <QVarLengthArray>
+#include <memory>
 
 #include "audio/frame.h"
 #include "audio/types.h"
@@ -12,14 +14,30 @@
 
 template<class DataType>
 class FIFO;
+class ResidentSample;
+
+// The order in which the worker processes pending read requests. Requests
+// with a lower value are processed first, requests with the same priority in
+// the order they have been submitted.
+enum class ReadRequestPriority {
+    CurrentPosition = 0,
+    Loop = 1,
+    HotCue = 2,
+    Cue = 3,
+    // Preloading the remainder of a track that fits into the cache
+    Preload = 4,
+};
 
 // POD with trivial ctor/dtor/copy for passing through FIFO
 typedef struct CachingReaderChunkReadRequest {
     CachingReaderChunk* chunk;
+    ReadRequestPriority priority;
 
-    void giveToWorker(CachingReaderChunkForOwner* chunkForOwner) {
+    void giveToWorker(CachingReaderChunkForOwner* chunkForOwner,
+            ReadRequestPriority priorityArg) {
         DEBUG_ASSERT(chunkForOwner);
         chunk = chunkForOwner;
+        priority = priorityArg;
         chunkForOwner->giveToWorker();
     }
 } CachingReaderChunkReadRequest;
@@ -42,6 +60,9 @@ typedef struct ReaderStatusUpdate {
 
   public:
     ReaderStatus status;
+    // The decoded track if it is resident, only set for TRACK_LOADED. Owned
+    // by the worker until the next track is loaded or unloaded.
+    const ResidentSample* residentSample;
 
     void init(
             ReaderStatus statusArg,
@@ -51,6 +72,7 @@ typedef struct ReaderStatusUpdate {
         chunk = chunkArg;
         readableFrameIndexRangeStart = readableFrameIndexRangeArg.start();
         readableFrameIndexRangeEnd = readableFrameIndexRangeArg.end();
+        residentSample = nullptr;
     }
 
     static ReaderStatusUpdate readDiscarded(
@@ -61,10 +83,12 @@ typedef struct ReaderStatusUpdate {
     }
 
     static ReaderStatusUpdate trackLoaded(
-            const mixxx::IndexRange& readableFrameIndexRange) {
+            const mixxx::IndexRange& readableFrameIndexRange,
+            const ResidentSample* residentSample = nullptr) {
         DEBUG_ASSERT(!readableFrameIndexRange.empty());
         ReaderStatusUpdate update;
         update.init(TRACK_LOADED, nullptr, readableFrameIndexRange);
+        update.residentSample = residentSample;
         return update;
     }
 
@@ -100,7 +124,8 @@ class CachingReaderWorker : public EngineWorker {
     CachingReaderWorker(const QString& group,
             FIFO<CachingReaderChunkReadRequest>* pChunkReadRequestFIFO,
             FIFO<ReaderStatusUpdate>* pReaderStatusFIFO,
-            mixxx::audio::ChannelCount maxSupportedChannel);
+            mixxx::audio::ChannelCount maxSupportedChannel,
+            bool residentSamples = false);
     ~CachingReaderWorker() override = default;
 
     // Request to load a new track. wake() must be called afterwards.
@@ -140,6 +165,10 @@ class CachingReaderWorker : public EngineWorker {
     FIFO<CachingReaderChunkReadRequest>* m_pChunkReadRequestFIFO;
     FIFO<ReaderStatusUpdate>* m_pReaderStatusFIFO;
 
+    // Requests that have been fetched from the FIFO but not yet processed,
+    // in the order of submission.
+    QVarLengthArray<CachingReaderChunkReadRequest, 32> m_pendingReadRequests;
+
     // Queue of Tracks to load, and the corresponding lock. Must acquire the
     // lock to touch.
     QMutex m_newTrackMutex;
@@ -150,6 +179,11 @@ class CachingReaderWorker : public EngineWorker {
     TrackPointer m_pNewTrack;
 #endif
 
+    // Moves all requests from the FIFO into the pending requests and takes
+    // the one with the highest priority. Returns false if there are no
+    // pending requests.
+    bool takeNextReadRequest(CachingReaderChunkReadRequest* pRequest);
+
     void discardAllPendingRequests();
 
     /// call to be prepare for new tracks
@@ -176,6 +210,12 @@ class CachingReaderWorker : public EngineWorker {
     // The current audio source of the track loaded
     mixxx::AudioSourcePointer m_pAudioSource;
 
+    // Short tracks are decoded entirely into the ResidentSamplePool
+    const bool m_residentSamples;
+    // The decoded track if it is resident. The engine only accesses it
+    // while the track is loaded.
+    std::shared_ptr<const ResidentSample> m_pResidentSample;
+
     mixxx::audio::FramePos m_firstSoundFrameToVerify;
 
     // Temporary buffer for reading samples from all channels
@@ -0,0 +1,180 @@
+#include "engine/cachingreader/residentsamplepool.h"
+
+#include <QHash>
+#include <QMutex>
+
+#include "sources/audiosourcestereoproxy.h"
+#include "util/compatibility/qmutex.h"
+#include "util/logger.h"
+#include "util/sample.h"
+
+namespace {
+
+const mixxx::Logger kLogger("ResidentSamplePool");
+
+struct PoolEntry {
+    std::weak_ptr<const ResidentSample> pSample;
+    mixxx::audio::SampleRate sampleRate;
+};
+
+// Guards s_entries. Never held while decoding.
+QMutex s_mutex;
+QHash<QString, PoolEntry> s_entries;
+
+SINT frames2samples(SINT frames, mixxx::audio::ChannelCount channelCount) {
+    return frames * channelCount;
+}
+
+// Must be called with s_mutex locked
+std::shared_ptr<const ResidentSample> lookupSample(
+        const QString& location,
+        const mixxx::AudioSourcePointer& pAudioSource) {
+    const auto it = s_entries.constFind(location);
+    if (it == s_entries.constEnd()) {
+        return nullptr;
+    }
+    auto pSample = it->pSample.lock();
+    if (!pSample ||
+            it->sampleRate != pAudioSource->getSignalInfo().getSampleRate() ||
+            pSample->frameIndexRange() != pAudioSource->frameIndexRange()) {
+        // Released or the file has been modified
+        return nullptr;
+    }
+    return pSample;
+}
+
+} // namespace
+
+ResidentSample::ResidentSample(mixxx::IndexRange frameIndexRange)
+        : m_frameIndexRange(frameIndexRange),
+          m_sampleBuffer(frames2samples(frameIndexRange.length(),
+                  mixxx::audio::ChannelCount::stereo())) {
+}
+
+mixxx::IndexRange ResidentSample::readSampleFrames(
+        CSAMPLE* sampleBuffer,
+        mixxx::audio::ChannelCount channelCount,
+        const mixxx::IndexRange& frameIndexRange) const {
+    DEBUG_ASSERT(channelCount == mixxx::audio::ChannelCount::stereo());
+    const auto copyableFrameIndexRange = intersect(frameIndexRange, m_frameIndexRange);
+    if (!copyableFrameIndexRange.empty()) {
+        const SINT dstSampleOffset = frames2samples(
+                copyableFrameIndexRange.start() - frameIndexRange.start(),
+                channelCount);
+        const SINT srcSampleOffset = frames2samples(
+                copyableFrameIndexRange.start() - m_frameIndexRange.start(),
+                channelCount);
+        const SINT sampleCount = frames2samples(copyableFrameIndexRange.length(), channelCount);
+        SampleUtil::copy(
+                sampleBuffer + dstSampleOffset,
+                m_sampleBuffer.data(srcSampleOffset),
+                sampleCount);
+    }
+    return copyableFrameIndexRange;
+}
+
+mixxx::IndexRange ResidentSample::readSampleFramesReverse(
+        CSAMPLE* reverseSampleBuffer,
+        mixxx::audio::ChannelCount channelCount,
+        const mixxx::IndexRange& frameIndexRange) const {
+    DEBUG_ASSERT(channelCount == mixxx::audio::ChannelCount::stereo());
+    const auto copyableFrameIndexRange = intersect(frameIndexRange, m_frameIndexRange);
+    if (!copyableFrameIndexRange.empty()) {
+        const SINT dstSampleOffset = frames2samples(
+                copyableFrameIndexRange.start() - frameIndexRange.start(),
+                channelCount);
+        const SINT srcSampleOffset = frames2samples(
+                copyableFrameIndexRange.start() - m_frameIndexRange.start(),
+                channelCount);
+        const SINT sampleCount = frames2samples(copyableFrameIndexRange.length(), channelCount);
+        SampleUtil::copyReverse(
+                reverseSampleBuffer - dstSampleOffset - sampleCount,
+                m_sampleBuffer.data(srcSampleOffset),
+                sampleCount,
+                channelCount);
+    }
+    return copyableFrameIndexRange;
+}
+
+// static
+std::shared_ptr<const ResidentSample> ResidentSamplePool::acquire(
+        const QString& location,
+        const mixxx::AudioSourcePointer& pAudioSource) {
+    VERIFY_OR_DEBUG_ASSERT(pAudioSource) {
+        return nullptr;
+    }
+    const auto frameIndexRange = pAudioSource->frameIndexRange();
+    const auto sampleRate = pAudioSource->getSignalInfo().getSampleRate();
+    if (frameIndexRange.empty() ||
+            frameIndexRange.length() > kMaxSampleDurationSeconds * sampleRate) {
+        return nullptr;
+    }
+    {
+        const auto locker = lockMutex(&s_mutex);
+        auto pSample = lookupSample(location, pAudioSource);
+        if (pSample) {
+            return pSample;
+        }
+    }
+
+    // Decode without holding the lock, samplers that load other files
+    // must not wait. The same file might be decoded twice concurrently,
+    // which is rare and only costs time.
+    auto pSample = std::make_shared<ResidentSample>(frameIndexRange);
+    const auto writableSampleFrames = mixxx::WritableSampleFrames(
+            frameIndexRange,
+            mixxx::SampleBuffer::WritableSlice(pSample->m_sampleBuffer));
+    mixxx::ReadableSampleFrames readableSampleFrames;
+    if (pAudioSource->getSignalInfo().getChannelCount() !=
+            mixxx::audio::ChannelCount::stereo()) {
+        VERIFY_OR_DEBUG_ASSERT(pAudioSource->getSignalInfo().getChannelCount() <
+                mixxx::audio::ChannelCount::stereo()) {
+            // Multi-channel files are not supported by samplers
+            return nullptr;
+        }
+        mixxx::AudioSourceStereoProxy audioSourceProxy(
+                pAudioSource,
+                frameIndexRange.length());
+        readableSampleFrames = audioSourceProxy.readSampleFrames(writableSampleFrames);
+    } else {
+        readableSampleFrames = pAudioSource->readSampleFrames(writableSampleFrames);
+    }
+    if (readableSampleFrames.frameIndexRange() != frameIndexRange) {
+        // Fall back to the chunk cache of the CachingReader, which handles
+        // partially readable files
+        kLogger.warning()
+                << "Failed to decode"
+                << location
+                << "entirely: expected =" << frameIndexRange
+                << ", actual =" << readableSampleFrames.frameIndexRange();
+        return nullptr;
+    }
+
+    const auto locker = lockMutex(&s_mutex);
+    auto pConcurrentSample = lookupSample(location, pAudioSource);
+    if (pConcurrentSample) {
+        return pConcurrentSample;
+    }
+    // Purge the entries of released samples
+    for (auto it = s_entries.begin(); it != s_entries.end();) {
+        if (it->pSample.expired()) {
+            it = s_entries.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    s_entries.insert(location, PoolEntry{pSample, sampleRate});
+    return pSample;
+}
+
+// static
+int ResidentSamplePool::sampleCount() {
+    const auto locker = lockMutex(&s_mutex);
+    int count = 0;
+    for (const auto& entry : std::as_const(s_entries)) {
+        if (!entry.pSample.expired()) {
+            ++count;
+        }
+    }
+    return count;
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <QString>
+#include <memory>
+
+#include "audio/types.h"
+#include "sources/audiosource.h"
+#include "util/indexrange.h"
+#include "util/samplebuffer.h"
+
+/// The stereo sample data of a short track that has been decoded entirely,
+/// see ResidentSamplePool.
+class ResidentSample {
+  public:
+    explicit ResidentSample(mixxx::IndexRange frameIndexRange);
+
+    const mixxx::IndexRange& frameIndexRange() const {
+        return m_frameIndexRange;
+    }
+
+    /// Copies the intersection of the frame index range with the sample into
+    /// the buffer, with the same semantics as the read functions of
+    /// CachingReaderChunk. Returns the copied frame index range.
+    mixxx::IndexRange readSampleFrames(
+            CSAMPLE* sampleBuffer,
+            mixxx::audio::ChannelCount channelCount,
+            const mixxx::IndexRange& frameIndexRange) const;
+    mixxx::IndexRange readSampleFramesReverse(
+            CSAMPLE* reverseSampleBuffer,
+            mixxx::audio::ChannelCount channelCount,
+            const mixxx::IndexRange& frameIndexRange) const;
+
+  private:
+    friend class ResidentSamplePool;
+
+    const mixxx::IndexRange m_frameIndexRange;
+    mixxx::SampleBuffer m_sampleBuffer;
+};
+
+/// Keeps short tracks fully decoded in memory for the samplers in
+/// short-sample mode. The samples are shared by all samplers that have
+/// loaded the same file, e.g. the same one-shot in several sampler banks,
+/// and are released together with the last reference.
+///
+/// Playing a resident sample never misses a cache, so triggering it has the
+/// latency of a single engine callback. The memory of a sampler is bounded
+/// by the length of its sample instead of the size of a chunk cache.
+///
+/// All functions are thread-safe. Samples must only be acquired and released
+/// outside of the engine thread, because decoding and freeing them is not
+/// real-time safe.
+class ResidentSamplePool {
+  public:
+    /// Tracks that are longer are not kept resident
+    static constexpr double kMaxSampleDurationSeconds = 30.0;
+
+    /// Returns the resident sample of the file, decodes the audio source
+    /// if it has not been decoded before. Returns nullptr if the track is too
+    /// long or decoding fails.
+    static std::shared_ptr<const ResidentSample> acquire(
+            const QString& location,
+            const mixxx::AudioSourcePointer& pAudioSource);
+
+    /// The number of resident samples that are currently in use
+    static int sampleCount();
+};
@@ -3,6 +3,7 @@
 #include "engine/effects/engineeffectsmanager.h"
 #include "util/sample.h"
 #include "util/timer.h"
+#include "util/tracerecorder.h"
 
 // static
 void ChannelMixer::applyEffectsAndMixChannels(const EngineMixer::GainCalculator& gainCalculator,
@@ -24,6 +25,7 @@ void ChannelMixer::applyEffectsAndMixChannels(const EngineMixer::GainCalculator&
     // The original channel input buffers are not modified.
     SampleUtil::clear(pOutput, bufferSize);
     ScopedTimer t(QStringLiteral("EngineMixer::applyEffectsAndMixChannels"));
+    mixxx::ScopedTraceSpan traceSpan("ChannelMixer::applyEffectsAndMixChannels");
     for (auto* pChannelInfo : activeChannels) {
         EngineMixer::GainCache& gainCache = (*channelGainCache)[pChannelInfo->m_index];
         CSAMPLE_GAIN oldGain = gainCache.m_gain;
@@ -69,6 +71,7 @@ void ChannelMixer::applyEffectsInPlaceAndMixChannels(
     //    B) Applies effects to the buffer, modifying the original input buffer
     // 4. Mix the channel buffers together to make pOutput, overwriting the pOutput buffer from the last engine callback
     ScopedTimer t(QStringLiteral("EngineMixer::applyEffectsInPlaceAndMixChannels"));
+    mixxx::ScopedTraceSpan traceSpan("ChannelMixer::applyEffectsInPlaceAndMixChannels");
     SampleUtil::clear(pOutput, bufferSize);
     for (auto* pChannelInfo : activeChannels) {
         EngineMixer::GainCache& gainCache = (*channelGainCache)[pChannelInfo->m_index];
@@ -1,5 +1,7 @@
 #include "engine/channels/enginedeck.h"
 
+#include <algorithm>
+
 #include "control/controlpushbutton.h"
 #include "effects/effectsmanager.h"
 #include "engine/controls/bpmcontrol.h"
@@ -11,6 +13,7 @@
 #include "moc_enginedeck.cpp"
 #include "track/track.h"
 #include "util/assert.h"
+#include "util/defs.h"
 #include "util/sample.h"
 
 #ifdef __STEM__
@@ -30,7 +33,8 @@ EngineDeck::EngineDeck(
         EngineMixer* pMixingEngine,
         EffectsManager* pEffectsManager,
         EngineChannel::ChannelOrientation defaultOrientation,
-        bool primaryDeck)
+        bool primaryDeck,
+        bool residentSamples)
         : EngineChannel(handleGroup, defaultOrientation, pEffectsManager,
                   /*isTalkoverChannel*/ false,
                   primaryDeck),
@@ -56,12 +60,11 @@ EngineDeck::EngineDeck(
             pMixingEngine,
 #ifdef __STEM__
             primaryDeck ? mixxx::audio::ChannelCount::stem()
-                        : mixxx::audio::ChannelCount::stereo()
-
+                        : mixxx::audio::ChannelCount::stereo(),
 #else
-            mixxx::audio::ChannelCount::stereo()
+            mixxx::audio::ChannelCount::stereo(),
 #endif
-    );
+            residentSamples);
 
 #ifdef __STEM__
     if (!primaryDeck) {
@@ -70,6 +73,8 @@ EngineDeck::EngineDeck(
 
     connect(m_pBuffer, &EngineBuffer::trackLoaded, this, &EngineDeck::slotTrackLoaded);
 
+    m_stemEffectBuffer = mixxx::SampleBuffer(kMaxEngineSamples);
+
     m_pStemCount = std::make_unique<ControlObject>(ConfigKey(getGroup(), "stem_count"));
     m_pStemCount->setReadOnly();
 
@@ -124,6 +129,7 @@ EngineDeck::~EngineDeck() {
 void EngineDeck::addStemHandle(const ChannelHandleAndGroup& stemHandleGroup) {
     m_stems.emplace_back(ChannelHandleAndGroup(stemHandleGroup.handle(), stemHandleGroup.name()));
     m_stemsGainCache.push_back(CSAMPLE_GAIN_ONE);
+    m_stemsGain.push_back(CSAMPLE_GAIN_ONE);
     if (m_pEffectsManager != nullptr) {
         m_pEffectsManager->registerInputChannel(stemHandleGroup);
     }
@@ -157,50 +163,62 @@ void EngineDeck::processStem(CSAMPLE* pOut, const std::size_t bufferSize) {
         return;
     }
 
-    // We will now mix each stem (stereo channel) into a single "output"
-    // stereo channel. In order to mix the steam, we will use the engine
-    // effect manager so we can also apply the individual stem quick FX
-    GroupFeatureState featureState;
-    collectFeatures(&featureState);
-    for (std::size_t stemIdx = 0; stemIdx < stemCount;
-            stemIdx++) {
-        int chOffset = stemIdx * mixxx::audio::ChannelCount::stereo();
-        float stemGain = m_stemMute[stemIdx]->toBool()
+    // Only the stems that are routed through an effect chain need to be
+    // extracted and processed on their own. All other stems are mixed
+    // together with their gain in a single pass over the stem buffer.
+    const ChannelHandle mainHandle = m_pEffectsManager->getMainHandle();
+    int effectStemMask = 0;
+    for (std::size_t stemIdx = 0; stemIdx < stemCount; stemIdx++) {
+        m_stemsGain[stemIdx] = m_stemMute[stemIdx]->toBool()
                 ? 0.0f
                 : static_cast<float>(m_stemGain[stemIdx]->get());
-        // Extract the stem frames into the output buffer (LR......LR...... -> LRLR)
-        SampleUtil::copyOneStereoFromMulti(
-                pOut,
-                pIn,
-                numFrames,
-                chCount,
-                chOffset);
-        // Mix the stem frames with the right gain after proceeding its effect.
-        pEngineEffectsManager->processPostFaderInPlace(m_stems[stemIdx].handle(),
-                m_pEffectsManager->getMainHandle(),
-                pOut,
-                bufferSize,
-                sampleRate,
-                featureState,
-                m_stemsGainCache[stemIdx],
-                stemGain,
-                false);
-        // We cache the current gain so we can use it to fade the frame on
-        // next iteration. Without this, (e.g using a static "previous"
-        // gain) gain changes will yield to audio cracks.
-        m_stemsGainCache[stemIdx] = stemGain;
-
-        // Put back the stem frames into the steam buffer (LRLR -> LR......LR......)
-        SampleUtil::insertStereoToMulti(
-                pIn,
-                pOut,
-                numFrames,
-                chCount,
-                chOffset);
+        if (pEngineEffectsManager->isPostFaderEnabledForChannel(
+                    m_stems[stemIdx].handle(), mainHandle)) {
+            effectStemMask |= 1 << stemIdx;
+        }
+    }
+
+    SampleUtil::mixMultichannelToStereoWithRampingGain(pOut,
+            pIn,
+            m_stemsGainCache.data(),
+            m_stemsGain.data(),
+            numFrames,
+            chCount,
+            effectStemMask);
+
+    if (effectStemMask) {
+        GroupFeatureState featureState;
+        collectFeatures(&featureState);
+        CSAMPLE* pStemOut = m_stemEffectBuffer.data();
+        for (std::size_t stemIdx = 0; stemIdx < stemCount; stemIdx++) {
+            if (!(effectStemMask >> stemIdx & 0b1)) {
+                continue;
+            }
+            // Extract the stem frames (LR......LR...... -> LRLR)
+            SampleUtil::copyOneStereoFromMulti(
+                    pStemOut,
+                    pIn,
+                    numFrames,
+                    chCount,
+                    stemIdx * mixxx::audio::ChannelCount::stereo());
+            // Apply the gain and the stem quick FX before mixing it in
+            pEngineEffectsManager->processPostFaderInPlace(m_stems[stemIdx].handle(),
+                    mainHandle,
+                    pStemOut,
+                    bufferSize,
+                    sampleRate,
+                    featureState,
+                    m_stemsGainCache[stemIdx],
+                    m_stemsGain[stemIdx],
+                    false);
+            SampleUtil::add(pOut, pStemOut, bufferSize);
+        }
     }
 
-    // Mixxx all the stem tracks together
-    SampleUtil::mixMultichannelToStereo(pOut, pIn, numFrames, chCount);
+    // We cache the current gains so we can use them to fade the frames on
+    // next iteration. Without this, (e.g using a static "previous"
+    // gain) gain changes will yield to audio cracks.
+    std::copy(m_stemsGain.cbegin(), m_stemsGain.cend(), m_stemsGainCache.begin());
 }
 
 void EngineDeck::cloneStemState(const EngineDeck* deckToClone) {
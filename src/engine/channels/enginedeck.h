@@ -23,7 +23,8 @@ class EngineDeck : public EngineChannel, public AudioDestination {
             EngineMixer* pMixingEngine,
             EffectsManager* pEffectsManager,
             EngineChannel::ChannelOrientation defaultOrientation,
-            bool primaryDeck);
+            bool primaryDeck,
+            bool residentSamples = false);
     ~EngineDeck() override;
 
     void process(CSAMPLE* pOutput, const std::size_t bufferSize) override;
@@ -91,6 +92,8 @@ class EngineDeck : public EngineChannel, public AudioDestination {
 
     std::vector<ChannelHandleAndGroup> m_stems;
     std::vector<CSAMPLE_GAIN> m_stemsGainCache;
+    // The gains of the current callback, preallocated next to the cache
+    std::vector<CSAMPLE_GAIN> m_stemsGain;
 
     UserSettingsPointer m_pConfig;
     EngineBuffer* m_pBuffer;
@@ -99,6 +102,8 @@ class EngineDeck : public EngineChannel, public AudioDestination {
 #ifdef __STEM__
     // Stem buffer used to retrieve all the channel to mix together
     mixxx::SampleBuffer m_stemBuffer;
+    // Stereo buffer for the stems that are processed by effects
+    mixxx::SampleBuffer m_stemEffectBuffer;
     std::unique_ptr<ControlObject> m_pStemCount;
     std::vector<std::unique_ptr<ControlPotmeter>> m_stemGain;
     std::vector<std::unique_ptr<ControlPushButton>> m_stemMute;
@@ -1,5 +1,8 @@
 #include "engine/controls/cuecontrol.h"
 
+#include <QVarLengthArray>
+#include <algorithm>
+
 #include "control/controlindicator.h"
 #include "control/controlobject.h"
 #include "control/controlpushbutton.h"
@@ -70,19 +73,23 @@ inline int hotcueNumberToHotcueIndex(int hotcueNumber) {
 
 void appendCueHint(gsl::not_null<HintVector*> pHintList,
         const mixxx::audio::FramePos& frame,
-        Hint::Type type) {
+        Hint::Type type,
+        SINT frameCount = Hint::kFrameCountForward) {
     if (frame.isValid()) {
         const Hint cueHint = {
                 /*.frame =*/static_cast<SINT>(frame.toLowerFrameBoundary().value()),
-                /*.frameCount =*/Hint::kFrameCountForward,
+                /*.frameCount =*/frameCount,
                 /*.type =*/type};
         pHintList->append(cueHint);
     }
 }
 
-void appendCueHint(gsl::not_null<HintVector*> pHintList, const double playPos, Hint::Type type) {
+void appendCueHint(gsl::not_null<HintVector*> pHintList,
+        const double playPos,
+        Hint::Type type,
+        SINT frameCount = Hint::kFrameCountForward) {
     const auto frame = mixxx::audio::FramePos::fromEngineSamplePosMaybeInvalid(playPos);
-    appendCueHint(pHintList, frame, type);
+    appendCueHint(pHintList, frame, type, frameCount);
 }
 
 } // namespace
@@ -978,6 +985,7 @@ void CueControl::hotcueGoto(HotcueControl* pControl, double value) {
     if (value <= 0) {
         return;
     }
+    markHotcueUsed(pControl);
     const mixxx::audio::FramePos position = pControl->getPosition();
     if (position.isValid()) {
         seekAbs(position);
@@ -988,6 +996,7 @@ void CueControl::hotcueGotoAndStop(HotcueControl* pControl, double value) {
     if (value <= 0) {
         return;
     }
+    markHotcueUsed(pControl);
 
     const mixxx::audio::FramePos position = pControl->getPosition();
     if (!position.isValid()) {
@@ -1007,6 +1016,7 @@ void CueControl::hotcueGotoAndPlay(HotcueControl* pControl, double value) {
     if (value <= 0) {
         return;
     }
+    markHotcueUsed(pControl);
     const mixxx::audio::FramePos position = pControl->getPosition();
     if (position.isValid()) {
         seekAbs(position);
@@ -1027,6 +1037,7 @@ void CueControl::hotcueGotoAndLoop(HotcueControl* pControl, double value) {
     if (value == 0) {
         return;
     }
+    markHotcueUsed(pControl);
     CuePointer pCue = pControl->getCue();
     if (!pCue) {
         return;
@@ -1063,6 +1074,7 @@ void CueControl::hotcueCueLoop(HotcueControl* pControl, double value) {
     if (value == 0) {
         return;
     }
+    markHotcueUsed(pControl);
 
     CuePointer pCue = pControl->getCue();
 
@@ -1115,6 +1127,7 @@ void CueControl::hotcueActivate(HotcueControl* pControl, double value, HotcueSet
         // pressed
         if (pCue && pCue->getPosition().isValid() &&
                 pCue->getType() != mixxx::CueType::Invalid) {
+            markHotcueUsed(pControl);
             if (m_pPlay->toBool() && m_currentlyPreviewingIndex == Cue::kNoHotCue) {
                 // playing by Play button
                 switch (pCue->getType()) {
@@ -1275,13 +1288,37 @@ void CueControl::hotcueEndPositionChanged(
 }
 
 void CueControl::hintReader(gsl::not_null<HintVector*> pHintList) {
-    appendCueHint(pHintList, m_pCuePoint->get(), Hint::Type::MainCue);
+    // The cue points are likely seek targets, so the chunks following them
+    // are decoded speculatively
+    appendCueHint(pHintList,
+            m_pCuePoint->get(),
+            Hint::Type::MainCue,
+            Hint::kFrameCountSpeculative);
 
     // this is called from the engine thread
     // it is no locking required, because m_hotcueControl is filled during the
     // constructor and getPosition()->get() is a ControlObject
+    QVarLengthArray<HotcueControl*, NUM_HOT_CUES> hotcueControls;
     for (const auto& pControl : std::as_const(m_hotcueControls)) {
-        appendCueHint(pHintList, pControl->getPosition(), Hint::Type::HotCue);
+        hotcueControls.append(pControl);
+    }
+    // Hint the most recently used hotcues first, the reader decodes them in
+    // this order and drops the least recent ones when exceeding its budget
+    std::sort(hotcueControls.begin(),
+            hotcueControls.end(),
+            [](const HotcueControl* pLhs, const HotcueControl* pRhs) {
+                const int lhsLastUsed = pLhs->getLastUsed();
+                const int rhsLastUsed = pRhs->getLastUsed();
+                if (lhsLastUsed != rhsLastUsed) {
+                    return lhsLastUsed > rhsLastUsed;
+                }
+                return pLhs->getHotcueIndex() < pRhs->getHotcueIndex();
+            });
+    for (const auto& pControl : std::as_const(hotcueControls)) {
+        appendCueHint(pHintList,
+                pControl->getPosition(),
+                Hint::Type::HotCue,
+                Hint::kFrameCountSpeculative);
     }
 
     appendCueHint(pHintList, m_n60dBSoundStartPosition.getValue(), Hint::Type::FirstSound);
@@ -2430,6 +2467,10 @@ void CueControl::slotLoopUpdated(mixxx::audio::FramePos startPosition,
     DEBUG_ASSERT(pSavedLoopControl->getStatus() == HotcueControl::Status::Active);
 }
 
+void CueControl::markHotcueUsed(HotcueControl* pControl) {
+    pControl->setLastUsed(m_hotcueUseCount.fetchAndAddRelaxed(1) + 1);
+}
+
 void CueControl::setHotcueFocusIndex(int hotcueIndex) {
     m_pHotcueFocus->set(hotcueIndexToHotcueNumber(hotcueIndex));
 }
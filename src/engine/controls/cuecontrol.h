@@ -11,6 +11,7 @@
 #include "preferences/usersettings.h"
 #include "track/cue.h"
 #include "track/track_decl.h"
+#include "util/compatibility/qatomic.h"
 #include "util/compatibility/qmutex.h"
 #include "util/parented_ptr.h"
 
@@ -99,6 +100,15 @@ class HotcueControl : public QObject {
     void setColor(mixxx::RgbColor::optional_t newColor);
     mixxx::RgbColor::optional_t getColor() const;
 
+    /// Stamp of the last use of this hotcue for jumping, used for hinting
+    /// the most recently used hotcues first.
+    int getLastUsed() const {
+        return atomicLoadRelaxed(m_lastUsed);
+    }
+    void setLastUsed(int lastUsed) {
+        m_lastUsed.storeRelease(lastUsed);
+    }
+
     /// Used for caching the preview state of this hotcue control
     /// for the case the cue is deleted during preview.
     mixxx::CueType getPreviewingType() const {
@@ -184,6 +194,8 @@ class HotcueControl : public QObject {
 
     ControlValueAtomic<mixxx::CueType> m_previewingType;
     ControlValueAtomic<mixxx::audio::FramePos> m_previewingPosition;
+
+    QAtomicInt m_lastUsed;
 };
 
 class CueControl : public EngineControl {
@@ -286,11 +298,14 @@ class CueControl : public EngineControl {
     void seekOnLoad(mixxx::audio::FramePos seekOnLoadPosition);
     void setHotcueFocusIndex(int hotcueIndex);
     int getHotcueFocusIndex() const;
+    void markHotcueUsed(HotcueControl* pControl);
     mixxx::RgbColor colorFromConfig(const ConfigKey& configKey);
 
     UserSettingsPointer m_pConfig;
     ColorPaletteSettings m_colorPaletteSettings;
     QAtomicInt m_currentlyPreviewingIndex;
+    // Incremented whenever a hotcue is used for jumping
+    QAtomicInt m_hotcueUseCount;
     ControlObject* m_pPlay;
     ControlObject* m_pStopButton;
     ControlObject* m_pQuantizeEnabled;
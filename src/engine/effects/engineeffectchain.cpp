@@ -171,6 +171,21 @@ bool EngineEffectChain::disableForInputChannel(ChannelHandle inputHandle) {
     return true;
 }
 
+bool EngineEffectChain::isEnabledForChannel(const ChannelHandle& inputHandle,
+        const ChannelHandle& outputHandle) const {
+    // The matrix is only extended on the audio thread, a missing entry
+    // means that the chain has never been enabled for the channel.
+    if (!inputHandle.valid() ||
+            inputHandle.handle() >= m_chainStatusForChannelMatrix.size()) {
+        return false;
+    }
+    const auto& outputMap = m_chainStatusForChannelMatrix.at(inputHandle);
+    if (!outputHandle.valid() || outputHandle.handle() >= outputMap.size()) {
+        return false;
+    }
+    return outputMap.at(outputHandle).enableState != EffectEnableState::Disabled;
+}
+
 bool EngineEffectChain::process(const ChannelHandle& inputHandle,
         const ChannelHandle& outputHandle,
         CSAMPLE* pIn,
@@ -45,6 +45,12 @@ class EngineEffectChain final : public EffectsRequestHandler {
             const GroupFeatureState& groupFeatures,
             bool fadeout);
 
+    /// Returns false if process() would leave the channel untouched,
+    /// because the chain is not enabled for it and no fade out is pending.
+    /// called from audio thread
+    bool isEnabledForChannel(const ChannelHandle& inputHandle,
+            const ChannelHandle& outputHandle) const;
+
   private:
     struct ChannelStatus {
         ChannelStatus()
@@ -5,6 +5,7 @@
 #include "engine/effects/engineeffectchain.h"
 #include "util/defs.h"
 #include "util/sample.h"
+#include "util/tracerecorder.h"
 
 EngineEffectsManager::EngineEffectsManager(EffectsResponsePipe&& responsePipe)
         : m_responsePipe(std::move(responsePipe)),
@@ -157,6 +158,21 @@ void EngineEffectsManager::processPostFaderAndMix(
             fadeout);
 }
 
+bool EngineEffectsManager::isPostFaderEnabledForChannel(
+        const ChannelHandle& inputHandle,
+        const ChannelHandle& outputHandle) const {
+    const auto it = m_chainsByStage.constFind(SignalProcessingStage::Postfader);
+    if (it == m_chainsByStage.constEnd()) {
+        return false;
+    }
+    for (const EngineEffectChain* pChain : it.value()) {
+        if (pChain && pChain->isEnabledForChannel(inputHandle, outputHandle)) {
+            return true;
+        }
+    }
+    return false;
+}
+
 void EngineEffectsManager::processInner(
         const SignalProcessingStage stage,
         const ChannelHandle& inputHandle,
@@ -169,6 +185,7 @@ void EngineEffectsManager::processInner(
         CSAMPLE_GAIN oldGain,
         CSAMPLE_GAIN newGain,
         bool fadeout) {
+    mixxx::ScopedTraceSpan traceSpan("EngineEffectsManager::process");
     const QList<EngineEffectChain*>& chains = m_chainsByStage.value(stage);
 
     if (pIn == pOut) {
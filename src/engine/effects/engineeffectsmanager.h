@@ -65,6 +65,13 @@ class EngineEffectsManager final : public EffectsRequestHandler {
             CSAMPLE_GAIN newGain = CSAMPLE_GAIN_ONE,
             bool fadeout = false);
 
+    /// Returns true if any postfader EngineEffectChain processes the channel.
+    /// Otherwise processPostFaderInPlace() only applies the gain and the
+    /// caller may take a faster path.
+    bool isPostFaderEnabledForChannel(
+            const ChannelHandle& inputHandle,
+            const ChannelHandle& outputHandle) const;
+
     bool processEffectsRequest(
             EffectsRequest& message,
             EffectsResponsePipe* pResponsePipe) override;
@@ -31,6 +31,7 @@
 #include "util/logger.h"
 #include "util/sample.h"
 #include "util/timer.h"
+#include "util/tracerecorder.h"
 #include "waveform/visualplayposition.h"
 
 #ifdef __RUBBERBAND__
@@ -58,7 +59,8 @@ EngineBuffer::EngineBuffer(const QString& group,
         UserSettingsPointer pConfig,
         EngineChannel* pChannel,
         EngineMixer* pMixingEngine,
-        mixxx::audio::ChannelCount maxSupportedChannel)
+        mixxx::audio::ChannelCount maxSupportedChannel,
+        bool residentSamples)
         : m_group(group),
           m_pConfig(pConfig),
           m_pLoopingControl(nullptr),
@@ -104,7 +106,12 @@ EngineBuffer::EngineBuffer(const QString& group,
     // zero out crossfade buffer
     SampleUtil::clear(m_pCrossfadeBuffer, kMaxEngineFrames * mixxx::kMaxEngineChannelInputCount);
 
-    m_pReader = new CachingReader(group, pConfig, maxSupportedChannel);
+    m_pReader = new CachingReader(group,
+            pConfig,
+            maxSupportedChannel,
+            residentSamples ? CachingReader::kResidentSamplesNumberOfCachedChunks
+                            : CachingReader::kDefaultNumberOfCachedChunks,
+            residentSamples);
     connect(m_pReader, &CachingReader::trackLoading,
             this, &EngineBuffer::slotTrackLoading,
             Qt::DirectConnection);
@@ -1095,7 +1102,10 @@ void EngineBuffer::processTrackLocked(
     // If the buffer is not paused, then scale the audio.
     if (!bCurBufferPaused) {
         // Perform scaling of Reader buffer into buffer.
-        const double framesRead = m_pScale->scaleBuffer(pOutput, bufferSize);
+        const double framesRead = [&] {
+            mixxx::ScopedTraceSpan traceSpan("EngineBufferScale::scaleBuffer");
+            return m_pScale->scaleBuffer(pOutput, bufferSize);
+        }();
 
         // TODO(XXX): The result framesRead might not be an integer value.
         // Converting to samples here does not make sense. All positional
@@ -1183,6 +1193,7 @@ void EngineBuffer::process(CSAMPLE* pOutput, const std::size_t bufferSize) {
     VERIFY_OR_DEBUG_ASSERT((bufferSize % m_channelCount) == 0) {
         return;
     }
+    mixxx::ScopedTraceSpan traceSpan("EngineBuffer::process");
     m_pReader->process();
     // Steps:
     // - Lookup new reader information
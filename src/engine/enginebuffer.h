@@ -103,7 +103,8 @@ class EngineBuffer : public EngineObject {
             UserSettingsPointer pConfig,
             EngineChannel* pChannel,
             EngineMixer* pMixingEngine,
-            mixxx::audio::ChannelCount maxSupportedChannel);
+            mixxx::audio::ChannelCount maxSupportedChannel,
+            bool residentSamples = false);
     virtual ~EngineBuffer();
 
     void bindWorkers(EngineWorkerScheduler* pWorkerScheduler);
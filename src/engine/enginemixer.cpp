@@ -27,6 +27,7 @@
 #include "util/parented_ptr.h"
 #include "util/sample.h"
 #include "util/samplebuffer.h"
+#include "util/tracerecorder.h"
 
 namespace {
 const QString kAppGroup = QStringLiteral("[App]");
@@ -240,7 +241,7 @@ void EngineMixer::processChannels(std::size_t bufferSize) {
     m_activeTalkoverChannels.clear();
     m_activeChannels.clear();
 
-    // ScopedTimer timer(QStringLiteral("EngineMixer::processChannels"));
+    mixxx::ScopedTraceSpan traceSpan("EngineMixer::processChannels");
     EngineChannel* pLeaderChannel = m_pEngineSync->getLeaderChannel();
     // Reserve the first place for the main channel which
     // should be processed first
@@ -366,6 +367,7 @@ void EngineMixer::process(const std::size_t bufferSize) {
         haveSetName = true;
     }
     // Trace t("EngineMixer::process");
+    mixxx::ScopedTraceSpan traceSpan("EngineMixer::process");
 
     bool mainEnabled = m_pMainEnabled->toBool();
     bool boothEnabled = m_pBoothEnabled->toBool();
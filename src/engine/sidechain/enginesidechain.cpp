@@ -1,65 +1,186 @@
 // This class provides a way to do audio processing that does not need
 // to be executed in real-time. For example, broadcast encoding
-// and recording encoding can be done here. This class uses double-buffering
-// to increase the amount of time the CPU has to do whatever work needs to
-// be done, and that work is executed in a separate thread. (Threading
-// allows the next buffer to be filled while processing a buffer that's is
-// already full.)
+// and recording encoding can be done here. The engine writes into a FIFO
+// per worker that is large enough to give the worker plenty of time for
+// whatever work needs to be done. Each worker is executed in a separate
+// thread and reads from its FIFO in place, i.e. the engine can continue
+// filling the FIFOs while the workers are processing and a slow worker
+// doesn't stall the others.
 
 #include "engine/sidechain/enginesidechain.h"
 
+#include <QThread>
 #include <QtDebug>
+#include <algorithm>
 
 #include "engine/engine.h"
 #include "engine/sidechain/sidechainworker.h"
 #include "moc_enginesidechain.cpp"
+#include "util/assert.h"
 #include "util/counter.h"
 #include "util/event.h"
+#include "util/fifo.h"
 #include "util/sample.h"
+#include "util/spinparkevent.h"
 #include "util/trace.h"
 
-#define SIDECHAIN_BUFFER_SIZE 65536
+class SideChainWorkerThread : public QThread {
+  public:
+    SideChainWorkerThread(
+            const std::atomic<bool>* pStop,
+            SideChainWorker* pWorker,
+            int slot)
+            : m_pStop(pStop),
+              m_pWorker(pWorker),
+              m_slot(slot),
+              m_sampleFifo(EngineSideChain::SIDECHAIN_BUFFER_SIZE),
+              m_droppedSamples(0) {
+    }
+
+    SideChainWorker* worker() const {
+        return m_pWorker;
+    }
+
+    quint64 droppedSamples() const {
+        return m_droppedSamples.load(std::memory_order_relaxed);
+    }
+
+    // Called by the engine thread. Wait-free. The samples that don't fit
+    // into the FIFO are dropped and only missed by this worker.
+    void writeSamples(const CSAMPLE* pBuffer, int numSamples) {
+        const int writeAvailable = m_sampleFifo.writeAvailable();
+        // Only write whole frames
+        const int numSamplesWritten = std::min(numSamples,
+                writeAvailable - writeAvailable % mixxx::kEngineChannelOutputCount);
+        if (numSamplesWritten > 0) {
+            m_sampleFifo.write(pBuffer, numSamplesWritten);
+        }
+        if (numSamplesWritten != numSamples) {
+            m_droppedSamples.fetch_add(numSamples - numSamplesWritten,
+                    std::memory_order_relaxed);
+            Counter("EngineSideChain::writeSamples buffer overrun").increment();
+        }
+        if (writeAvailable - numSamplesWritten < EngineSideChain::SIDECHAIN_BUFFER_SIZE / 5) {
+            // Signal to the worker that samples are available.
+            Trace wakeup("EngineSideChain::writeSamples wake up");
+            m_samplesAvailable.set();
+        }
+    }
+
+    // Wakes up the thread, e.g. to check m_pStop
+    void wake() {
+        m_samplesAvailable.set();
+    }
+
+  private:
+    void run() override {
+        QThread::currentThread()->setObjectName(
+                QString("EngineSideChain %1").arg(m_slot + 1));
+        static const QString tag("EngineSideChain");
+
+        Event::start(tag);
+        while (true) {
+            Event::end(tag);
+            // A wake up is never lost, even if the engine has set the
+            // event before this thread waits for it
+            m_samplesAvailable.wait();
+            if (m_pStop->load(std::memory_order_acquire)) {
+                return;
+            }
+            Event::start(tag);
+
+            CSAMPLE* pData1;
+            ring_buffer_size_t size1;
+            CSAMPLE* pData2;
+            ring_buffer_size_t size2;
+            int readAvailable;
+            while ((readAvailable = m_sampleFifo.aquireReadRegions(
+                            m_sampleFifo.readAvailable(),
+                            &pData1,
+                            &size1,
+                            &pData2,
+                            &size2)) > 0) {
+                // Process the contiguous region up to the end of the
+                // FIFO and the wrapped-around remainder separately
+                Trace process("EngineSideChain::process");
+                m_pWorker->process(pData1, size1);
+                if (size2 > 0) {
+                    m_pWorker->process(pData2, size2);
+                }
+                // Hand the regions back to the engine thread
+                m_sampleFifo.releaseReadRegions(readAvailable);
+            }
+        }
+    }
+
+    const std::atomic<bool>* const m_pStop;
+    SideChainWorker* const m_pWorker;
+    const int m_slot;
+
+    FIFO<CSAMPLE> m_sampleFifo;
+    std::atomic<quint64> m_droppedSamples;
+    SpinParkEvent m_samplesAvailable;
+};
 
 EngineSideChain::EngineSideChain(
         UserSettingsPointer pConfig,
         CSAMPLE* sidechainMix)
         : m_pConfig(pConfig),
-          m_bStopThread(false),
-          m_sampleFifo(SIDECHAIN_BUFFER_SIZE),
-          m_pWorkBuffer(SampleUtil::alloc(SIDECHAIN_BUFFER_SIZE)),
-          m_pSidechainMix(sidechainMix) {
-    // We use HighPriority to prevent starvation by lower-priority processes (Qt
-    // main thread, analysis, etc.). This used to be LowPriority but that is not
-    // a suitable choice since we do semi-realtime tasks
-    // in the sidechain thread. To get reliable timing, it's important
-    // that this work be prioritized over the GUI and non-realtime tasks. See
-    // discussion on issue #7272 and https://bugs.launchpad.net/mixxx/1.11/+bug/1194543.
-    start(QThread::HighPriority);
+          m_bStopThreads(false),
+          m_pSidechainMix(sidechainMix),
+          m_workerCount(0) {
 }
 
 EngineSideChain::~EngineSideChain() {
-    m_waitLock.lock();
-    m_bStopThread = true;
-    m_waitForSamples.wakeAll();
-    m_waitLock.unlock();
-
-    // Wait until the thread has finished.
-    wait();
+    m_bStopThreads.store(true, std::memory_order_release);
 
     MMutexLocker locker(&m_workerLock);
-    while (!m_workers.empty()) {
-        SideChainWorker* pWorker = m_workers.takeLast();
+    for (auto& pWorkerThread : m_workerThreads) {
+        if (!pWorkerThread) {
+            continue;
+        }
+        pWorkerThread->wake();
+        // Wait until the thread has finished.
+        pWorkerThread->wait();
+        SideChainWorker* pWorker = pWorkerThread->worker();
         pWorker->shutdown();
         delete pWorker;
+        pWorkerThread.reset();
     }
-    locker.unlock();
-
-    SampleUtil::free(m_pWorkBuffer);
 }
 
 void EngineSideChain::addSideChainWorker(SideChainWorker* pWorker) {
     MMutexLocker locker(&m_workerLock);
-    m_workers.append(pWorker);
+    const int slot = m_workerCount.load(std::memory_order_relaxed);
+    VERIFY_OR_DEBUG_ASSERT(slot < kMaxSideChainWorkers) {
+        qWarning() << "EngineSideChain: Too many workers, ignoring new worker";
+        pWorker->shutdown();
+        delete pWorker;
+        return;
+    }
+
+    m_workerThreads[slot] = std::make_unique<SideChainWorkerThread>(
+            &m_bStopThreads, pWorker, slot);
+    // We use HighPriority to prevent starvation by lower-priority processes (Qt
+    // main thread, analysis, etc.). This used to be LowPriority but that is not
+    // a suitable choice since we do semi-realtime tasks
+    // in the sidechain thread. To get reliable timing, it's important
+    // that this work be prioritized over the GUI and non-realtime tasks. See
+    // discussion on issue #7272 and https://bugs.launchpad.net/mixxx/1.11/+bug/1194543.
+    m_workerThreads[slot]->start(QThread::HighPriority);
+    // The new worker starts with the next samples written by the engine
+    m_workerCount.store(slot + 1, std::memory_order_release);
+}
+
+quint64 EngineSideChain::droppedSamples(const SideChainWorker* pWorker) const {
+    const int workerCount = m_workerCount.load(std::memory_order_acquire);
+    for (int i = 0; i < workerCount; ++i) {
+        if (m_workerThreads[i]->worker() == pWorker) {
+            return m_workerThreads[i]->droppedSamples();
+        }
+    }
+    DEBUG_ASSERT(!"unknown worker");
+    return 0;
 }
 
 void EngineSideChain::receiveBuffer(const AudioInput& input,
@@ -78,48 +199,9 @@ void EngineSideChain::writeSamples(const CSAMPLE* pBuffer, int iFrames) {
     Trace sidechain("EngineSideChain::writeSamples");
     // TODO: remove assumption of stereo buffer
     const int numSamples = iFrames * mixxx::kEngineChannelOutputCount;
-    const int numSamplesWritten = m_sampleFifo.write(pBuffer, numSamples);
-
-    if (numSamplesWritten != numSamples) {
-        Counter("EngineSideChain::writeSamples buffer overrun").increment();
-    }
-
-    if (m_sampleFifo.writeAvailable() < SIDECHAIN_BUFFER_SIZE / 5) {
-        // Signal to the sidechain that samples are available.
-        Trace wakeup("EngineSideChain::writeSamples wake up");
-        m_waitForSamples.wakeAll();
-    }
-}
-
-void EngineSideChain::run() {
-    // the id of this thread, for debugging purposes //XXX copypasta (should
-    // factor this out somehow), -kousu 2/2009
-    unsigned static id = 0;
-    QThread::currentThread()->setObjectName(QString("EngineSideChain %1").arg(++id));
-    static const QString tag("EngineSideChain");
-    Event::start(tag);
-    while (!m_bStopThread) {
-        // Sleep until samples are available.
-        m_waitLock.lock();
-
-        Event::end(tag);
-        m_waitForSamples.wait(&m_waitLock);
-        m_waitLock.unlock();
-        Event::start(tag);
 
-        int samples_read;
-        while ((samples_read = m_sampleFifo.read(m_pWorkBuffer,
-                                                 SIDECHAIN_BUFFER_SIZE))) {
-            Trace process("EngineSideChain::process");
-            MMutexLocker locker(&m_workerLock);
-            foreach (SideChainWorker* pWorker, m_workers) {
-                pWorker->process(m_pWorkBuffer, samples_read);
-            }
-        }
-
-        // Check to see if we're supposed to exit/stop this thread.
-        if (m_bStopThread) {
-            return;
-        }
+    const int workerCount = m_workerCount.load(std::memory_order_acquire);
+    for (int i = 0; i < workerCount; ++i) {
+        m_workerThreads[i]->writeSamples(pBuffer, numSamples);
     }
 }
@@ -1,19 +1,24 @@
 #pragma once
 
-#include <QThread>
-#include <QMutex>
-#include <QWaitCondition>
-#include <QList>
+#include <QObject>
+#include <array>
+#include <atomic>
+#include <memory>
 
 #include "preferences/usersettings.h"
 #include "soundio/soundmanagerutil.h"
-#include "util/fifo.h"
 #include "util/mutex.h"
 #include "util/types.h"
 
 class SideChainWorker;
+class SideChainWorkerThread;
 
-class EngineSideChain : public QThread, public AudioDestination {
+// Distributes the samples written by the engine to all registered
+// SideChainWorkers. Each worker runs on its own thread and has its own
+// sample FIFO, i.e. a slow worker, e.g. a FLAC recording on a slow disk,
+// only drops its own samples and doesn't affect the other workers. The
+// engine thread copies each buffer into the FIFO of every worker.
+class EngineSideChain : public QObject, public AudioDestination {
     Q_OBJECT
   public:
     EngineSideChain(UserSettingsPointer pConfig, CSAMPLE* sidechainMix);
@@ -30,28 +35,32 @@ class EngineSideChain : public QThread, public AudioDestination {
             const CSAMPLE* pBuffer,
             unsigned int iFrames) override;
 
-    // Thread-safe, blocking.
+    // Thread-safe, blocking. Takes ownership of the worker and starts
+    // a dedicated thread for it.
     void addSideChainWorker(SideChainWorker* pWorker);
 
     static constexpr int SIDECHAIN_BUFFER_SIZE = 65536;
+    static constexpr int kMaxSideChainWorkers = 8;
 
   private:
-    void run() override;
+    friend class EngineSideChainTest;
+
+    // Thread-safe. Returns the number of samples that the worker has missed,
+    // because it didn't keep up with the engine.
+    quint64 droppedSamples(const SideChainWorker* pWorker) const;
 
     UserSettingsPointer m_pConfig;
-    // Indicates that the thread should exit.
-    volatile bool m_bStopThread;
+    // Indicates that the worker threads should exit.
+    std::atomic<bool> m_bStopThreads;
 
-    FIFO<CSAMPLE> m_sampleFifo;
-    CSAMPLE* m_pWorkBuffer;
     CSAMPLE* m_pSidechainMix;
 
-    // Provides thread safety around the wait condition below.
-    QMutex m_waitLock;
-    // Allows sleeping until we have samples to process.
-    QWaitCondition m_waitForSamples;
-
-    // Sidechain workers registered with EngineSideChain.
+    // Serializes adding workers and the shutdown
     MMutex m_workerLock;
-    QList<SideChainWorker*> m_workers GUARDED_BY(m_workerLock);
+    // Sidechain workers registered with EngineSideChain. The engine thread
+    // accesses the first m_workerCount slots without locking. Slots are
+    // only added and never removed while the sidechain is running.
+    std::array<std::unique_ptr<SideChainWorkerThread>, kMaxSideChainWorkers>
+            m_workerThreads;
+    std::atomic<int> m_workerCount;
 };
@@ -15,6 +15,10 @@ const QString AnalysisDao::s_analysisTableName = "track_analysis";
 // compression level (-1) takes the size down to about 600KB. The difference
 // between the default and 9 (the max) was only about 1-2KB for a lot of extra
 // CPU time so I think we should stick with the default. rryan 4/3/2012
+//
+// Waveforms are now stored in the packed format that is not compressed,
+// because inflating and parsing the protobuf data took several ms for
+// each loaded track. Only data in other formats is still compressed.
 constexpr int kCompressionLevel = -1;
 
 AnalysisDao::AnalysisDao(UserSettingsPointer pConfig)
@@ -84,21 +88,25 @@ QList<AnalysisDao::AnalysisInfo> AnalysisDao::loadAnalysesFromQuery(TrackId trac
         int checksum = query->value(dataChecksumColumn).toInt();
         QString dataPath = analysisPath.absoluteFilePath(
             QString::number(info.analysisId));
-        const QByteArray compressedData = loadDataFromFile(dataPath);
+        const QByteArray storedData = loadDataFromFile(dataPath);
 #if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
         const int file_checksum = qChecksum(
-                compressedData);
+                storedData);
 #else
         const int file_checksum = qChecksum(
-                compressedData.constData(),
-                compressedData.length());
+                storedData.constData(),
+                storedData.length());
 #endif
         if (checksum != file_checksum) {
             qDebug() << "WARNING: Corrupt analysis loaded from" << dataPath
-                     << "length" << compressedData.length();
+                     << "length" << storedData.length();
             continue;
         }
-        info.data = qUncompress(compressedData);
+        if (Waveform::isPackedByteArray(storedData)) {
+            info.data = storedData;
+        } else {
+            info.data = qUncompress(storedData);
+        }
         bytes += info.data.length();
         analyses.append(info);
     }
@@ -120,7 +128,9 @@ bool AnalysisDao::saveAnalysis(AnalysisDao::AnalysisInfo* info) {
     PerformanceTimer time;
     time.start();
 
-    const QByteArray compressedData = qCompress(info->data, kCompressionLevel);
+    const QByteArray compressedData = Waveform::isPackedByteArray(info->data)
+            ? info->data
+            : qCompress(info->data, kCompressionLevel);
 #if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
     const int checksum = qChecksum(
             compressedData);
@@ -340,7 +350,7 @@ void AnalysisDao::saveTrackAnalyses(
     analysis.type = AnalysisDao::TYPE_WAVEFORM;
     analysis.description = pWaveform->getDescription();
     analysis.version = pWaveform->getVersion();
-    analysis.data = pWaveform->toByteArray();
+    analysis.data = pWaveform->toPackedByteArray();
     bool success = saveAnalysis(&analysis);
     if (success) {
         pWaveform->setSaveState(Waveform::SaveState::Saved);
@@ -350,12 +360,16 @@ void AnalysisDao::saveTrackAnalyses(
                  << "waveform analysis for trackId" << trackId
                  << "analysisId" << analysis.analysisId;
 
-    // Clear analysisId since we are re-using the AnalysisInfo
+    // Reset analysisId since we are re-using the AnalysisInfo. The existing
+    // summary is updated in place, e.g. when migrating a legacy summary.
     analysis.analysisId = -1;
+    if (pWaveSummary->getId() != -1) {
+        analysis.analysisId = pWaveSummary->getId();
+    }
     analysis.type = AnalysisDao::TYPE_WAVESUMMARY;
     analysis.description = pWaveSummary->getDescription();
     analysis.version = pWaveSummary->getVersion();
-    analysis.data = pWaveSummary->toByteArray();
+    analysis.data = pWaveSummary->toPackedByteArray();
 
     success = saveAnalysis(&analysis);
     if (success) {
@@ -833,7 +833,8 @@ TrackId TrackDAO::addTracksAddTrack(const TrackPointer& pTrack, bool unremove) {
 
 TrackPointer TrackDAO::addTracksAddFile(
         const mixxx::FileAccess& fileAccess,
-        bool unremove) {
+        bool unremove,
+        const SoundSourceProxy::PreparedImport* pPreparedImport) {
     // Check that track is a supported extension.
     // TODO(uklotzde): The following check can be skipped if
     // the track is already in the library. A refactoring is
@@ -883,7 +884,8 @@ TrackPointer TrackDAO::addTracksAddFile(
     // from the file.
     SoundSourceProxy(pTrack).updateTrackFromSource(
             SoundSourceProxy::UpdateTrackFromSourceMode::Once,
-            SyncTrackMetadataParams::readFromUserSettings(*m_pConfig));
+            SyncTrackMetadataParams::readFromUserSettings(*m_pConfig),
+            pPreparedImport);
     if (!pTrack->checkSourceSynchronized()) {
         qWarning() << "TrackDAO::addTracksAddFile:"
                 << "Failed to parse track metadata from file"
@@ -9,6 +9,7 @@
 #include "library/dao/dao.h"
 #include "library/relocatedtrack.h"
 #include "preferences/usersettings.h"
+#include "sources/soundsourceproxy.h"
 #include "track/globaltrackcache.h"
 #include "util/class.h"
 
@@ -154,15 +155,20 @@ class TrackDAO : public QObject, public virtual DAO, public virtual GlobalTrackC
     TrackId addTracksAddTrack(
             const TrackPointer& pTrack,
             bool unremove);
+    /// The optional prepared import allows to parse the file in advance,
+    /// i.e. concurrently on a different thread.
     TrackPointer addTracksAddFile(
             const mixxx::FileAccess& fileAccess,
-            bool unremove);
+            bool unremove,
+            const SoundSourceProxy::PreparedImport* pPreparedImport = nullptr);
     TrackPointer addTracksAddFile(
             const QString& filePath,
-            bool unremove) {
+            bool unremove,
+            const SoundSourceProxy::PreparedImport* pPreparedImport = nullptr) {
         return addTracksAddFile(
                 mixxx::FileAccess(mixxx::FileInfo(filePath)),
-                unremove);
+                unremove,
+                pPreparedImport);
     }
     void addTracksFinish(bool rollback = false);
 
@@ -56,6 +56,14 @@ extern const ConfigKey kTagFetcherApplyTagsConfigKey;
 
 extern const ConfigKey kTagFetcherApplyCoverConfigKey;
 
+extern const ConfigKey kDecodedAudioCacheEnabledConfigKey;
+
+const bool kDecodedAudioCacheEnabledDefault = false;
+
+extern const ConfigKey kDecodedAudioCacheSizeMiBConfigKey;
+
+const int kDecodedAudioCacheSizeMiBDefault = 4096;
+
 } // namespace prefs
 
 } // namespace library
@@ -1,6 +1,8 @@
 #include "library/scanner/importfilestask.h"
 
+#include "library/coverartutils.h"
 #include "moc_importfilestask.cpp"
+#include "sources/soundsourceproxy.h"
 #include "util/timer.h"
 
 ImportFilesTask::ImportFilesTask(LibraryScanner* pScanner,
@@ -22,6 +24,8 @@ ImportFilesTask::ImportFilesTask(LibraryScanner* pScanner,
 
 void ImportFilesTask::run() {
     ScopedTimer timer(QStringLiteral("ImportFilesTask::run"));
+    const QList<QFileInfo> possibleCovers(
+            m_possibleCovers.begin(), m_possibleCovers.end());
     for (const QFileInfo& fileInfo: m_filesToImport) {
         // If a flag was raised telling us to cancel the library scan then stop.
         if (m_scannerGlobal->shouldCancel()) {
@@ -49,7 +53,34 @@ void ImportFilesTask::run() {
             }
             qDebug() << "Importing track" << trackLocation;
 
-            emit addNewTrack(trackLocation);
+            // Parse the file and guess its cover art here on the worker
+            // thread. Only the database insert is done by the scanner.
+            auto preparedImport = SoundSourceProxy::prepareImportFromNewFile(
+                    mixxx::FileAccess(mixxx::FileInfo(fileInfo), m_pToken));
+            if (!preparedImport) {
+                // The file is referenced by a cached track object and
+                // must be imported while the cache is locked.
+                emit addNewTrack(trackLocation);
+                continue;
+            }
+            if (preparedImport->result == mixxx::MetadataSource::ImportResult::Succeeded) {
+                const auto album = preparedImport->trackMetadata.getAlbumInfo().getTitle();
+                if (preparedImport->coverImage.isNull()) {
+                    preparedImport->coverInfo = CoverArtUtils::selectCoverArtForTrack(
+                            mixxx::FileInfo(fileInfo),
+                            album,
+                            possibleCovers);
+                } else {
+                    preparedImport->coverInfo = CoverInfoGuesser().guessCoverInfo(
+                            mixxx::FileInfo(fileInfo),
+                            album,
+                            preparedImport->coverImage);
+                    // Only the digest of the image is needed from now on.
+                    // Don't keep the decoded image in the signal queue.
+                    preparedImport->coverImage = QImage();
+                }
+            }
+            emit addPreparedNewTrack(trackLocation, *preparedImport);
         }
     }
     // Insert or update the hash in the database.
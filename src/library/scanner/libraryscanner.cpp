@@ -13,14 +13,18 @@
 #include "util/db/dbconnectionpooler.h"
 #include "util/db/fwdsqlquery.h"
 #include "util/logger.h"
+#include "util/math.h"
 #include "util/performancetimer.h"
 #include "util/timer.h"
 #include "util/trace.h"
 
 namespace {
 
+// New files are parsed concurrently by the worker threads while the
+// database inserts are still done sequentially by the scanner thread.
+// The number of threads is limited because scanning is mostly I/O bound.
 // TODO(rryan) make configurable
-constexpr int kScannerThreadPoolSize = 1;
+constexpr int kMaxScannerThreadPoolSize = 4;
 
 mixxx::Logger kLogger("LibraryScanner");
 
@@ -112,7 +116,10 @@ LibraryScanner::LibraryScanner(
     const int instanceId = s_instanceCounter.fetchAndAddAcquire(1) + 1;
     setObjectName(QString("LibraryScanner %1").arg(instanceId));
 
-    m_pool.setMaxThreadCount(kScannerThreadPoolSize);
+    m_pool.setMaxThreadCount(
+            math_clamp(QThread::idealThreadCount(), 1, kMaxScannerThreadPoolSize));
+
+    qRegisterMetaType<SoundSourceProxy::PreparedImport>();
 
     // Listen to signals from our public methods (invoked by other threads) and
     // connect them to our slots to run the command on the scanner thread.
@@ -423,16 +430,21 @@ void LibraryScanner::slotFinishUnhashedScan() {
     }
 
     // TODO(XXX) doesn't take into account verifyRemainingTracks.
+    const auto elapsed = m_scannerGlobal->timerElapsed();
+    const auto numAddedTracks = m_scannerGlobal->addedTracks().size();
     qDebug("Scan took: %s. "
            "%d unchanged directories. "
            "%d changed/added directories. "
            "%d tracks verified from changed/added directories. "
-           "%d new tracks.",
-            m_scannerGlobal->timerElapsed().formatNanosWithUnit().toLocal8Bit().constData(),
+           "%d new tracks (%.1f files/s).",
+            elapsed.formatNanosWithUnit().toLocal8Bit().constData(),
             static_cast<int>(m_scannerGlobal->verifiedDirectories().size()),
             m_scannerGlobal->numScannedDirectories(),
             static_cast<int>(m_scannerGlobal->verifiedTracks().size()),
-            static_cast<int>(m_scannerGlobal->addedTracks().size()));
+            static_cast<int>(numAddedTracks),
+            elapsed.toDoubleSeconds() > 0
+                    ? numAddedTracks / elapsed.toDoubleSeconds()
+                    : 0.0);
 
     m_scannerGlobal.clear();
     changeScannerState(FINISHED);
@@ -514,6 +526,10 @@ void LibraryScanner::queueTask(ScannerTask* pTask) {
             &ScannerTask::addNewTrack,
             this,
             &LibraryScanner::slotAddNewTrack);
+    connect(pTask,
+            &ScannerTask::addPreparedNewTrack,
+            this,
+            &LibraryScanner::slotAddPreparedNewTrack);
 
     // Progress signals.
     // Pass directly to the main thread
@@ -569,10 +585,23 @@ void LibraryScanner::slotTrackExists(const QString& trackPath) {
 void LibraryScanner::slotAddNewTrack(const QString& trackPath) {
     //kLogger.debug() << "slotAddNewTrack" << trackPath;
     ScopedTimer timer(QStringLiteral("LibraryScanner::addNewTrack"));
+    addNewTrack(trackPath, nullptr);
+}
+
+void LibraryScanner::slotAddPreparedNewTrack(const QString& trackPath,
+        const SoundSourceProxy::PreparedImport& preparedImport) {
+    //kLogger.debug() << "slotAddPreparedNewTrack" << trackPath;
+    ScopedTimer timer(QStringLiteral("LibraryScanner::addPreparedNewTrack"));
+    addNewTrack(trackPath, &preparedImport);
+}
+
+void LibraryScanner::addNewTrack(const QString& trackPath,
+        const SoundSourceProxy::PreparedImport* pPreparedImport) {
     // For statistics tracking and to detect moved tracks
     TrackPointer pTrack = m_trackDao.addTracksAddFile(
             trackPath,
-            false);
+            false,
+            pPreparedImport);
     if (pTrack) {
         DEBUG_ASSERT(!pTrack->isDirty());
         // The track's actual location might differ from the
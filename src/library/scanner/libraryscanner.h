@@ -70,6 +70,8 @@ class LibraryScanner : public QThread {
     void slotDirectoryUnchanged(const QString& directoryPath);
     void slotTrackExists(const QString& trackPath);
     void slotAddNewTrack(const QString& trackPath);
+    void slotAddPreparedNewTrack(const QString& trackPath,
+            const SoundSourceProxy::PreparedImport& preparedImport);
 
   private:
     enum ScannerState {
@@ -95,6 +97,9 @@ class LibraryScanner : public QThread {
 
     void cleanUpScan();
 
+    void addNewTrack(const QString& trackPath,
+            const SoundSourceProxy::PreparedImport* pPreparedImport);
+
     mixxx::DbConnectionPoolPtr m_pDbConnectionPool;
 
     // The pool of threads used for worker tasks.
@@ -4,6 +4,7 @@
 #include <QRunnable>
 
 #include "library/scanner/scannerglobal.h"
+#include "sources/soundsourceproxy.h"
 
 class LibraryScanner;
 
@@ -24,6 +25,8 @@ class ScannerTask : public QObject, public QRunnable {
     void directoryUnchanged(const QString& directoryPath);
     void trackExists(const QString& filePath);
     void addNewTrack(const QString& filePath);
+    void addPreparedNewTrack(const QString& filePath,
+            const SoundSourceProxy::PreparedImport& preparedImport);
 
     // Feedback to GUI
     void progressLoading(const QString& fileName);
@@ -45,7 +45,8 @@ BaseTrackPlayerImpl::BaseTrackPlayerImpl(
         const ChannelHandleAndGroup& handleGroup,
         bool defaultMainMix,
         bool defaultHeadphones,
-        bool primaryDeck)
+        bool primaryDeck,
+        bool residentSamples)
         : BaseTrackPlayer(pParent, handleGroup.name()),
           m_pConfig(pConfig),
           m_pEngineMixer(pMixingEngine),
@@ -58,7 +59,8 @@ BaseTrackPlayerImpl::BaseTrackPlayerImpl(
             pMixingEngine,
             pEffectsManager,
             defaultOrientation,
-            primaryDeck);
+            primaryDeck,
+            residentSamples);
     m_pChannel = channel.get();
 
     m_pInputConfigured = make_parented<ControlProxy>(getGroup(), "input_configured", this);
@@ -87,7 +87,8 @@ class BaseTrackPlayerImpl : public BaseTrackPlayer {
             const ChannelHandleAndGroup& handleGroup,
             bool defaultMainMix,
             bool defaultHeadphones,
-            bool primaryDeck);
+            bool primaryDeck,
+            bool residentSamples = false);
     ~BaseTrackPlayerImpl() override;
 
     TrackPointer getLoadedTrack() const final;
@@ -824,7 +824,12 @@ void PlayerManager::slotAnalyzeTrack(TrackPointer track) {
         return;
     }
     if (m_pTrackAnalysisScheduler) {
-        if (m_pTrackAnalysisScheduler->scheduleTrack(track->getId())) {
+        // Publish a provisional beat grid and key as soon as possible
+        // to enable sync and quantize for the loaded track
+        AnalyzerTrack::Options options;
+        options.publishProvisionalResults = true;
+        if (m_pTrackAnalysisScheduler->scheduleTrack(
+                    AnalyzerScheduledTrack(track->getId(), options))) {
             m_pTrackAnalysisScheduler->resume();
         }
         // The first progress signal will suspend a running batch analysis
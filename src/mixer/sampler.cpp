@@ -2,6 +2,10 @@
 
 #include "moc_sampler.cpp"
 
+// static
+const ConfigKey Sampler::kResidentSamplesConfigKey =
+        ConfigKey(QStringLiteral("[Sampler]"), QStringLiteral("ResidentSamples"));
+
 Sampler::Sampler(PlayerManager* pParent,
         UserSettingsPointer pConfig,
         EngineMixer* pMixingEngine,
@@ -16,5 +20,6 @@ Sampler::Sampler(PlayerManager* pParent,
                   handleGroup,
                   /*defaultMainMix*/ true,
                   /*defaultHeadphones*/ false,
-                  /*primaryDeck*/ false) {
+                  /*primaryDeck*/ false,
+                  pConfig->getValue(kResidentSamplesConfigKey, false)) {
 }
@@ -5,6 +5,11 @@
 class Sampler : public BaseTrackPlayerImpl {
     Q_OBJECT
   public:
+    /// In short-sample mode, short tracks are kept decoded in the
+    /// ResidentSamplePool that is shared by all samplers. Applied to
+    /// samplers that are created after changing it.
+    static const ConfigKey kResidentSamplesConfigKey;
+
     Sampler(PlayerManager* pParent,
             UserSettingsPointer pConfig,
             EngineMixer* pMixingEngine,
@@ -20,6 +20,7 @@
 #include "library/trackcollection.h"
 #include "library/trackcollectionmanager.h"
 #include "moc_dlgpreflibrary.cpp"
+#include "sources/audiosourcepcmcacheproxy.h"
 #include "util/desktophelper.h"
 #include "widget/wsearchlineedit.h"
 
@@ -162,6 +163,10 @@ DlgPrefLibrary::DlgPrefLibrary(
             &QCheckBox::toggled,
             this,
             &DlgPrefLibrary::slotSyncTrackMetadataToggled);
+    connect(checkBox_decoded_audio_cache,
+            &QCheckBox::toggled,
+            spinBox_decoded_audio_cache_size,
+            &QSpinBox::setEnabled);
 
     setScrollSafeGuardForAllInputWidgets(this);
 
@@ -241,6 +246,8 @@ void DlgPrefLibrary::populateDirList() {
 
 void DlgPrefLibrary::slotResetToDefaults() {
     checkBox_library_scan->setChecked(false);
+    checkBox_decoded_audio_cache->setChecked(kDecodedAudioCacheEnabledDefault);
+    spinBox_decoded_audio_cache_size->setValue(kDecodedAudioCacheSizeMiBDefault);
     spinbox_history_track_duplicate_distance->setValue(
             kHistoryTrackDuplicateDistanceDefault);
     spinbox_history_min_tracks_to_keep->setValue(1);
@@ -277,6 +284,14 @@ void DlgPrefLibrary::slotUpdate() {
     populateDirList();
     checkBox_library_scan->setChecked(m_pConfig->getValue(
             kRescanOnStartupConfigKey, false));
+    checkBox_decoded_audio_cache->setChecked(m_pConfig->getValue(
+            kDecodedAudioCacheEnabledConfigKey,
+            kDecodedAudioCacheEnabledDefault));
+    spinBox_decoded_audio_cache_size->setValue(m_pConfig->getValue(
+            kDecodedAudioCacheSizeMiBConfigKey,
+            kDecodedAudioCacheSizeMiBDefault));
+    spinBox_decoded_audio_cache_size->setEnabled(
+            checkBox_decoded_audio_cache->isChecked());
 
     spinbox_history_track_duplicate_distance->setValue(m_pConfig->getValue(
             kHistoryTrackDuplicateDistanceConfigKey,
@@ -509,6 +524,16 @@ void DlgPrefLibrary::slotApply() {
     m_pConfig->set(kRescanOnStartupConfigKey,
             ConfigValue((int)checkBox_library_scan->isChecked()));
 
+    m_pConfig->set(kDecodedAudioCacheEnabledConfigKey,
+            ConfigValue(checkBox_decoded_audio_cache->isChecked()));
+    m_pConfig->set(kDecodedAudioCacheSizeMiBConfigKey,
+            ConfigValue(spinBox_decoded_audio_cache_size->value()));
+    // Applies to tracks that are loaded afterwards
+    mixxx::AudioSourcePcmCacheProxy::setEnabled(
+            checkBox_decoded_audio_cache->isChecked());
+    mixxx::AudioSourcePcmCacheProxy::setMaxSizeBytes(
+            static_cast<qint64>(spinBox_decoded_audio_cache_size->value()) * 1024 * 1024);
+
     m_pConfig->set(kHistoryTrackDuplicateDistanceConfigKey,
             ConfigValue(spinbox_history_track_duplicate_distance->value()));
     m_pConfig->set(kHistoryMinTracksToKeepConfigKey,
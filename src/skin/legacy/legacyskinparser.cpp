@@ -23,6 +23,7 @@
 #include "moc_legacyskinparser.cpp"
 #include "skin/legacy/colorschemeparser.h"
 #include "skin/legacy/launchimage.h"
+#include "skin/legacy/skinimagecache.h"
 #include "skin/legacy/skincontext.h"
 #include "track/track.h"
 #include "util/assert.h"
@@ -93,6 +94,12 @@
 
 using mixxx::skin::SkinManifest;
 
+namespace {
+
+const QString kSkinImageCacheDirectory = QStringLiteral("/cache/skin");
+
+} // namespace
+
 /// This QSet allows to make use of the implicit sharing
 /// of QString instead of every widget keeping its own copy.
 QSet<QString> LegacySkinParser::s_sharedGroupStrings;
@@ -336,6 +343,8 @@ QWidget* LegacySkinParser::parseSkin(const QString& skinPath, QWidget* pParent)
 
     m_pContext = std::make_unique<SkinContext>(m_pConfig, skinPath + "/skin.xml");
     m_pContext->setSkinBasePath(skinPath);
+    // Reuse the SVG images that have been rendered by the previous start
+    SkinImageCache::setDirectory(m_pConfig->getSettingsPath() + kSkinImageCacheDirectory);
 
     if (m_pParent) {
         qDebug() << "ERROR: Somehow a parent already exists -- you are probably re-using a LegacySkinParser which is not advisable!";
@@ -439,6 +448,8 @@ QWidget* LegacySkinParser::parseSkin(const QString& skinPath, QWidget* pParent)
 LaunchImage* LegacySkinParser::parseLaunchImage(const QString& skinPath, QWidget* pParent) {
     m_pContext = std::make_unique<SkinContext>(m_pConfig, skinPath + "/skin.xml");
     m_pContext->setSkinBasePath(skinPath);
+    // Reuse the SVG images that have been rendered by the previous start
+    SkinImageCache::setDirectory(m_pConfig->getSettingsPath() + kSkinImageCacheDirectory);
 
     QDomElement skinDocument = openSkin(skinPath);
     if (skinDocument.isNull()) {
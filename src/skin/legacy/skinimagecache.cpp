@@ -0,0 +1,147 @@
+#include "skin/legacy/skinimagecache.h"
+
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QtDebug>
+#include <cstring>
+
+namespace {
+
+constexpr quint32 kMagic = 0x4d58534b; // "MXSK"
+// Increment when changing the entry format
+constexpr quint32 kVersion = 1;
+// All images are stored in the format they are rendered in
+constexpr QImage::Format kFormat = QImage::Format_ARGB32_Premultiplied;
+
+} // namespace
+
+// static
+QString SkinImageCache::s_directory;
+
+// static
+void SkinImageCache::setDirectory(const QString& directory, qint64 maxSizeBytes) {
+    if (!directory.isEmpty() && !QDir().mkpath(directory)) {
+        qWarning() << "SkinImageCache: Failed to create directory" << directory;
+        s_directory.clear();
+        return;
+    }
+    s_directory = directory;
+    if (isEnabled()) {
+        evictLeastRecentlyUsed(maxSizeBytes);
+    }
+}
+
+// static
+void SkinImageCache::evictLeastRecentlyUsed(qint64 maxSizeBytes) {
+    const QFileInfoList entries = QDir(s_directory).entryInfoList(
+            QDir::Files, QDir::Time | QDir::Reversed);
+    qint64 totalSizeBytes = 0;
+    for (const auto& entry : entries) {
+        totalSizeBytes += entry.size();
+    }
+    // Oldest first
+    for (const auto& entry : entries) {
+        if (totalSizeBytes <= maxSizeBytes) {
+            break;
+        }
+        if (QFile::remove(entry.absoluteFilePath())) {
+            totalSizeBytes -= entry.size();
+        }
+    }
+}
+
+// static
+QString SkinImageCache::entryPath(const QString& svgPath, double scaleFactor) {
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(QFileInfo(svgPath).absoluteFilePath().toUtf8());
+    hash.addData(QByteArray::number(scaleFactor, 'g', 17));
+    return s_directory + QChar('/') + QString::fromLatin1(hash.result().toHex());
+}
+
+// static
+QByteArray SkinImageCache::fileDigest(const QString& path) {
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return QByteArray();
+    }
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    if (!hash.addData(&file)) {
+        return QByteArray();
+    }
+    return hash.result();
+}
+
+// static
+QImage SkinImageCache::loadImage(const QString& svgPath, double scaleFactor) {
+    if (!isEnabled()) {
+        return QImage();
+    }
+    QFile file(entryPath(svgPath, scaleFactor));
+    if (!file.exists() || !file.open(QIODevice::ReadWrite)) {
+        return QImage();
+    }
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_5_12);
+    quint32 magic = 0;
+    quint32 version = 0;
+    quint32 qtVersion = 0;
+    QByteArray digest;
+    qint32 width = 0;
+    qint32 height = 0;
+    QByteArray data;
+    stream >> magic >> version >> qtVersion >> digest >> width >> height >> data;
+    if (stream.status() != QDataStream::Ok ||
+            magic != kMagic ||
+            version != kVersion ||
+            // The rendering may differ between Qt versions
+            qtVersion != QT_VERSION ||
+            width <= 0 || height <= 0) {
+        return QImage();
+    }
+    if (digest != fileDigest(svgPath)) {
+        // The SVG file has been modified
+        return QImage();
+    }
+    QImage image(width, height, kFormat);
+    if (image.isNull() || data.size() != image.sizeInBytes()) {
+        return QImage();
+    }
+    std::memcpy(image.bits(), data.constData(), data.size());
+    // Mark as recently used for evictLeastRecentlyUsed()
+    file.setFileTime(QDateTime::currentDateTime(), QFileDevice::FileModificationTime);
+    return image;
+}
+
+// static
+void SkinImageCache::storeImage(
+        const QString& svgPath, double scaleFactor, const QImage& image) {
+    if (!isEnabled() || image.isNull()) {
+        return;
+    }
+    const QByteArray digest = fileDigest(svgPath);
+    if (digest.isEmpty()) {
+        return;
+    }
+    const QImage convertedImage = image.convertToFormat(kFormat);
+    QSaveFile file(entryPath(svgPath, scaleFactor));
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning() << "SkinImageCache: Failed to write" << file.fileName();
+        return;
+    }
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_5_12);
+    stream << kMagic << kVersion << static_cast<quint32>(QT_VERSION) << digest
+           << static_cast<qint32>(convertedImage.width())
+           << static_cast<qint32>(convertedImage.height())
+           << QByteArray::fromRawData(
+                      reinterpret_cast<const char*>(convertedImage.constBits()),
+                      static_cast<int>(convertedImage.sizeInBytes()));
+    if (stream.status() != QDataStream::Ok || !file.commit()) {
+        qWarning() << "SkinImageCache: Failed to write" << file.fileName();
+    }
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <QByteArray>
+#include <QImage>
+#include <QString>
+
+/// Persists SVG images that have been rasterized for the legacy skin, so
+/// the next start doesn't need to parse and render them again.
+///
+/// Entries are keyed by the path of the SVG file and the scale factor.
+/// Each entry carries the digest of the SVG file it has been rendered
+/// from and is only used as long as the file content is unchanged.
+/// Entries of modified files, other skins and other scale factors are
+/// never used again, so the least recently used entries are deleted when
+/// the cache exceeds its maximum size.
+class SkinImageCache {
+  public:
+    static constexpr qint64 kDefaultMaxSizeBytes = 128 * 1024 * 1024;
+
+    /// Enables the cache in the given directory and deletes the least
+    /// recently used entries until its size doesn't exceed maxSizeBytes.
+    /// An empty path disables it.
+    static void setDirectory(const QString& directory,
+            qint64 maxSizeBytes = kDefaultMaxSizeBytes);
+
+    static bool isEnabled() {
+        return !s_directory.isEmpty();
+    }
+
+    /// Returns a null image if there is no valid entry for the file
+    static QImage loadImage(const QString& svgPath, double scaleFactor);
+    static void storeImage(const QString& svgPath, double scaleFactor, const QImage& image);
+
+  private:
+    static QString entryPath(const QString& svgPath, double scaleFactor);
+    static QByteArray fileDigest(const QString& path);
+    static void evictLeastRecentlyUsed(qint64 maxSizeBytes);
+
+    static QString s_directory;
+};
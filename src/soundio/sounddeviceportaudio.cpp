@@ -18,6 +18,7 @@
 #include "util/sample.h"
 #include "util/timer.h"
 #include "util/trace.h"
+#include "util/tracerecorder.h"
 #include "waveform/visualplayposition.h"
 
 #ifdef PA_USE_ALSA
@@ -725,8 +726,13 @@ int SoundDevicePortAudio::callbackProcessDrift(
     Q_UNUSED(timeInfo);
     Trace trace("SoundDevicePortAudio::callbackProcessDrift %1",
             m_deviceId.debugName());
+    // Only allocates in the first callback of the thread, before the span
+    // is recorded
+    mixxx::TraceRecorder::registerCurrentThread();
+    mixxx::ScopedTraceSpan traceSpan("SoundDevicePortAudio::callbackProcessDrift");
 
     if (statusFlags & (paOutputUnderflow | paInputOverflow)) {
+        mixxx::TraceRecorder::recordInstant("xrun");
         m_pSoundManager->underflowHappened(7);
     }
 
@@ -857,8 +863,13 @@ int SoundDevicePortAudio::callbackProcess(const SINT framesPerBuffer,
         PaStreamCallbackFlags statusFlags) {
     Q_UNUSED(timeInfo);
     Trace trace("SoundDevicePortAudio::callbackProcess %1", m_deviceId.debugName());
+    // Only allocates in the first callback of the thread, before the span
+    // is recorded
+    mixxx::TraceRecorder::registerCurrentThread();
+    mixxx::ScopedTraceSpan traceSpan("SoundDevicePortAudio::callbackProcess");
 
     if (statusFlags & (paOutputUnderflow | paInputOverflow)) {
+        mixxx::TraceRecorder::recordInstant("xrun");
         m_pSoundManager->underflowHappened(1);
         //qDebug() << "callbackProcess read:" << "Underflow";
     }
@@ -912,6 +923,7 @@ int SoundDevicePortAudio::callbackProcessClkRef(
 
     Trace trace("SoundDevicePortAudio::callbackProcessClkRef %1",
             m_deviceId.debugName());
+    mixxx::ScopedTraceSpan traceSpan("SoundDevicePortAudio::callbackProcessClkRef");
 
     //qDebug() << "SoundDevicePortAudio::callbackProcess:" << m_deviceId;
 
@@ -934,6 +946,10 @@ int SoundDevicePortAudio::callbackProcessClkRef(
 #endif
         m_bSetThreadPriority = true;
 
+        // Allocate the trace buffer of the engine thread up front, so that
+        // recording spans never allocates or locks in later callbacks.
+        mixxx::TraceRecorder::registerCurrentThread();
+
         // This disables the denormals calculations, to avoid a
         // performance penalty of ~20
         // https://github.com/mixxxdj/mixxx/issues/7747
@@ -1001,6 +1017,7 @@ int SoundDevicePortAudio::callbackProcessClkRef(
 #endif
 
     if (statusFlags & (paOutputUnderflow | paInputOverflow)) {
+        mixxx::TraceRecorder::recordInstant("xrun");
         m_pSoundManager->underflowHappened(6);
     }
 
@@ -46,6 +46,22 @@ constexpr unsigned int kSleepSecondsAfterClosingDevice = 5;
 #endif
 } // anonymous namespace
 
+// static
+std::future<int> SoundManager::s_portAudioInitialization;
+
+// static
+void SoundManager::startPortAudioInitialization() {
+#ifdef Q_OS_LINUX
+    // PortAudio is not thread-safe, but it is not accessed before the
+    // initialization has been joined. Other platforms need to initialize
+    // PortAudio on the main thread, e.g. the COM apartment of WASAPI and ASIO.
+    s_portAudioInitialization = std::async(std::launch::async, []() {
+        setJACKName();
+        return static_cast<int>(Pa_Initialize());
+    });
+#endif
+}
+
 SoundManager::SoundManager(UserSettingsPointer pConfig,
         EngineMixer* pEngineMixer)
         : m_pEngineMixer(pEngineMixer),
@@ -252,13 +268,17 @@ void SoundManager::clearAndQueryDevices() {
 void SoundManager::queryDevicesPortaudio() {
     PaError err = paNoError;
     if (!m_paInitialized) {
+        if (s_portAudioInitialization.valid()) {
+            err = s_portAudioInitialization.get();
+        } else {
 #ifdef Q_OS_LINUX
-        setJACKName();
+            setJACKName();
 #endif
 #ifdef Q_OS_IOS
-        mixxx::initializeAVAudioSession();
+            mixxx::initializeAVAudioSession();
 #endif
-        err = Pa_Initialize();
+            err = Pa_Initialize();
+        }
         m_paInitialized = true;
     }
     if (err != paNoError) {
@@ -651,7 +671,7 @@ QList<AudioInput> SoundManager::registeredInputs() const {
     return m_registeredDestinations.keys();
 }
 
-void SoundManager::setJACKName() const {
+void SoundManager::setJACKName() {
 #ifdef Q_OS_LINUX
     typedef PaError (*SetJackClientName)(const char *name);
     QLibrary portaudio("libportaudio.so.2");
@@ -5,6 +5,7 @@
 #include <QObject>
 #include <QSharedPointer>
 #include <QString>
+#include <future>
 
 #include "audio/types.h"
 #include "control/pollingcontrolproxy.h"
@@ -40,6 +41,12 @@ class SoundManager : public QObject {
     SoundManager(UserSettingsPointer pConfig, EngineMixer* pEngineMixer);
     ~SoundManager() override;
 
+    /// Starts initializing PortAudio in a worker thread where this is
+    /// supported. Initializing PortAudio probes all host APIs and devices,
+    /// which may take seconds. The next SoundManager joins the
+    /// initialization before it enumerates the devices.
+    static void startPortAudioInitialization();
+
     // Returns a list of all devices we've enumerated that match the provided
     // filterApi, and have at least one output or input channel if the
     // bOutputDevices or bInputDevices are set, respectively.
@@ -123,11 +130,14 @@ class SoundManager : public QObject {
     // isn't open is safe.
     void closeDevices(bool sleepAfterClosing);
 
-    void setJACKName() const;
+    static void setJACKName();
     bool jackApiUsed() const {
         return m_config.getAPI() == MIXXX_PORTAUDIO_JACK_STRING;
     }
 
+    // The result of Pa_Initialize(), if it has been started in advance
+    static std::future<int> s_portAudioInitialization;
+
     EngineMixer* m_pEngineMixer;
     UserSettingsPointer m_pConfig;
     bool m_paInitialized;
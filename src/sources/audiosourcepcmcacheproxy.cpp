@@ -0,0 +1,425 @@
+#include "sources/audiosourcepcmcacheproxy.h"
+
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
+#include <QSaveFile>
+#include <algorithm>
+
+#include "util/assert.h"
+#include "util/compatibility/qmutex.h"
+#include "util/logger.h"
+#include "util/math.h"
+
+namespace mixxx {
+
+namespace {
+
+const Logger kLogger("AudioSourcePcmCacheProxy");
+
+// Equal to CachingReaderChunk::kFrames, so every chunk that is read by the
+// CachingReaderWorker maps to exactly one block
+constexpr SINT kBlockFrames = 8192;
+
+constexpr quint32 kFileMagic = 0x4D585043; // "MXPC"
+constexpr quint32 kFileFormatVersion = 1;
+
+// The fixed part of the header is followed by the table of filled blocks
+constexpr qint64 kFilledBlocksOffset = 64;
+// The sample data starts at a page boundary after the table
+constexpr qint64 kDataAlignment = 4096;
+
+const QString kFileSuffix = QStringLiteral(".pcm");
+
+QMutex s_mutex;
+QString s_storageDir;
+bool s_enabled = false;
+qint64 s_maxSizeBytes = 0;
+
+struct Header {
+    qint64 fileSize;
+    qint64 lastModified;
+    quint32 channelCount;
+    quint32 sampleRate;
+    qint64 frameIndexStart;
+    qint64 frameIndexEnd;
+    quint32 blockCount;
+
+    bool operator==(const Header& other) const {
+        return fileSize == other.fileSize &&
+                lastModified == other.lastModified &&
+                channelCount == other.channelCount &&
+                sampleRate == other.sampleRate &&
+                frameIndexStart == other.frameIndexStart &&
+                frameIndexEnd == other.frameIndexEnd &&
+                blockCount == other.blockCount;
+    }
+};
+
+qint64 dataOffset(qint64 blockCount) {
+    return ((kFilledBlocksOffset + blockCount + kDataAlignment - 1) /
+                   kDataAlignment) *
+            kDataAlignment;
+}
+
+qint64 cacheFileSize(const Header& header) {
+    const qint64 blockBytes = static_cast<qint64>(kBlockFrames) *
+            header.channelCount * sizeof(CSAMPLE);
+    return dataOffset(header.blockCount) + header.blockCount * blockBytes;
+}
+
+QByteArray serializeHeader(const Header& header) {
+    QByteArray data;
+    QDataStream out(&data, QIODevice::WriteOnly);
+    out << kFileMagic
+        << kFileFormatVersion
+        << header.fileSize
+        << header.lastModified
+        << header.channelCount
+        << header.sampleRate
+        << header.frameIndexStart
+        << header.frameIndexEnd
+        << header.blockCount;
+    DEBUG_ASSERT(data.size() <= kFilledBlocksOffset);
+    data.resize(kFilledBlocksOffset);
+    return data;
+}
+
+bool deserializeHeader(const QByteArray& data, Header* pHeader) {
+    QDataStream in(data);
+    quint32 magic;
+    quint32 formatVersion;
+    in >> magic >> formatVersion;
+    if (in.status() != QDataStream::Ok ||
+            magic != kFileMagic ||
+            formatVersion != kFileFormatVersion) {
+        return false;
+    }
+    in >> pHeader->fileSize >> pHeader->lastModified >> pHeader->channelCount >>
+            pHeader->sampleRate >> pHeader->frameIndexStart >>
+            pHeader->frameIndexEnd >> pHeader->blockCount;
+    return in.status() == QDataStream::Ok;
+}
+
+QString cacheFilePath(const QString& storageDir,
+        const QFileInfo& fileInfo,
+        audio::ChannelCount channelCount) {
+    const QByteArray digest = QCryptographicHash::hash(
+            (fileInfo.absoluteFilePath() + QChar('/') +
+                    QString::number(channelCount.value()))
+                    .toUtf8(),
+            QCryptographicHash::Sha1);
+    return QDir(storageDir).filePath(QString::fromLatin1(digest.toHex()) + kFileSuffix);
+}
+
+// Deletes the least recently used cache files until the additional bytes
+// fit into the cache. Must not be called with s_mutex locked, listing and
+// deleting the files might take a while. A cache file that is deleted while
+// it is in use remains accessible on Unix and can't be deleted on Windows.
+void evictLeastRecentlyUsed(const QString& storageDir,
+        qint64 maxSizeBytes,
+        qint64 additionalBytes,
+        const QString& excludedFilePath) {
+    QFileInfoList cacheFiles = QDir(storageDir).entryInfoList(
+            QStringList{QStringLiteral("*") + kFileSuffix},
+            QDir::Files,
+            QDir::Time | QDir::Reversed);
+    qint64 totalSizeBytes = additionalBytes;
+    for (const auto& cacheFile : std::as_const(cacheFiles)) {
+        if (cacheFile.absoluteFilePath() != excludedFilePath) {
+            totalSizeBytes += cacheFile.size();
+        }
+    }
+    // Oldest first
+    for (const auto& cacheFile : std::as_const(cacheFiles)) {
+        if (totalSizeBytes <= maxSizeBytes) {
+            break;
+        }
+        if (cacheFile.absoluteFilePath() == excludedFilePath) {
+            continue;
+        }
+        // Fails on Windows if the file is still in use by another deck,
+        // which is fine
+        if (QFile::remove(cacheFile.absoluteFilePath())) {
+            totalSizeBytes -= cacheFile.size();
+        }
+    }
+}
+
+// Writes the header of an empty cache file. The file is created next to
+// the previous one and renamed atomically, so a crash never leaves behind
+// a partially initialized cache file. The file is extended without writing
+// the sample data, which creates a sparse file on most file systems.
+bool initializeCacheFile(const QString& filePath,
+        const Header& header,
+        const QByteArray& filledBlocks,
+        qint64 fileSize) {
+    QSaveFile file(filePath);
+    return file.open(QIODevice::WriteOnly) &&
+            file.write(serializeHeader(header)) == kFilledBlocksOffset &&
+            file.write(filledBlocks) == filledBlocks.size() &&
+            file.resize(fileSize) &&
+            file.commit();
+}
+
+} // anonymous namespace
+
+// static
+void AudioSourcePcmCacheProxy::setStorageDir(const QString& storageDir) {
+    const auto locker = lockMutex(&s_mutex);
+    s_storageDir = storageDir;
+}
+
+// static
+QString AudioSourcePcmCacheProxy::storageDir() {
+    const auto locker = lockMutex(&s_mutex);
+    return s_storageDir;
+}
+
+// static
+void AudioSourcePcmCacheProxy::setEnabled(bool enabled) {
+    const auto locker = lockMutex(&s_mutex);
+    s_enabled = enabled;
+}
+
+// static
+void AudioSourcePcmCacheProxy::setMaxSizeBytes(qint64 maxSizeBytes) {
+    QString storageDir;
+    {
+        const auto locker = lockMutex(&s_mutex);
+        s_maxSizeBytes = maxSizeBytes;
+        storageDir = s_storageDir;
+    }
+    if (!storageDir.isEmpty()) {
+        evictLeastRecentlyUsed(storageDir, maxSizeBytes, 0, QString());
+    }
+}
+
+// static
+bool AudioSourcePcmCacheProxy::isCacheableFileType(const QString& fileType) {
+    // WAV, AIFF, FLAC, MP3 (see Mp3SeekIndexCache) and Ogg Vorbis are cheap
+    // enough to decode and seek
+    return fileType == QStringLiteral("opus") ||
+            fileType == QStringLiteral("m4a") ||
+            fileType == QStringLiteral("mp4") ||
+            fileType == QStringLiteral("aac") ||
+            fileType == QStringLiteral("alac") ||
+            fileType == QStringLiteral("wma") ||
+            fileType == QStringLiteral("ac3");
+}
+
+// static
+AudioSourcePointer AudioSourcePcmCacheProxy::create(
+        AudioSourcePointer pAudioSource,
+        const QFileInfo& fileInfo,
+        const QString& fileType) {
+    // Multi-channel stem files would occupy too much disk space
+    if (!pAudioSource ||
+            !isCacheableFileType(fileType) ||
+            pAudioSource->getSignalInfo().getChannelCount() >
+                    audio::ChannelCount::stereo() ||
+            pAudioSource->frameIndexRange().empty()) {
+        return pAudioSource;
+    }
+
+    QString storageDir;
+    qint64 maxSizeBytes;
+    {
+        const auto locker = lockMutex(&s_mutex);
+        if (!s_enabled || s_storageDir.isEmpty() || s_maxSizeBytes <= 0) {
+            return pAudioSource;
+        }
+        storageDir = s_storageDir;
+        maxSizeBytes = s_maxSizeBytes;
+    }
+
+    const auto frameIndexRange = pAudioSource->frameIndexRange();
+    const SINT firstBlockIndex = frameIndexRange.start() / kBlockFrames;
+    const SINT lastBlockIndex = (frameIndexRange.end() - 1) / kBlockFrames;
+    const Header header{
+            fileInfo.size(),
+            fileInfo.lastModified().toMSecsSinceEpoch(),
+            static_cast<quint32>(pAudioSource->getSignalInfo().getChannelCount().value()),
+            static_cast<quint32>(pAudioSource->getSignalInfo().getSampleRate().value()),
+            frameIndexRange.start(),
+            frameIndexRange.end(),
+            static_cast<quint32>(lastBlockIndex - firstBlockIndex + 1)};
+    const qint64 fileSize = cacheFileSize(header);
+    if (fileSize > maxSizeBytes) {
+        return pAudioSource;
+    }
+
+    if (!QDir().mkpath(storageDir)) {
+        kLogger.warning() << "Failed to create directory" << storageDir;
+        return pAudioSource;
+    }
+    const QString filePath = cacheFilePath(
+            storageDir, fileInfo, pAudioSource->getSignalInfo().getChannelCount());
+    auto pCacheFile = std::make_unique<QFile>(filePath);
+
+    QByteArray filledBlocks;
+    if (pCacheFile->exists() && pCacheFile->open(QIODevice::ReadWrite)) {
+        Header existingHeader;
+        if (deserializeHeader(pCacheFile->read(kFilledBlocksOffset), &existingHeader) &&
+                existingHeader == header &&
+                pCacheFile->size() == fileSize) {
+            filledBlocks = pCacheFile->read(header.blockCount);
+            // Mark as recently used
+            pCacheFile->setFileTime(QDateTime::currentDateTime(),
+                    QFileDevice::FileModificationTime);
+        }
+    }
+    if (filledBlocks.size() != static_cast<int>(header.blockCount)) {
+        // New, outdated or corrupt cache file
+        pCacheFile->close();
+        evictLeastRecentlyUsed(storageDir, maxSizeBytes, fileSize, filePath);
+        filledBlocks = QByteArray(header.blockCount, '\0');
+        if (!initializeCacheFile(filePath, header, filledBlocks, fileSize) ||
+                !pCacheFile->open(QIODevice::ReadWrite)) {
+            kLogger.warning() << "Failed to initialize cache file" << filePath;
+            return pAudioSource;
+        }
+    }
+
+    return std::make_shared<AudioSourcePcmCacheProxy>(
+            std::move(pAudioSource),
+            std::move(pCacheFile),
+            std::move(filledBlocks));
+}
+
+AudioSourcePcmCacheProxy::AudioSourcePcmCacheProxy(
+        AudioSourcePointer pAudioSource,
+        std::unique_ptr<QFile> pCacheFile,
+        QByteArray filledBlocks)
+        : AudioSourceProxy(std::move(pAudioSource)),
+          m_pCacheFile(std::move(pCacheFile)),
+          m_filledBlocks(std::move(filledBlocks)),
+          m_blockBuffer(getSignalInfo().frames2samples(kBlockFrames)) {
+}
+
+void AudioSourcePcmCacheProxy::close() {
+    m_pCacheFile.reset();
+    AudioSourceProxy::close();
+}
+
+void AudioSourcePcmCacheProxy::disableCache() {
+    kLogger.warning()
+            << "Failed to access cache file"
+            << m_pCacheFile->fileName()
+            << m_pCacheFile->errorString();
+    m_pCacheFile.reset();
+}
+
+SINT AudioSourcePcmCacheProxy::firstBlockIndex() const {
+    return frameIndexRange().start() / kBlockFrames;
+}
+
+qint64 AudioSourcePcmCacheProxy::blockOffset(SINT blockIndex) const {
+    return dataOffset(m_filledBlocks.size()) +
+            static_cast<qint64>(blockIndex - firstBlockIndex()) *
+            getSignalInfo().frames2samples(kBlockFrames) * sizeof(CSAMPLE);
+}
+
+bool AudioSourcePcmCacheProxy::isBlockFilled(SINT blockIndex) const {
+    const SINT tableIndex = blockIndex - firstBlockIndex();
+    return tableIndex >= 0 &&
+            tableIndex < m_filledBlocks.size() &&
+            m_filledBlocks.at(tableIndex) != '\0';
+}
+
+bool AudioSourcePcmCacheProxy::fillBlock(
+        SINT blockIndex, IndexRange blockFrameIndexRange) {
+    const SINT tableIndex = blockIndex - firstBlockIndex();
+    VERIFY_OR_DEBUG_ASSERT(tableIndex >= 0 && tableIndex < m_filledBlocks.size()) {
+        return false;
+    }
+    const SINT sampleCount = getSignalInfo().frames2samples(blockFrameIndexRange.length());
+    const auto readable = readSampleFramesClampedOn(
+            *m_pAudioSource,
+            WritableSampleFrames(
+                    blockFrameIndexRange,
+                    SampleBuffer::WritableSlice(m_blockBuffer.data(), sampleCount)));
+    if (readable.frameIndexRange() != blockFrameIndexRange) {
+        // Decoding errors, don't cache anything
+        return false;
+    }
+    const qint64 byteCount = sampleCount * sizeof(CSAMPLE);
+    const char tableEntry = 1;
+    if (!m_pCacheFile->seek(blockOffset(blockIndex)) ||
+            m_pCacheFile->write(
+                    reinterpret_cast<const char*>(readable.readableData()),
+                    byteCount) != byteCount ||
+            !m_pCacheFile->seek(kFilledBlocksOffset + tableIndex) ||
+            m_pCacheFile->write(&tableEntry, 1) != 1) {
+        disableCache();
+        return false;
+    }
+    m_filledBlocks[tableIndex] = tableEntry;
+    return true;
+}
+
+ReadableSampleFrames AudioSourcePcmCacheProxy::readSampleFramesClamped(
+        const WritableSampleFrames& sampleFrames) {
+    if (!m_pCacheFile || sampleFrames.writableLength() == 0) {
+        return readSampleFramesClampedOn(*m_pAudioSource, sampleFrames);
+    }
+
+    const auto requestedFrameIndexRange = sampleFrames.frameIndexRange();
+    CSAMPLE* pOutput = sampleFrames.writableData();
+    SINT frameIndex = requestedFrameIndexRange.start();
+    while (m_pCacheFile && frameIndex < requestedFrameIndexRange.end()) {
+        const SINT blockIndex = frameIndex / kBlockFrames;
+        const auto blockFrameIndexRange = intersect(
+                IndexRange::forward(blockIndex * kBlockFrames, kBlockFrames),
+                frameIndexRange());
+        if (!isBlockFilled(blockIndex) &&
+                !fillBlock(blockIndex, blockFrameIndexRange)) {
+            break;
+        }
+        const SINT endFrameIndex = math_min(
+                blockFrameIndexRange.end(), requestedFrameIndexRange.end());
+        const SINT sampleCount = getSignalInfo().frames2samples(endFrameIndex - frameIndex);
+        const qint64 byteCount = sampleCount * sizeof(CSAMPLE);
+        const qint64 offset = blockOffset(blockIndex) +
+                getSignalInfo().frames2samples(frameIndex - blockFrameIndexRange.start()) *
+                        sizeof(CSAMPLE);
+        if (!m_pCacheFile->seek(offset) ||
+                m_pCacheFile->read(reinterpret_cast<char*>(pOutput), byteCount) !=
+                        byteCount) {
+            disableCache();
+            break;
+        }
+        pOutput += sampleCount;
+        frameIndex = endFrameIndex;
+    }
+
+    if (frameIndex < requestedFrameIndexRange.end()) {
+        // Read the remaining frames that are not cached from the decoder
+        const auto remainingFrameIndexRange = IndexRange::between(
+                frameIndex, requestedFrameIndexRange.end());
+        const auto readable = readSampleFramesClampedOn(
+                *m_pAudioSource,
+                WritableSampleFrames(
+                        remainingFrameIndexRange,
+                        SampleBuffer::WritableSlice(
+                                pOutput,
+                                getSignalInfo().frames2samples(
+                                        remainingFrameIndexRange.length()))));
+        if (!readable.frameIndexRange().empty() &&
+                readable.frameIndexRange().start() == frameIndex) {
+            DEBUG_ASSERT(readable.readableData() == pOutput);
+            frameIndex = readable.frameIndexRange().end();
+        }
+    }
+
+    const auto readFrameIndexRange = IndexRange::between(
+            requestedFrameIndexRange.start(), frameIndex);
+    return ReadableSampleFrames(
+            readFrameIndexRange,
+            SampleBuffer::ReadableSlice(
+                    sampleFrames.writableData(),
+                    getSignalInfo().frames2samples(readFrameIndexRange.length())));
+}
+
+} // namespace mixxx
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <QByteArray>
+#include <QFile>
+#include <QFileInfo>
+#include <memory>
+
+#include "sources/audiosourceproxy.h"
+#include "util/samplebuffer.h"
+
+namespace mixxx {
+
+/// Keeps the decoded sample data of tracks in a file format that is expensive
+/// to decode and seek, i.e. Opus, AAC and other FFmpeg decoded formats, in a
+/// disk cache. Subsequent reads of the same frames are served from the cache
+/// file with the cost of a WAV file.
+///
+/// The cache file of each track is split into blocks of a fixed number of
+/// frames that are aligned with the chunks of the CachingReader. Blocks are
+/// decoded and stored when they are read for the first time. The least
+/// recently used cache files are deleted when the total size of the cache
+/// exceeds the configured maximum.
+class AudioSourcePcmCacheProxy : public AudioSourceProxy {
+  public:
+    /// The cache is only used after a directory has been set and it has
+    /// been enabled. All static functions are thread-safe.
+    static void setStorageDir(const QString& storageDir);
+    static QString storageDir();
+    static void setEnabled(bool enabled);
+    static void setMaxSizeBytes(qint64 maxSizeBytes);
+
+    /// Returns whether decoding files of the given type is slow enough for
+    /// caching the decoded sample data.
+    static bool isCacheableFileType(const QString& fileType);
+
+    /// Wraps an opened audio source with a cache proxy if the cache is
+    /// enabled and applicable. Otherwise the audio source is returned
+    /// unmodified.
+    static AudioSourcePointer create(
+            AudioSourcePointer pAudioSource,
+            const QFileInfo& fileInfo,
+            const QString& fileType);
+
+    AudioSourcePcmCacheProxy(
+            AudioSourcePointer pAudioSource,
+            std::unique_ptr<QFile> pCacheFile,
+            QByteArray filledBlocks);
+    ~AudioSourcePcmCacheProxy() override = default;
+
+    void close() override;
+
+  protected:
+    ReadableSampleFrames readSampleFramesClamped(
+            const WritableSampleFrames& sampleFrames) override;
+
+  private:
+    SINT firstBlockIndex() const;
+    qint64 blockOffset(SINT blockIndex) const;
+    bool isBlockFilled(SINT blockIndex) const;
+    /// Decodes the block and stores it in the cache file
+    bool fillBlock(SINT blockIndex, IndexRange blockFrameIndexRange);
+    /// Stops using the cache file after an I/O error
+    void disableCache();
+
+    std::unique_ptr<QFile> m_pCacheFile;
+    /// One byte per block, non-zero if the block is available in the
+    /// cache file. Mirrors the corresponding table in the file header.
+    QByteArray m_filledBlocks;
+    SampleBuffer m_blockBuffer;
+};
+
+} // namespace mixxx
@@ -0,0 +1,267 @@
+#include "sources/mp3seekindexcache.h"
+
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
+#include <QSaveFile>
+#include <list>
+
+#include "util/assert.h"
+#include "util/compatibility/qmutex.h"
+#include "util/logger.h"
+
+namespace mixxx {
+
+namespace {
+
+const Logger kLogger("Mp3SeekIndexCache");
+
+// Enough for the files that are opened concurrently by the decks and
+// the analyzer
+constexpr std::size_t kMemoryCacheCapacity = 8;
+
+// Parsing shorter files takes not long enough to justify the disk usage,
+// 20000 MP3 frames are about 9 minutes of audio
+constexpr std::size_t kMinPersistedSeekFrameCount = 20000;
+
+// The seek index of a 9 minute file takes about 40 KiB on disk, i.e. the
+// seek indexes of more than a thousand long files are kept
+constexpr qint64 kMaxStorageSizeBytes = 64 * 1024 * 1024;
+
+// Each seek frame is stored as two delta encoded quint32 values
+constexpr qint64 kSerializedSeekFrameBytes = 2 * sizeof(quint32);
+
+constexpr quint32 kFileMagic = 0x4D585349; // "MXSI"
+constexpr quint32 kFileFormatVersion = 1;
+
+struct CacheEntry {
+    QString filePath;
+    qint64 fileSize;
+    QDateTime lastModified;
+    std::shared_ptr<const Mp3SeekIndex> pSeekIndex;
+};
+
+QMutex s_mutex;
+QString s_storageDir;
+// Most recently used entries first
+std::list<CacheEntry> s_entries;
+
+QString storageFilePath(const QString& storageDir, const QString& filePath) {
+    const QByteArray digest = QCryptographicHash::hash(
+            filePath.toUtf8(), QCryptographicHash::Sha1);
+    return QDir(storageDir).filePath(QString::fromLatin1(digest.toHex()));
+}
+
+QByteArray serialize(const CacheEntry& entry) {
+    const Mp3SeekIndex& seekIndex = *entry.pSeekIndex;
+    QByteArray data;
+    QDataStream out(&data, QIODevice::WriteOnly);
+    out << kFileMagic
+        << kFileFormatVersion
+        << entry.filePath
+        << entry.fileSize
+        << entry.lastModified.toMSecsSinceEpoch()
+        << static_cast<quint32>(seekIndex.channelCount.value())
+        << static_cast<quint32>(seekIndex.sampleRate.value())
+        << static_cast<quint32>(seekIndex.bitrate.value())
+        << seekIndex.leftoverByteOffset
+        << static_cast<quint32>(seekIndex.seekFrames.size());
+    // Delta encoded, the data is very repetitive and compresses well
+    SINT frameIndex = 0;
+    quint64 byteOffset = 0;
+    for (const auto& seekFrame : seekIndex.seekFrames) {
+        out << static_cast<quint32>(seekFrame.frameIndex - frameIndex)
+            << static_cast<quint32>(seekFrame.byteOffset - byteOffset);
+        frameIndex = seekFrame.frameIndex;
+        byteOffset = seekFrame.byteOffset;
+    }
+    return qCompress(data);
+}
+
+std::shared_ptr<const Mp3SeekIndex> deserialize(
+        const QByteArray& compressedData,
+        const CacheEntry& entry) {
+    const QByteArray data = qUncompress(compressedData);
+    QDataStream in(data);
+    quint32 magic;
+    quint32 formatVersion;
+    in >> magic >> formatVersion;
+    if (in.status() != QDataStream::Ok ||
+            magic != kFileMagic ||
+            formatVersion != kFileFormatVersion) {
+        return nullptr;
+    }
+    QString filePath;
+    qint64 fileSize;
+    qint64 lastModifiedMSecs;
+    in >> filePath >> fileSize >> lastModifiedMSecs;
+    if (filePath != entry.filePath ||
+            fileSize != entry.fileSize ||
+            lastModifiedMSecs != entry.lastModified.toMSecsSinceEpoch()) {
+        // Modified or a different file with the same hash
+        return nullptr;
+    }
+    auto pSeekIndex = std::make_shared<Mp3SeekIndex>();
+    quint32 channelCount;
+    quint32 sampleRate;
+    quint32 bitrate;
+    quint32 seekFrameCount;
+    in >> channelCount >> sampleRate >> bitrate >>
+            pSeekIndex->leftoverByteOffset >> seekFrameCount;
+    if (in.status() != QDataStream::Ok ||
+            seekFrameCount < 2 ||
+            pSeekIndex->leftoverByteOffset >= fileSize) {
+        return nullptr;
+    }
+    // Don't trust the count of a corrupt or truncated file before allocating
+    // the memory for the seek frames
+    const qint64 remainingBytes = data.size() - in.device()->pos();
+    if (seekFrameCount > remainingBytes / kSerializedSeekFrameBytes) {
+        return nullptr;
+    }
+    pSeekIndex->channelCount = audio::ChannelCount(channelCount);
+    pSeekIndex->sampleRate = audio::SampleRate(sampleRate);
+    pSeekIndex->bitrate = audio::Bitrate(bitrate);
+    pSeekIndex->seekFrames.reserve(seekFrameCount);
+    SINT frameIndex = 0;
+    quint64 byteOffset = 0;
+    for (quint32 i = 0; i < seekFrameCount; ++i) {
+        quint32 frameIndexDelta;
+        quint32 byteOffsetDelta;
+        in >> frameIndexDelta >> byteOffsetDelta;
+        frameIndex += frameIndexDelta;
+        byteOffset += byteOffsetDelta;
+        pSeekIndex->seekFrames.push_back({frameIndex, byteOffset});
+    }
+    if (in.status() != QDataStream::Ok ||
+            byteOffset >= static_cast<quint64>(fileSize)) {
+        return nullptr;
+    }
+    return pSeekIndex;
+}
+
+// Deletes the least recently used files until the total size of the
+// storage directory doesn't exceed kMaxStorageSizeBytes. Doesn't need
+// s_mutex, deleting a file concurrently with load() only causes a cache
+// miss.
+void evictLeastRecentlyUsed(const QString& storageDir) {
+    const QFileInfoList storageFiles = QDir(storageDir).entryInfoList(
+            QDir::Files, QDir::Time | QDir::Reversed);
+    qint64 totalSizeBytes = 0;
+    for (const auto& storageFile : storageFiles) {
+        totalSizeBytes += storageFile.size();
+    }
+    // Oldest first
+    for (const auto& storageFile : storageFiles) {
+        if (totalSizeBytes <= kMaxStorageSizeBytes) {
+            break;
+        }
+        if (QFile::remove(storageFile.absoluteFilePath())) {
+            totalSizeBytes -= storageFile.size();
+        }
+    }
+}
+
+void insertEntry(CacheEntry entry) {
+    s_entries.push_front(std::move(entry));
+    if (s_entries.size() > kMemoryCacheCapacity) {
+        s_entries.pop_back();
+    }
+}
+
+} // anonymous namespace
+
+// static
+void Mp3SeekIndexCache::setStorageDir(const QString& storageDir) {
+    const auto locker = lockMutex(&s_mutex);
+    s_storageDir = storageDir;
+}
+
+// static
+std::shared_ptr<const Mp3SeekIndex> Mp3SeekIndexCache::load(const QFileInfo& fileInfo) {
+    CacheEntry entry{fileInfo.absoluteFilePath(),
+            fileInfo.size(),
+            fileInfo.lastModified(),
+            nullptr};
+    QString storageDir;
+    {
+        const auto locker = lockMutex(&s_mutex);
+        for (auto it = s_entries.begin(); it != s_entries.end(); ++it) {
+            if (it->filePath != entry.filePath) {
+                continue;
+            }
+            if (it->fileSize == entry.fileSize && it->lastModified == entry.lastModified) {
+                // Move to front
+                s_entries.splice(s_entries.begin(), s_entries, it);
+                return it->pSeekIndex;
+            }
+            s_entries.erase(it);
+            break;
+        }
+        storageDir = s_storageDir;
+    }
+    if (storageDir.isEmpty()) {
+        return nullptr;
+    }
+
+    QFile file(storageFilePath(storageDir, entry.filePath));
+    // Opened for writing to update the modification time
+    if (!file.exists() || !file.open(QIODevice::ReadWrite)) {
+        // Not persisted
+        return nullptr;
+    }
+    entry.pSeekIndex = deserialize(file.readAll(), entry);
+    if (!entry.pSeekIndex) {
+        kLogger.info() << "Removing outdated seek index of" << entry.filePath;
+        file.remove();
+        return nullptr;
+    }
+    // Mark as recently used for evictLeastRecentlyUsed()
+    file.setFileTime(QDateTime::currentDateTime(), QFileDevice::FileModificationTime);
+    file.close();
+    auto pSeekIndex = entry.pSeekIndex;
+    const auto locker = lockMutex(&s_mutex);
+    insertEntry(std::move(entry));
+    return pSeekIndex;
+}
+
+// static
+void Mp3SeekIndexCache::store(
+        const QFileInfo& fileInfo,
+        std::shared_ptr<const Mp3SeekIndex> pSeekIndex) {
+    VERIFY_OR_DEBUG_ASSERT(pSeekIndex && pSeekIndex->seekFrames.size() >= 2) {
+        return;
+    }
+    CacheEntry entry{fileInfo.absoluteFilePath(),
+            fileInfo.size(),
+            fileInfo.lastModified(),
+            std::move(pSeekIndex)};
+    QString storageDir;
+    {
+        const auto locker = lockMutex(&s_mutex);
+        storageDir = s_storageDir;
+        if (storageDir.isEmpty() ||
+                entry.pSeekIndex->seekFrames.size() < kMinPersistedSeekFrameCount) {
+            insertEntry(std::move(entry));
+            return;
+        }
+        insertEntry(entry);
+    }
+
+    if (!QDir().mkpath(storageDir)) {
+        kLogger.warning() << "Failed to create directory" << storageDir;
+        return;
+    }
+    QSaveFile file(storageFilePath(storageDir, entry.filePath));
+    if (!file.open(QIODevice::WriteOnly) ||
+            file.write(serialize(entry)) < 0 ||
+            !file.commit()) {
+        kLogger.warning() << "Failed to store seek index of"
+                          << entry.filePath << file.errorString();
+        return;
+    }
+    evictLeastRecentlyUsed(storageDir);
+}
+
+} // namespace mixxx
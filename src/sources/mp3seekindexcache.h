@@ -0,0 +1,51 @@
+#pragma once
+
+#include <QFileInfo>
+#include <QString>
+#include <memory>
+#include <vector>
+
+#include "audio/types.h"
+#include "util/types.h"
+
+namespace mixxx {
+
+/// The seek table of an MP3 file, i.e. the byte offset and the first sample
+/// frame of each MP3 frame. Building it requires parsing the headers of all
+/// MP3 frames in the file.
+struct Mp3SeekIndex {
+    struct SeekFrame {
+        SINT frameIndex;
+        quint64 byteOffset;
+    };
+
+    audio::ChannelCount channelCount;
+    audio::SampleRate sampleRate;
+    audio::Bitrate bitrate;
+    /// Ordered by frameIndex. The last entry only marks the end of the
+    /// stream and its byte offset is unused.
+    std::vector<SeekFrame> seekFrames;
+    /// The byte offset from which the end of the stream has to be decoded
+    /// from a zero padded copy, or -1 if not needed.
+    qint64 leftoverByteOffset = -1;
+};
+
+/// Keeps the seek indexes of recently opened MP3 files in memory and those
+/// of long files also on disk, keyed by the file path, size and time of
+/// the last modification. Reopening a file, e.g. by the analyzer right
+/// after it has been loaded into a deck or in a later session, then doesn't
+/// require to parse the whole file again. The least recently used files
+/// on disk are deleted when their total size exceeds a fixed limit.
+///
+/// All functions are thread-safe.
+class Mp3SeekIndexCache {
+  public:
+    /// Seek indexes are only persisted after a directory has been set.
+    static void setStorageDir(const QString& storageDir);
+
+    static std::shared_ptr<const Mp3SeekIndex> load(const QFileInfo& fileInfo);
+    static void store(const QFileInfo& fileInfo,
+            std::shared_ptr<const Mp3SeekIndex> pSeekIndex);
+};
+
+} // namespace mixxx
@@ -4,6 +4,7 @@
 #include "util/logger.h"
 #include "util/math.h"
 
+#include <QFileInfo>
 #include <id3tag.h>
 
 namespace mixxx {
@@ -90,6 +91,15 @@ constexpr SINT kMaxMp3FramesPerSecond = 39; // fixed: 1 MP3 frame = 26 ms -> ~ 1
 constexpr SINT kSeekFrameListCapacity =
         kMinutesPerFile * kSecondsPerMinute * kMaxMp3FramesPerSecond;
 
+// Number of seek frames of a cached seek index that are checked
+// against the file before using it
+constexpr SINT kVerifiedSeekFrameCount = 64;
+
+inline bool isFrameSync(const unsigned char* pInputData) {
+    // 11 bits frame sync
+    return pInputData[0] == 0xFF && (pInputData[1] & 0xE0) == 0xE0;
+}
+
 inline QString formatHeaderFlags(int headerFlags) {
     return QString("0x%1").arg(headerFlags, 4, 16, QLatin1Char('0'));
 }
@@ -197,7 +207,8 @@ SoundSourceMp3::SoundSourceMp3(const QUrl& url)
           m_avgSeekFrameCount(0),
           m_curFrameIndex(0),
           m_madSynthCount(0),
-          m_leftoverBuffer(kMaxBytesPerMp3Frame + MAD_BUFFER_GUARD) {
+          m_leftoverBuffer(kMaxBytesPerMp3Frame + MAD_BUFFER_GUARD),
+          m_leftoverByteOffset(-1) {
     m_seekFrameList.reserve(kSeekFrameListCapacity);
     initDecoding();
 }
@@ -247,6 +258,18 @@ SoundSource::OpenResult SoundSourceMp3::tryOpen(
     DEBUG_ASSERT(m_seekFrameList.empty());
     m_avgSeekFrameCount = 0;
     m_curFrameIndex = 0;
+
+    // Parsing all frame headers of long files takes a while, especially
+    // from slow storage devices. Reuse the seek index from a previous open.
+    const QFileInfo fileInfo(m_file);
+    if (const auto pSeekIndex = Mp3SeekIndexCache::load(fileInfo)) {
+        if (tryOpenFromSeekIndex(*pSeekIndex)) {
+            return OpenResult::Succeeded;
+        }
+        kLogger.warning() << "Ignoring invalid seek index of file:"
+                          << m_file.fileName();
+    }
+
     int headerPerSampleRate[kSampleRateCount];
     for (int i = 0; i < kSampleRateCount; ++i) {
         headerPerSampleRate[i] = 0;
@@ -484,9 +507,106 @@ SoundSource::OpenResult SoundSourceMp3::tryOpen(
         return OpenResult::Failed;
     }
 
+    Mp3SeekIndexCache::store(fileInfo, createSeekIndex());
+
     return OpenResult::Succeeded;
 }
 
+bool SoundSourceMp3::tryOpenFromSeekIndex(const Mp3SeekIndex& seekIndex) {
+    DEBUG_ASSERT(m_seekFrameList.empty());
+    const auto& seekFrames = seekIndex.seekFrames;
+    if (seekFrames.size() < 2 ||
+            seekFrames.front().frameIndex != 0 ||
+            !seekIndex.channelCount.isValid() ||
+            seekIndex.channelCount > kChannelCountMax ||
+            getIndexBySampleRate(seekIndex.sampleRate) >= kSampleRateCount) {
+        return false;
+    }
+    // The terminating seek frame has no input data
+    const SINT seekFrameCount = static_cast<SINT>(seekFrames.size()) - 1;
+
+    // Spot check that the seek frames still point to MP3 frame headers
+    const SINT verifyStep = math_max(SINT(1), seekFrameCount / kVerifiedSeekFrameCount);
+    for (SINT i = 0; i < seekFrameCount; i += verifyStep) {
+        const quint64 byteOffset = seekFrames[i].byteOffset;
+        if (byteOffset + 1 >= m_fileSize || !isFrameSync(m_pFileData + byteOffset)) {
+            return false;
+        }
+    }
+
+    unsigned char* pLeftoverBuffer = &*m_leftoverBuffer.begin();
+    if (seekIndex.leftoverByteOffset >= 0) {
+        // Restore the zero padded copy of the end of the stream
+        // as done by copyLeftoverFrame()
+        const SINT remainingBytes =
+                static_cast<SINT>(m_fileSize) - seekIndex.leftoverByteOffset;
+        const SINT leftoverBytes = remainingBytes + MAD_BUFFER_GUARD;
+        if (remainingBytes <= 0 || leftoverBytes > SINT(m_leftoverBuffer.size())) {
+            return false;
+        }
+        std::copy(m_pFileData + seekIndex.leftoverByteOffset,
+                m_pFileData + m_fileSize,
+                pLeftoverBuffer);
+        std::fill(pLeftoverBuffer + remainingBytes, pLeftoverBuffer + leftoverBytes, 0);
+        m_leftoverByteOffset = seekIndex.leftoverByteOffset;
+    }
+
+    for (SINT i = 0; i < seekFrameCount; ++i) {
+        const auto& seekFrame = seekFrames[i];
+        if (m_leftoverByteOffset >= 0 &&
+                seekFrame.byteOffset >= static_cast<quint64>(m_leftoverByteOffset)) {
+            addSeekFrame(seekFrame.frameIndex,
+                    pLeftoverBuffer + (seekFrame.byteOffset - m_leftoverByteOffset));
+        } else {
+            addSeekFrame(seekFrame.frameIndex, m_pFileData + seekFrame.byteOffset);
+        }
+    }
+    addSeekFrame(seekFrames.back().frameIndex, nullptr);
+
+    initChannelCountOnce(seekIndex.channelCount);
+    initSampleRateOnce(seekIndex.sampleRate);
+    initFrameIndexRangeOnce(IndexRange::forward(0, seekFrames.back().frameIndex));
+    m_avgSeekFrameCount = frameLength() / seekFrameCount;
+    if (seekIndex.bitrate.isValid()) {
+        initBitrateOnce(seekIndex.bitrate);
+    }
+
+    // Start decoding at the beginning of the audio stream
+    restartDecoding(m_seekFrameList.front());
+    DEBUG_ASSERT(m_curFrameIndex == frameIndexMin());
+    return true;
+}
+
+std::shared_ptr<const Mp3SeekIndex> SoundSourceMp3::createSeekIndex() const {
+    auto pSeekIndex = std::make_shared<Mp3SeekIndex>();
+    pSeekIndex->channelCount = getSignalInfo().getChannelCount();
+    pSeekIndex->sampleRate = getSignalInfo().getSampleRate();
+    pSeekIndex->bitrate = getBitrate();
+    pSeekIndex->seekFrames.reserve(m_seekFrameList.size());
+    const unsigned char* pLeftoverBuffer = &*m_leftoverBuffer.begin();
+    const unsigned char* pLeftoverBufferEnd = pLeftoverBuffer + m_leftoverBuffer.size();
+    for (const auto& seekFrame : m_seekFrameList) {
+        quint64 byteOffset = 0;
+        if (!seekFrame.pInputData) {
+            // Terminating seek frame
+            DEBUG_ASSERT(seekFrame.frameIndex == frameIndexMax());
+        } else if (seekFrame.pInputData >= pLeftoverBuffer &&
+                seekFrame.pInputData < pLeftoverBufferEnd) {
+            DEBUG_ASSERT(m_leftoverByteOffset >= 0);
+            byteOffset = m_leftoverByteOffset + (seekFrame.pInputData - pLeftoverBuffer);
+            pSeekIndex->leftoverByteOffset = m_leftoverByteOffset;
+        } else {
+            byteOffset = seekFrame.pInputData - m_pFileData;
+        }
+        pSeekIndex->seekFrames.push_back({seekFrame.frameIndex, byteOffset});
+    }
+    // The end marker only keeps the deltas of the serialized index small
+    pSeekIndex->seekFrames.back().byteOffset = pSeekIndex->seekFrames.size() > 1
+            ? pSeekIndex->seekFrames[pSeekIndex->seekFrames.size() - 2].byteOffset
+            : 0;
+    return pSeekIndex;
+}
+
 void SoundSourceMp3::close() {
     finishDecoding();
 
@@ -498,6 +618,7 @@ void SoundSourceMp3::close() {
     m_file.close();
 
     m_seekFrameList.clear();
+    m_leftoverByteOffset = -1;
 
     // Re-init the decoder, because the SoundSource might be reopened and
     // the destructor calls finishDecoding() after close().
@@ -861,6 +982,7 @@ bool SoundSourceMp3::copyLeftoverFrame() {
         DEBUG_ASSERT(remainingBytes <= kMaxBytesPerMp3Frame); // only last MP3 frame
         const SINT leftoverBytes = remainingBytes + MAD_BUFFER_GUARD;
         if ((remainingBytes > 0) && (leftoverBytes <= SINT(m_leftoverBuffer.size()))) {
+            m_leftoverByteOffset = m_madStream.next_frame - m_pFileData;
             // Copy the data of the last MP3 frame into the leftover buffer...
             std::copy(m_madStream.next_frame,
                     m_madStream.next_frame + remainingBytes,
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "sources/mp3seekindexcache.h"
 #include "sources/soundsourceprovider.h"
 
 #ifdef _MSC_VER
@@ -53,6 +54,11 @@ class SoundSourceMp3 final : public SoundSource {
 
     void addSeekFrame(SINT frameIndex, const unsigned char* pInputData);
 
+    /// Restores m_seekFrameList and the audio properties from a cached
+    /// seek index instead of parsing all MP3 frame headers.
+    bool tryOpenFromSeekIndex(const Mp3SeekIndex& seekIndex);
+    std::shared_ptr<const Mp3SeekIndex> createSeekIndex() const;
+
     /** Returns the position in m_seekFrameList of the requested frame index. */
     SINT findSeekFrameIndex(SINT frameIndex) const;
 
@@ -74,6 +80,8 @@ class SoundSourceMp3 final : public SoundSource {
     SINT m_madSynthCount; // left overs from the previous read
 
     std::vector<unsigned char> m_leftoverBuffer;
+    // The byte offset in the file from which the leftover buffer has been filled
+    qint64 m_leftoverByteOffset;
 };
 
 class SoundSourceProviderMp3 : public SoundSourceProvider {
@@ -590,6 +590,35 @@ SoundSourceProxy::importTrackMetadataAndCoverImageFromFile(
             resetMissingTagMetadata);
 }
 
+//static
+std::optional<SoundSourceProxy::PreparedImport>
+SoundSourceProxy::prepareImportFromNewFile(
+        mixxx::FileAccess trackFileAccess) {
+    if (!trackFileAccess.info().checkFileExists()) {
+        return PreparedImport{};
+    }
+    {
+        // Only peek into the cache. Reading a file that is referenced
+        // by a cached track object requires to keep the cache locked
+        // and must be done by importTrackMetadataAndCoverImageFromFile().
+        GlobalTrackCacheLocker locker;
+        if (locker.lookupTrackByRef(TrackRef::fromFileInfo(trackFileAccess.info()))) {
+            return std::nullopt;
+        }
+    }
+    PreparedImport preparedImport;
+    // Starting with empty metadata resetMissingTagMetadata = false/true
+    // have the same effect
+    constexpr auto resetMissingTagMetadata = false;
+    std::tie(preparedImport.result, preparedImport.sourceSynchronizedAt) =
+            SoundSourceProxy(Track::newTemporary(std::move(trackFileAccess)))
+                    .importTrackMetadataAndCoverImage(
+                            &preparedImport.trackMetadata,
+                            &preparedImport.coverImage,
+                            resetMissingTagMetadata);
+    return preparedImport;
+}
+
 std::pair<mixxx::MetadataSource::ImportResult, QDateTime>
 SoundSourceProxy::importTrackMetadataAndCoverImage(
         mixxx::TrackMetadata* pTrackMetadata,
@@ -635,7 +664,8 @@ inline bool shouldImportSeratoTagsFromSource(
 
 SoundSourceProxy::UpdateTrackFromSourceResult SoundSourceProxy::updateTrackFromSource(
         UpdateTrackFromSourceMode mode,
-        const SyncTrackMetadataParams& syncParams) {
+        const SyncTrackMetadataParams& syncParams,
+        const PreparedImport* pPreparedImport) {
     DEBUG_ASSERT(m_pTrack);
 
     if (getUrl().isEmpty()) {
@@ -712,13 +742,23 @@ SoundSourceProxy::UpdateTrackFromSourceResult SoundSourceProxy::updateTrackFromS
         }
     }
 
+    // A prepared import has been parsed from a file without any existing
+    // metadata and must not be used for re-importing.
+    const bool usePreparedImport = pPreparedImport &&
+            sourceSyncStatus == mixxx::TrackRecord::SourceSyncStatus::Void;
+
     // Parse the tags stored in the audio file and the date and time when the
     // file has been last modified to detect future changes of the tags.
-    auto [metadataImportResult, sourceSynchronizedAt] =
-            importTrackMetadataAndCoverImage(
-                    &trackMetadata,
-                    pCoverImg,
-                    syncParams.resetMissingTagMetadataOnImport);
+    auto [metadataImportResult, sourceSynchronizedAt] = usePreparedImport
+            ? std::make_pair(pPreparedImport->result,
+                      pPreparedImport->sourceSynchronizedAt)
+            : importTrackMetadataAndCoverImage(
+                      &trackMetadata,
+                      pCoverImg,
+                      syncParams.resetMissingTagMetadataOnImport);
+    if (usePreparedImport) {
+        trackMetadata = pPreparedImport->trackMetadata;
+    }
     VERIFY_OR_DEBUG_ASSERT(!sourceSynchronizedAt.isValid() ||
             sourceSynchronizedAt.timeSpec() == Qt::UTC) {
         qWarning() << "Converting source synchronization time to UTC:" << sourceSynchronizedAt;
@@ -868,11 +908,14 @@ SoundSourceProxy::UpdateTrackFromSourceResult SoundSourceProxy::updateTrackFromS
 
     if (pCoverImg) {
         // If the pointer is not null then the cover art should be guessed
-        auto coverInfo =
-                CoverInfoGuesser().guessCoverInfo(
-                        m_pTrack->getFileInfo(),
-                        m_pTrack->getAlbum(),
-                        *pCoverImg);
+        auto coverInfo = usePreparedImport &&
+                        pPreparedImport->coverInfo.source == CoverInfo::GUESSED
+                ? pPreparedImport->coverInfo
+                : CoverInfoGuesser().guessCoverInfo(
+                          m_pTrack->getFileInfo(),
+                          m_pTrack->getAlbum(),
+                          usePreparedImport ? pPreparedImport->coverImage
+                                            : *pCoverImg);
         DEBUG_ASSERT(coverInfo.source == CoverInfo::GUESSED);
         m_pTrack->setCoverInfo(coverInfo);
     }
@@ -2,10 +2,15 @@
 
 #include <gtest/gtest_prod.h>
 
+#include <QDateTime>
+#include <QImage>
 #include <QMimeType>
+#include <optional>
 
+#include "library/coverart.h"
 #include "sources/soundsourceproviderregistry.h"
 #include "track/track_decl.h"
+#include "track/trackmetadata.h"
 
 namespace mixxx {
 
@@ -107,6 +112,35 @@ class SoundSourceProxy {
             QImage* pCoverImage,
             bool resetMissingTagMetadata);
 
+    /// Track metadata and guessed cover art that have been imported
+    /// from a file in advance, i.e. before the corresponding track
+    /// object has been created.
+    struct PreparedImport {
+        mixxx::MetadataSource::ImportResult result =
+                mixxx::MetadataSource::ImportResult::Unavailable;
+        QDateTime sourceSynchronizedAt;
+        mixxx::TrackMetadata trackMetadata;
+        /// The embedded cover image. Only needed for guessing the cover
+        /// info and should be released as soon as coverInfo has been
+        /// guessed, because prepared imports might be queued.
+        QImage coverImage;
+        CoverInfoRelative coverInfo;
+    };
+
+    /// Import track metadata and the embedded cover image from a file
+    /// that is not referenced by any track object yet, e.g. a new file
+    /// that has been discovered while scanning the library.
+    ///
+    /// Unlike importTrackMetadataAndCoverImageFromFile() this function
+    /// does not lock GlobalTrackCache while reading and multiple files
+    /// could be parsed concurrently. The cover info is left empty and
+    /// must be guessed by the caller. Returns nothing if the file is
+    /// already referenced by a cached track object.
+    ///
+    /// This function is thread-safe and can be invoked from any thread.
+    static std::optional<PreparedImport> prepareImportFromNewFile(
+            mixxx::FileAccess trackFileAccess);
+
     /// Import both track metadata and/or the cover image of the
     /// captured track object from the corresponding file.
     ///
@@ -174,10 +208,14 @@ class SoundSourceProxy {
     /// properly. The application log will contain warning messages for a detailed
     /// analysis in case unexpected behavior has been reported.
     ///
+    /// The optional prepared import is only used instead of parsing the
+    /// file again if the track's metadata has never been imported before.
+    ///
     /// Returns true if the track has been modified and false otherwise.
     UpdateTrackFromSourceResult updateTrackFromSource(
             UpdateTrackFromSourceMode mode,
-            const SyncTrackMetadataParams& syncParams);
+            const SyncTrackMetadataParams& syncParams,
+            const PreparedImport* pPreparedImport = nullptr);
 
     /// Opening the audio source through the proxy will update the
     /// audio properties of the corresponding track object. Returns
@@ -245,3 +283,5 @@ class SoundSourceProxy {
     // the corresponding track pointer. Don't pass it around!!
     mixxx::SoundSourcePointer m_pSoundSource;
 };
+
+Q_DECLARE_METATYPE(SoundSourceProxy::PreparedImport)
@@ -11,8 +11,14 @@ extern "C" {
 
 } // extern "C"
 
+#include <QThread>
+#include <QThreadPool>
+#include <QVarLengthArray>
+#include <QtConcurrentRun>
+
 #include "util/assert.h"
 #include "util/logger.h"
+#include "util/math.h"
 #include "util/sample.h"
 
 #if !defined(VERBOSE_DEBUG_LOG)
@@ -29,6 +35,20 @@ constexpr int kRequiredStreamCount = kNumStreams - 1; // Stem count doesn't incl
 
 const Logger kLogger("SoundSourceSTEM");
 
+// Decodes the stems of all stem sources in the process concurrently. The
+// reading thread decodes the first stem itself, so a few threads are
+// sufficient even with multiple stem decks.
+QThreadPool* stemDecodingThreadPool() {
+    static QThreadPool* s_pThreadPool = [] {
+        auto* pThreadPool = new QThreadPool();
+        pThreadPool->setObjectName(QStringLiteral("SoundSourceSTEM"));
+        pThreadPool->setMaxThreadCount(math_max(
+                kRequiredStreamCount - 1, QThread::idealThreadCount() / 2));
+        return pThreadPool;
+    }();
+    return s_pThreadPool;
+}
+
 } // anonymous namespace
 
 const QString SoundSourceProviderSTEM::kDisplayName = QStringLiteral("STEM with FFmpeg");
@@ -440,13 +460,6 @@ ReadableSampleFrames SoundSourceSTEM::readSampleFramesClamped(
     SINT stemSampleLength = m_pStereoStreams.front()->getSignalInfo().frames2samples(
             globalSampleFrames.frameLength());
 
-    // The same buffer is reused between requests tp prevent reallocation, but
-    // it will be reallocated if a larger chunk is requested and will keep the
-    // new maximum size
-    if (stemSampleLength > m_buffer.size()) {
-        m_buffer = SampleBuffer(stemSampleLength);
-    }
-
     ReadableSampleFrames read(globalSampleFrames.frameIndexRange(),
             SampleBuffer::ReadableSlice(
                     globalSampleFrames.writableData(),
@@ -466,32 +479,57 @@ ReadableSampleFrames SoundSourceSTEM::readSampleFramesClamped(
         return read;
     }
 
-    for (std::size_t streamIdx = 0; streamIdx < stemCount; streamIdx++) {
-        WritableSampleFrames currentStemFrame = WritableSampleFrames(
-                globalSampleFrames.frameIndexRange(),
-                SampleBuffer::WritableSlice(
-                        m_buffer.data(),
-                        stemSampleLength));
-        m_pStereoStreams[streamIdx]->readSampleFrames(currentStemFrame);
-
-        // TODO(XXX): currently, stem samples are interleaved and packed
-        // next to each other as such:
-        //    1L1R1L1R1L1R...2L2R2L2R2L2R2L2R......3L3R3L3R3L3R3L3R......4L4R4L4R4L4R4L4R....
-        //    Can FFmpeg decode as without having to use a decoder per
-        //    channel? 1LLLLLLLLLLLLLL....1RRRRRRRRR...2LLLLLLL...?
-        if (m_requestedChannelCount != mixxx::audio::ChannelCount::stereo()) {
-            // Change the sample layout to interleave all channels together
-            for (SINT i = 0; i < stemSampleLength / 2; i++) {
-                pBuffer[2 * stemCount * i + 2 * streamIdx] = m_buffer[2 * i];
-                pBuffer[2 * stemCount * i + 2 * streamIdx + 1] = m_buffer[2 * i + 1];
-            }
-        } else {
-            // Change the sample layout to mix all channels together
-            for (SINT i = 0; i < stemSampleLength / 2; i++) {
-                pBuffer[2 * i] += m_buffer[2 * i];
-                pBuffer[2 * i + 1] += m_buffer[2 * i + 1];
+    // The buffers are reused between requests to prevent reallocation, but
+    // they will be reallocated if a larger chunk is requested and will keep
+    // the new maximum size
+    m_streamBuffers.resize(stemCount);
+    for (auto& streamBuffer : m_streamBuffers) {
+        if (stemSampleLength > streamBuffer.size()) {
+            streamBuffer = SampleBuffer(stemSampleLength);
+        }
+    }
+
+    // Each stem is an independent FFmpeg stream, decode them concurrently
+    const auto decodeStream = [this, &globalSampleFrames, stemSampleLength](
+                                      std::size_t streamIdx) {
+        m_pStereoStreams[streamIdx]->readSampleFrames(
+                WritableSampleFrames(
+                        globalSampleFrames.frameIndexRange(),
+                        SampleBuffer::WritableSlice(
+                                m_streamBuffers[streamIdx].data(),
+                                stemSampleLength)));
+    };
+    QVarLengthArray<QFuture<void>, kRequiredStreamCount> decodingFutures;
+    for (std::size_t streamIdx = 1; streamIdx < stemCount; streamIdx++) {
+        decodingFutures.append(QtConcurrent::run(
+                stemDecodingThreadPool(), decodeStream, streamIdx));
+    }
+    decodeStream(0);
+    for (auto& decodingFuture : decodingFutures) {
+        decodingFuture.waitForFinished();
+    }
+
+    // TODO(XXX): currently, stem samples are interleaved and packed
+    // next to each other as such:
+    //    1L1R1L1R1L1R...2L2R2L2R2L2R2L2R......3L3R3L3R3L3R3L3R......4L4R4L4R4L4R4L4R....
+    //    Can FFmpeg decode as without having to use a decoder per
+    //    channel? 1LLLLLLLLLLLLLL....1RRRRRRRRR...2LLLLLLL...?
+    if (m_requestedChannelCount != mixxx::audio::ChannelCount::stereo()) {
+        // Change the sample layout to interleave all channels together in a
+        // single pass over the destination
+        for (SINT i = 0; i < stemSampleLength / 2; i++) {
+            CSAMPLE* pFrame = pBuffer + 2 * stemCount * i;
+            for (std::size_t streamIdx = 0; streamIdx < stemCount; streamIdx++) {
+                const CSAMPLE* pStreamBuffer = m_streamBuffers[streamIdx].data();
+                pFrame[2 * streamIdx] = pStreamBuffer[2 * i];
+                pFrame[2 * streamIdx + 1] = pStreamBuffer[2 * i + 1];
             }
         }
+    } else {
+        // Change the sample layout to mix all channels together
+        for (std::size_t streamIdx = 0; streamIdx < stemCount; streamIdx++) {
+            SampleUtil::add(pBuffer, m_streamBuffers[streamIdx].data(), stemSampleLength);
+        }
     }
 
     return read;
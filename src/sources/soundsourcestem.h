@@ -35,7 +35,9 @@ class SoundSourceSTEM : public SoundSource {
   private:
     // Contains each stem source, or the main mix if opened in stereo mode
     std::vector<std::unique_ptr<SoundSourceSingleSTEM>> m_pStereoStreams;
-    SampleBuffer m_buffer;
+    // One decoding buffer per stream, so that the streams can be decoded
+    // concurrently
+    std::vector<SampleBuffer> m_streamBuffers;
 
     mixxx::audio::ChannelCount m_requestedChannelCount;
 
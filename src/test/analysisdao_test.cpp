@@ -0,0 +1,84 @@
+#include "library/dao/analysisdao.h"
+
+#include <gtest/gtest.h>
+
+#include <QDir>
+
+#include "test/mixxxdbtest.h"
+
+namespace {
+
+const TrackId kTrackId = TrackId(QVariant(1));
+
+class AnalysisDaoTest : public MixxxDbTest {
+  protected:
+    AnalysisDaoTest()
+            : m_analysisDao(config()) {
+        m_analysisDao.initialize(dbConnection());
+    }
+
+    // Stores the waveform in the compressed protobuf format of older versions
+    int saveLegacyAnalysis(AnalysisDao::AnalysisType type) {
+        const Waveform waveform(44100, 44100, 441, -1, 0);
+        AnalysisDao::AnalysisInfo analysis;
+        analysis.trackId = kTrackId;
+        analysis.type = type;
+        analysis.description = QStringLiteral("legacy");
+        analysis.version = QStringLiteral("1");
+        analysis.data = waveform.toByteArray();
+        EXPECT_TRUE(m_analysisDao.saveAnalysis(&analysis));
+        return analysis.analysisId;
+    }
+
+    ConstWaveformPointer loadWaveform(AnalysisDao::AnalysisType type) {
+        const QList<AnalysisDao::AnalysisInfo> analyses =
+                m_analysisDao.getAnalysesForTrackByType(kTrackId, type);
+        if (analyses.size() != 1) {
+            return ConstWaveformPointer();
+        }
+        auto pWaveform = WaveformPointer::create(analyses.first().data);
+        pWaveform->setId(analyses.first().analysisId);
+        return pWaveform;
+    }
+
+    int analysisFileCount() const {
+        return QDir(config()->getSettingsPath() + QStringLiteral("/analysis/"))
+                .entryList(QDir::Files)
+                .size();
+    }
+
+    AnalysisDao m_analysisDao;
+};
+
+TEST_F(AnalysisDaoTest, MigrateLegacyWaveformsInPlace) {
+    const int waveformId = saveLegacyAnalysis(AnalysisDao::TYPE_WAVEFORM);
+    const int summaryId = saveLegacyAnalysis(AnalysisDao::TYPE_WAVESUMMARY);
+    ASSERT_EQ(2, analysisFileCount());
+
+    const ConstWaveformPointer pWaveform = loadWaveform(AnalysisDao::TYPE_WAVEFORM);
+    const ConstWaveformPointer pSummary = loadWaveform(AnalysisDao::TYPE_WAVESUMMARY);
+    ASSERT_TRUE(pWaveform);
+    ASSERT_TRUE(pSummary);
+    EXPECT_EQ(Waveform::SaveState::SavePending, pWaveform->saveState());
+    EXPECT_EQ(Waveform::SaveState::SavePending, pSummary->saveState());
+
+    // Saving twice must neither add rows nor files
+    m_analysisDao.saveTrackAnalyses(kTrackId, pWaveform, pSummary);
+    pWaveform->setSaveState(Waveform::SaveState::SavePending);
+    pSummary->setSaveState(Waveform::SaveState::SavePending);
+    m_analysisDao.saveTrackAnalyses(kTrackId, pWaveform, pSummary);
+    EXPECT_EQ(Waveform::SaveState::Saved, pWaveform->saveState());
+    EXPECT_EQ(Waveform::SaveState::Saved, pSummary->saveState());
+
+    const QList<AnalysisDao::AnalysisInfo> analyses =
+            m_analysisDao.getAnalysesForTrack(kTrackId);
+    ASSERT_EQ(2, analyses.size());
+    for (const auto& analysis : analyses) {
+        EXPECT_EQ(analysis.type == AnalysisDao::TYPE_WAVEFORM ? waveformId : summaryId,
+                analysis.analysisId);
+        EXPECT_TRUE(Waveform::isPackedByteArray(analysis.data));
+    }
+    EXPECT_EQ(2, analysisFileCount());
+}
+
+} // namespace
@@ -0,0 +1,208 @@
+#include "analyzer/analyzerbeats.h"
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "analyzer/analyzertrack.h"
+#include "analyzer/constants.h"
+#include "engine/engine.h"
+#include "test/mixxxtest.h"
+#include "track/track.h"
+#include "util/math.h"
+
+namespace {
+
+constexpr mixxx::audio::ChannelCount kChannelCount = mixxx::kEngineChannelOutputCount;
+constexpr mixxx::audio::SampleRate kSampleRate = mixxx::audio::SampleRate(44100);
+constexpr double kBpm = 120.0;
+constexpr double kTrackLengthSeconds = 90.0;
+
+class AnalyzerBeatsTest : public MixxxTest {
+  protected:
+    AnalyzerBeatsTest()
+            : analyzerBeats(config()) {
+    }
+
+    void SetUp() override {
+        const SINT frameLength = static_cast<SINT>(kTrackLengthSeconds * kSampleRate);
+        pTrack = Track::newTemporary();
+        pTrack->setAudioProperties(
+                kChannelCount,
+                kSampleRate,
+                mixxx::audio::Bitrate(),
+                mixxx::Duration::fromSeconds(kTrackLengthSeconds));
+
+        // Decaying 1 kHz clicks on every beat
+        trackSamples.resize(frameLength * kChannelCount);
+        const SINT framesPerBeat = static_cast<SINT>(60.0 / kBpm * kSampleRate);
+        const SINT clickFrames = kSampleRate / 50;
+        for (SINT beatFrame = 0; beatFrame < frameLength; beatFrame += framesPerBeat) {
+            for (SINT i = 0; i < clickFrames && beatFrame + i < frameLength; ++i) {
+                const auto sample = static_cast<CSAMPLE>(
+                        sin(2.0 * M_PI * 1000.0 * i / kSampleRate) *
+                        (1.0 - static_cast<double>(i) / clickFrames));
+                trackSamples[(beatFrame + i) * kChannelCount] = sample;
+                trackSamples[(beatFrame + i) * kChannelCount + 1] = sample;
+            }
+        }
+    }
+
+    // Returns the position in seconds when the first beats became
+    // available or a negative value if not before storing the results
+    double analyzeTrack(const AnalyzerTrack::Options& options) {
+        const SINT frameLength = static_cast<SINT>(trackSamples.size()) / kChannelCount;
+        EXPECT_TRUE(analyzerBeats.initialize(AnalyzerTrack(pTrack, options),
+                kSampleRate,
+                kChannelCount,
+                frameLength));
+        double firstBeatsSeconds = -1.0;
+        const SINT chunkSamples = mixxx::kAnalysisFramesPerChunk * kChannelCount;
+        for (SINT i = 0; i < static_cast<SINT>(trackSamples.size()); i += chunkSamples) {
+            EXPECT_TRUE(analyzerBeats.processSamples(&trackSamples[i],
+                    math_min(chunkSamples, static_cast<SINT>(trackSamples.size()) - i)));
+            if (firstBeatsSeconds < 0 && pTrack->getBeats()) {
+                firstBeatsSeconds = i / kChannelCount / kSampleRate.toDouble();
+                pFirstBeats = pTrack->getBeats();
+            }
+        }
+        analyzerBeats.storeResults(pTrack);
+        analyzerBeats.cleanup();
+        return firstBeatsSeconds;
+    }
+
+    static bool isProvisional(const mixxx::BeatsPointer& pBeats) {
+        return pBeats->getSubVersion().contains(QStringLiteral("provisional=1"));
+    }
+
+    AnalyzerBeats analyzerBeats;
+    TrackPointer pTrack;
+    // The beats that were published first by analyzeTrack()
+    mixxx::BeatsPointer pFirstBeats;
+    std::vector<CSAMPLE> trackSamples;
+};
+
+TEST_F(AnalyzerBeatsTest, NoProvisionalBeatsByDefault) {
+    EXPECT_GT(0.0, analyzeTrack(AnalyzerTrack::Options()));
+    ASSERT_TRUE(pTrack->getBeats());
+    EXPECT_NEAR(kBpm, pTrack->getBpm(), 1.0);
+}
+
+TEST_F(AnalyzerBeatsTest, PublishProvisionalBeats) {
+    AnalyzerTrack::Options options;
+    options.publishProvisionalResults = true;
+    const double firstBeatsSeconds = analyzeTrack(options);
+    EXPECT_NEAR(static_cast<double>(mixxx::kFastAnalysisSecondsToAnalyze),
+            firstBeatsSeconds,
+            1.0);
+    ASSERT_TRUE(pFirstBeats);
+    EXPECT_TRUE(isProvisional(pFirstBeats));
+
+    // Replaced by the result of the whole track
+    const auto pBeats = pTrack->getBeats();
+    ASSERT_TRUE(pBeats);
+    EXPECT_NE(pFirstBeats, pBeats);
+    EXPECT_FALSE(isProvisional(pBeats));
+    EXPECT_NEAR(kBpm, pTrack->getBpm(), 1.0);
+}
+
+TEST_F(AnalyzerBeatsTest, ReanalyzeAbortedProvisionalBeats) {
+    AnalyzerTrack::Options options;
+    options.publishProvisionalResults = true;
+    const SINT frameLength = static_cast<SINT>(trackSamples.size()) / kChannelCount;
+    ASSERT_TRUE(analyzerBeats.initialize(AnalyzerTrack(pTrack, options),
+            kSampleRate,
+            kChannelCount,
+            frameLength));
+    const SINT chunkSamples = mixxx::kAnalysisFramesPerChunk * kChannelCount;
+    for (SINT i = 0; i < static_cast<SINT>(trackSamples.size()) && !pTrack->getBeats();
+            i += chunkSamples) {
+        analyzerBeats.processSamples(&trackSamples[i],
+                math_min(chunkSamples, static_cast<SINT>(trackSamples.size()) - i));
+    }
+    // Aborted without storing the results
+    analyzerBeats.cleanup();
+    ASSERT_TRUE(pTrack->getBeats());
+    ASSERT_TRUE(isProvisional(pTrack->getBeats()));
+
+    // Analyzed again, even though re-analysis is disabled by default
+    analyzeTrack(AnalyzerTrack::Options());
+    ASSERT_TRUE(pTrack->getBeats());
+    EXPECT_FALSE(isProvisional(pTrack->getBeats()));
+    EXPECT_NEAR(kBpm, pTrack->getBpm(), 1.0);
+}
+
+TEST_F(AnalyzerBeatsTest, KeepModifiedProvisionalBeats) {
+    AnalyzerTrack::Options options;
+    options.publishProvisionalResults = true;
+    const SINT frameLength = static_cast<SINT>(trackSamples.size()) / kChannelCount;
+    ASSERT_TRUE(analyzerBeats.initialize(AnalyzerTrack(pTrack, options),
+            kSampleRate,
+            kChannelCount,
+            frameLength));
+    const SINT chunkSamples = mixxx::kAnalysisFramesPerChunk * kChannelCount;
+    bool modified = false;
+    for (SINT i = 0; i < static_cast<SINT>(trackSamples.size()); i += chunkSamples) {
+        analyzerBeats.processSamples(&trackSamples[i],
+                math_min(chunkSamples, static_cast<SINT>(trackSamples.size()) - i));
+        if (!modified && pTrack->getBeats()) {
+            // The user adjusts the provisional beat grid
+            EXPECT_TRUE(pTrack->trySetBpm(mixxx::Bpm(100.0)));
+            modified = true;
+        }
+    }
+    analyzerBeats.storeResults(pTrack);
+    analyzerBeats.cleanup();
+    EXPECT_TRUE(modified);
+    EXPECT_DOUBLE_EQ(100.0, pTrack->getBpm());
+}
+
+TEST_F(AnalyzerBeatsTest, DontReanalyzeModifiedProvisionalBeats) {
+    AnalyzerTrack::Options options;
+    options.publishProvisionalResults = true;
+    const SINT frameLength = static_cast<SINT>(trackSamples.size()) / kChannelCount;
+    ASSERT_TRUE(analyzerBeats.initialize(AnalyzerTrack(pTrack, options),
+            kSampleRate,
+            kChannelCount,
+            frameLength));
+    const SINT chunkSamples = mixxx::kAnalysisFramesPerChunk * kChannelCount;
+    bool modified = false;
+    for (SINT i = 0; i < static_cast<SINT>(trackSamples.size()); i += chunkSamples) {
+        analyzerBeats.processSamples(&trackSamples[i],
+                math_min(chunkSamples, static_cast<SINT>(trackSamples.size()) - i));
+        if (!modified && pTrack->getBeats()) {
+            // The user moves the provisional beat grid
+            const auto pTranslatedBeats = pTrack->getBeats()->tryTranslate(100);
+            ASSERT_TRUE(pTranslatedBeats);
+            EXPECT_TRUE(pTrack->trySetBeats(*pTranslatedBeats));
+            modified = true;
+        }
+    }
+    analyzerBeats.storeResults(pTrack);
+    analyzerBeats.cleanup();
+    ASSERT_TRUE(modified);
+    const auto pBeats = pTrack->getBeats();
+    ASSERT_TRUE(pBeats);
+    EXPECT_FALSE(isProvisional(pBeats));
+
+    // The adjusted beats are kept after reloading the track
+    TrackPointer pReloadedTrack = Track::newTemporary();
+    pReloadedTrack->setAudioProperties(
+            kChannelCount,
+            kSampleRate,
+            mixxx::audio::Bitrate(),
+            mixxx::Duration::fromSeconds(kTrackLengthSeconds));
+    const auto pReloadedBeats = mixxx::Beats::fromByteArray(kSampleRate,
+            pBeats->getVersion(),
+            pBeats->getSubVersion(),
+            pBeats->toByteArray());
+    ASSERT_TRUE(pReloadedBeats);
+    ASSERT_TRUE(pReloadedTrack->trySetBeats(pReloadedBeats));
+    EXPECT_FALSE(analyzerBeats.initialize(AnalyzerTrack(pReloadedTrack),
+            kSampleRate,
+            kChannelCount,
+            frameLength));
+    analyzerBeats.cleanup();
+}
+
+} // namespace
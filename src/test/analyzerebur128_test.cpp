@@ -0,0 +1,114 @@
+#include "analyzer/analyzerebur128.h"
+
+#include <ebur128.h>
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "analyzer/analyzertrack.h"
+#include "analyzer/constants.h"
+#include "engine/engine.h"
+#include "test/mixxxtest.h"
+#include "track/track.h"
+#include "util/math.h"
+
+namespace {
+
+constexpr mixxx::audio::ChannelCount kChannelCount = mixxx::kEngineChannelOutputCount;
+constexpr mixxx::audio::SampleRate kSampleRate = mixxx::audio::SampleRate(44100);
+constexpr double kTonePitchHz = 997.0;
+
+class AnalyzerEbur128Test : public MixxxTest {
+  protected:
+    AnalyzerEbur128Test()
+            : analyzerEbur128(config()) {
+    }
+
+    void SetUp() override {
+        pTrack = Track::newTemporary();
+    }
+
+    // Appends a sine tone to both channels. A full scale tone measures
+    // -3.01 LUFS per channel, i.e. 20 * log10(amplitude) LUFS for stereo.
+    void appendTone(double amplitude, double seconds) {
+        const double omega = 2.0 * M_PI * kTonePitchHz / kSampleRate;
+        const SINT numFrames = static_cast<SINT>(seconds * kSampleRate);
+        for (SINT i = 0; i < numFrames; ++i) {
+            const auto sample = static_cast<CSAMPLE>(amplitude * sin(omega * i));
+            trackSamples.push_back(sample);
+            trackSamples.push_back(sample);
+        }
+    }
+
+    double analyzeTrack() {
+        const SINT frameLength = static_cast<SINT>(trackSamples.size()) / kChannelCount;
+        pTrack->setAudioProperties(
+                kChannelCount,
+                kSampleRate,
+                mixxx::audio::Bitrate(),
+                mixxx::Duration::fromSeconds(frameLength / kSampleRate.toDouble()));
+        EXPECT_TRUE(analyzerEbur128.initialize(AnalyzerTrack(pTrack),
+                kSampleRate,
+                kChannelCount,
+                frameLength));
+        // Same chunk size as the analyzer thread
+        const SINT chunkSamples = mixxx::kAnalysisFramesPerChunk * kChannelCount;
+        for (SINT i = 0; i < static_cast<SINT>(trackSamples.size()); i += chunkSamples) {
+            EXPECT_TRUE(analyzerEbur128.processSamples(&trackSamples[i],
+                    math_min(chunkSamples, static_cast<SINT>(trackSamples.size()) - i)));
+        }
+        analyzerEbur128.storeResults(pTrack);
+        analyzerEbur128.cleanup();
+        return ratio2db(pTrack->getReplayGain().getRatio());
+    }
+
+    // Measures the track in a single pass for reference
+    double measureTrackSequentially() {
+        ebur128_state* pState = ebur128_init(kChannelCount, kSampleRate, EBUR128_MODE_I);
+        EXPECT_EQ(EBUR128_SUCCESS,
+                ebur128_add_frames_float(pState,
+                        trackSamples.data(),
+                        trackSamples.size() / kChannelCount));
+        double lufs = 0;
+        EXPECT_EQ(EBUR128_SUCCESS, ebur128_loudness_global(pState, &lufs));
+        ebur128_destroy(&pState);
+        return -18.0 - lufs;
+    }
+
+    AnalyzerEbur128 analyzerEbur128;
+    TrackPointer pTrack;
+    std::vector<CSAMPLE> trackSamples;
+};
+
+TEST_F(AnalyzerEbur128Test, ShortTone) {
+    // Shorter than a single segment
+    appendTone(0.1, 5.0);
+    // -20 LUFS -> ReplayGain 2.0 of -18 LUFS - -20 LUFS
+    EXPECT_NEAR(2.0, analyzeTrack(), 0.05);
+}
+
+TEST_F(AnalyzerEbur128Test, GatingAcrossSegments) {
+    // Quiet passages that are not aligned to the segments must be gated
+    // out relative to the loudness of the whole track
+    for (int i = 0; i < 4; ++i) {
+        appendTone(0.1, 7.3);
+        appendTone(0.001, 4.1);
+    }
+    const double expectedReplayGain = measureTrackSequentially();
+    // Blocks that span the transitions pass the relative gate
+    EXPECT_GT(expectedReplayGain, 2.0);
+    EXPECT_NEAR(expectedReplayGain, analyzeTrack(), 0.01);
+}
+
+TEST_F(AnalyzerEbur128Test, LoudnessOfAllSegments) {
+    // Both levels pass the relative gate, so the loudness is the mean
+    // over all segments
+    appendTone(0.1, 20.0);
+    appendTone(0.05, 20.0);
+    const double expectedReplayGain = measureTrackSequentially();
+    const double meanSquaredAmplitude = (0.1 * 0.1 + 0.05 * 0.05) / 2;
+    EXPECT_NEAR(-18.0 - 10 * log10(meanSquaredAmplitude), expectedReplayGain, 0.05);
+    EXPECT_NEAR(expectedReplayGain, analyzeTrack(), 0.01);
+}
+
+} // namespace
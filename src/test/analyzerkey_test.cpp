@@ -0,0 +1,158 @@
+#include "analyzer/analyzerkey.h"
+
+#include <gtest/gtest.h>
+
+#include <optional>
+#include <vector>
+
+#include "analyzer/analyzertrack.h"
+#include "analyzer/constants.h"
+#include "engine/engine.h"
+#include "proto/keys.pb.h"
+#include "test/mixxxtest.h"
+#include "track/track.h"
+#include "util/math.h"
+
+namespace {
+
+constexpr mixxx::audio::ChannelCount kChannelCount = mixxx::kEngineChannelOutputCount;
+constexpr mixxx::audio::SampleRate kSampleRate = mixxx::audio::SampleRate(44100);
+constexpr double kTrackLengthSeconds = 90.0;
+
+class AnalyzerKeyTest : public MixxxTest {
+  protected:
+    AnalyzerKeyTest()
+            : analyzerKey(KeyDetectionSettings(config())) {
+    }
+
+    void SetUp() override {
+        const SINT frameLength = static_cast<SINT>(kTrackLengthSeconds * kSampleRate);
+        pTrack = Track::newTemporary();
+        pTrack->setAudioProperties(
+                kChannelCount,
+                kSampleRate,
+                mixxx::audio::Bitrate(),
+                mixxx::Duration::fromSeconds(kTrackLengthSeconds));
+
+        // A sustained A major triad
+        const double frequencies[] = {220.0, 277.18, 329.63, 440.0};
+        trackSamples.resize(frameLength * kChannelCount);
+        for (SINT frame = 0; frame < frameLength; ++frame) {
+            double sample = 0.0;
+            for (const double frequency : frequencies) {
+                sample += 0.2 * sin(2.0 * M_PI * frequency * frame / kSampleRate);
+            }
+            trackSamples[frame * kChannelCount] = static_cast<CSAMPLE>(sample);
+            trackSamples[frame * kChannelCount + 1] = static_cast<CSAMPLE>(sample);
+        }
+    }
+
+    bool hasKey() const {
+        return pTrack->getKeys().getGlobalKey() != mixxx::track::io::key::INVALID;
+    }
+
+    // Continues processing the samples until the end of the track or until
+    // the first key has been published. Returns the position in seconds
+    // when the first key has been published or a negative value.
+    double processSamples() {
+        const SINT totalSamples = static_cast<SINT>(trackSamples.size());
+        const SINT chunkSamples = mixxx::kAnalysisFramesPerChunk * kChannelCount;
+        while (processedSamples < totalSamples) {
+            const SINT count = math_min(chunkSamples, totalSamples - processedSamples);
+            EXPECT_TRUE(analyzerKey.processSamples(&trackSamples[processedSamples], count));
+            processedSamples += count;
+            if (!firstKeys && hasKey()) {
+                firstKeys = pTrack->getKeys();
+                return processedSamples / kChannelCount / kSampleRate.toDouble();
+            }
+        }
+        return -1.0;
+    }
+
+    bool initialize(const AnalyzerTrack::Options& options) {
+        processedSamples = 0;
+        return analyzerKey.initialize(AnalyzerTrack(pTrack, options),
+                kSampleRate,
+                kChannelCount,
+                static_cast<SINT>(trackSamples.size()) / kChannelCount);
+    }
+
+    void analyzeTrack(const AnalyzerTrack::Options& options) {
+        ASSERT_TRUE(initialize(options));
+        processSamples();
+        analyzerKey.storeResults(pTrack);
+        analyzerKey.cleanup();
+    }
+
+    static bool isProvisional(const Keys& keys) {
+        return keys.getSubVersion().contains(QStringLiteral("provisional=1"));
+    }
+
+    AnalyzerKey analyzerKey;
+    TrackPointer pTrack;
+    std::vector<CSAMPLE> trackSamples;
+    SINT processedSamples = 0;
+    // The keys that were published first
+    std::optional<Keys> firstKeys;
+};
+
+TEST_F(AnalyzerKeyTest, NoProvisionalKeysByDefault) {
+    ASSERT_TRUE(initialize(AnalyzerTrack::Options()));
+    EXPECT_GT(0.0, processSamples());
+    analyzerKey.storeResults(pTrack);
+    analyzerKey.cleanup();
+    ASSERT_TRUE(hasKey());
+    EXPECT_FALSE(isProvisional(pTrack->getKeys()));
+}
+
+TEST_F(AnalyzerKeyTest, PublishProvisionalKeys) {
+    AnalyzerTrack::Options options;
+    options.publishProvisionalResults = true;
+    ASSERT_TRUE(initialize(options));
+    EXPECT_NEAR(static_cast<double>(mixxx::kFastAnalysisSecondsToAnalyze),
+            processSamples(),
+            1.0);
+    ASSERT_TRUE(firstKeys);
+    EXPECT_TRUE(isProvisional(*firstKeys));
+
+    // Replaced by the result of the whole track
+    processSamples();
+    analyzerKey.storeResults(pTrack);
+    analyzerKey.cleanup();
+    ASSERT_TRUE(hasKey());
+    EXPECT_FALSE(isProvisional(pTrack->getKeys()));
+    EXPECT_EQ(firstKeys->getGlobalKey(), pTrack->getKeys().getGlobalKey());
+}
+
+TEST_F(AnalyzerKeyTest, ReanalyzeAbortedProvisionalKeys) {
+    AnalyzerTrack::Options options;
+    options.publishProvisionalResults = true;
+    ASSERT_TRUE(initialize(options));
+    EXPECT_LE(0.0, processSamples());
+    // Aborted without storing the results
+    analyzerKey.cleanup();
+    ASSERT_TRUE(hasKey());
+    ASSERT_TRUE(isProvisional(pTrack->getKeys()));
+
+    // Analyzed again, even though re-analysis is disabled by default
+    analyzeTrack(AnalyzerTrack::Options());
+    ASSERT_TRUE(hasKey());
+    EXPECT_FALSE(isProvisional(pTrack->getKeys()));
+}
+
+TEST_F(AnalyzerKeyTest, KeepModifiedProvisionalKeys) {
+    AnalyzerTrack::Options options;
+    options.publishProvisionalResults = true;
+    ASSERT_TRUE(initialize(options));
+    EXPECT_LE(0.0, processSamples());
+    // The user changes the provisional key
+    pTrack->setKeyText(QStringLiteral("Eb"));
+    const auto modifiedKey = pTrack->getKeys().getGlobalKey();
+
+    processSamples();
+    analyzerKey.storeResults(pTrack);
+    analyzerKey.cleanup();
+    EXPECT_EQ(modifiedKey, pTrack->getKeys().getGlobalKey());
+}
+
+} // namespace
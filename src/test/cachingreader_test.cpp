@@ -0,0 +1,217 @@
+#include <gtest/gtest.h>
+
+#include <QElapsedTimer>
+#include <QThread>
+#include <memory>
+#include <vector>
+
+#include "engine/cachingreader/cachingreader.h"
+#include "engine/cachingreader/residentsamplepool.h"
+#include "engine/engineworkerscheduler.h"
+#include "test/mixxxtest.h"
+#include "track/track.h"
+#include "util/sample.h"
+
+namespace {
+
+// 30 s mono at 44.1 kHz, i.e. 162 chunks
+const QString kTrackFileName = QStringLiteral("sine-30.wav");
+
+constexpr SINT kFramesPerRead = 1024;
+
+} // namespace
+
+class CachingReaderTest : public MixxxTest {
+  protected:
+    void SetUp() override {
+        m_pScheduler = std::make_unique<EngineWorkerScheduler>();
+        m_pScheduler->start(QThread::HighPriority);
+    }
+
+    void TearDown() override {
+        m_pScheduler.reset();
+    }
+
+    std::unique_ptr<CachingReader> createReader(const QString& group,
+            SINT numberOfCachedChunks,
+            bool residentSamples) {
+        auto pReader = std::make_unique<CachingReader>(group,
+                config(),
+                mixxx::audio::ChannelCount::stereo(),
+                numberOfCachedChunks,
+                residentSamples);
+        pReader->setScheduler(m_pScheduler.get());
+        return pReader;
+    }
+
+    // Simulates engine callbacks until the condition is met
+    template<typename Condition>
+    bool processUntil(CachingReader* pReader, Condition condition) {
+        QElapsedTimer timer;
+        timer.start();
+        while (!condition() && timer.elapsed() < 10000) {
+            pReader->process();
+            m_pScheduler->runWorkers();
+            QThread::msleep(1);
+        }
+        return condition();
+    }
+
+    bool loadTrack(CachingReader* pReader) {
+        pReader->newTrack(Track::newTemporary(getTestDir().filePath(kTrackFileName)));
+        return processUntil(pReader, [pReader] {
+            return pReader->m_state.loadAcquire() == CachingReader::STATE_TRACK_LOADED;
+        });
+    }
+
+    static CachingReaderChunkForOwner* lookupChunk(
+            CachingReader* pReader, SINT chunkIndex) {
+        return pReader->lookupChunk(chunkIndex);
+    }
+
+    static bool isChunkReady(CachingReader* pReader, SINT chunkIndex) {
+        const auto* pChunk = lookupChunk(pReader, chunkIndex);
+        return pChunk && pChunk->getState() == CachingReaderChunkForOwner::READY;
+    }
+
+    static std::size_t freeChunkCount(const CachingReader& reader) {
+        return reader.m_freeChunks.size();
+    }
+
+    static CachingReaderChunkForOwner* allocateChunk(
+            CachingReader* pReader, SINT chunkIndex) {
+        return pReader->allocateChunk(chunkIndex);
+    }
+
+    static bool submitReadRequest(CachingReader* pReader,
+            CachingReaderChunkForOwner* pChunk) {
+        return pReader->submitReadRequest(pChunk, ReadRequestPriority::Preload);
+    }
+
+    static bool preloadNextResidentChunk(CachingReader* pReader) {
+        return pReader->preloadNextResidentChunk();
+    }
+
+    static SINT lastResidentChunkIndex(const CachingReader& reader) {
+        return reader.m_lastResidentChunkIndex;
+    }
+
+    static const ResidentSample* residentSample(const CachingReader& reader) {
+        return reader.m_pResidentSample;
+    }
+
+    std::unique_ptr<EngineWorkerScheduler> m_pScheduler;
+};
+
+TEST_F(CachingReaderTest, SubmitReadRequestFreesChunkIfQueueIsFull) {
+    auto pReader = createReader(QStringLiteral("[Test1]"), 8, false);
+    const std::size_t initialFreeChunks = freeChunkCount(*pReader);
+    ASSERT_EQ(8u, initialFreeChunks);
+
+    // The worker is never woken up, so the requests stay in the queue
+    SINT submittedRequests = 0;
+    for (SINT chunkIndex = 0; chunkIndex < 8; ++chunkIndex) {
+        auto* pChunk = allocateChunk(pReader.get(), chunkIndex);
+        ASSERT_NE(nullptr, pChunk);
+        if (!submitReadRequest(pReader.get(), pChunk)) {
+            // The rejected chunk has been returned to the free list
+            EXPECT_EQ(nullptr, lookupChunk(pReader.get(), chunkIndex));
+            break;
+        }
+        EXPECT_EQ(CachingReaderChunkForOwner::READ_PENDING, pChunk->getState());
+        ++submittedRequests;
+    }
+    EXPECT_GT(submittedRequests, 0);
+    EXPECT_LT(submittedRequests, 8);
+    EXPECT_EQ(initialFreeChunks - submittedRequests, freeChunkCount(*pReader));
+}
+
+TEST_F(CachingReaderTest, PreloadTrackThatFitsIntoCache) {
+    auto pReader = createReader(QStringLiteral("[Test1]"), 200, false);
+    ASSERT_TRUE(loadTrack(pReader.get()));
+    const SINT lastChunkIndex = lastResidentChunkIndex(*pReader);
+    ASSERT_GT(lastChunkIndex, 0);
+    EXPECT_EQ(nullptr, residentSample(*pReader));
+
+    // Without any hints, the chunks are preloaded one by one
+    const HintVector noHints;
+    EXPECT_TRUE(processUntil(pReader.get(), [&pReader, &noHints, lastChunkIndex] {
+        pReader->hintAndMaybeWake(noHints);
+        for (SINT chunkIndex = 0; chunkIndex <= lastChunkIndex; ++chunkIndex) {
+            if (!isChunkReady(pReader.get(), chunkIndex)) {
+                return false;
+            }
+        }
+        return true;
+    }));
+    EXPECT_FALSE(preloadNextResidentChunk(pReader.get()));
+
+    // Reading anywhere in the track never misses the cache
+    std::vector<CSAMPLE> buffer(kFramesPerRead * 2);
+    for (SINT chunkIndex = 0; chunkIndex < lastChunkIndex; chunkIndex += 16) {
+        EXPECT_EQ(CachingReader::ReadResult::AVAILABLE,
+                pReader->read(chunkIndex * CachingReaderChunk::kFrames * 2,
+                        kFramesPerRead * 2,
+                        false,
+                        buffer.data(),
+                        mixxx::audio::ChannelCount::stereo()));
+    }
+}
+
+TEST_F(CachingReaderTest, DontPreloadTrackThatExceedsCache) {
+    auto pReader = createReader(QStringLiteral("[Test1]"), 32, false);
+    ASSERT_TRUE(loadTrack(pReader.get()));
+    EXPECT_EQ(-1, lastResidentChunkIndex(*pReader));
+    EXPECT_FALSE(preloadNextResidentChunk(pReader.get()));
+}
+
+TEST_F(CachingReaderTest, ResidentSampleIsSharedAndBypassesCache) {
+    auto pReader1 = createReader(QStringLiteral("[Test1]"),
+            CachingReader::kResidentSamplesNumberOfCachedChunks,
+            true);
+    auto pReader2 = createReader(QStringLiteral("[Test2]"),
+            CachingReader::kResidentSamplesNumberOfCachedChunks,
+            true);
+    ASSERT_TRUE(loadTrack(pReader1.get()));
+    ASSERT_TRUE(loadTrack(pReader2.get()));
+    ASSERT_NE(nullptr, residentSample(*pReader1));
+    EXPECT_EQ(residentSample(*pReader1), residentSample(*pReader2));
+    EXPECT_EQ(1, ResidentSamplePool::sampleCount());
+
+    // Reading doesn't need any chunks, the track doesn't fit into the
+    // chunk cache
+    const SINT frameLength = residentSample(*pReader1)->frameIndexRange().length();
+    std::vector<CSAMPLE> buffer(kFramesPerRead * 2);
+    EXPECT_EQ(CachingReader::ReadResult::AVAILABLE,
+            pReader1->read((frameLength / 2) * 2,
+                    kFramesPerRead * 2,
+                    false,
+                    buffer.data(),
+                    mixxx::audio::ChannelCount::stereo()));
+    EXPECT_EQ(CachingReader::ReadResult::AVAILABLE,
+            pReader1->read((frameLength / 2) * 2,
+                    kFramesPerRead * 2,
+                    true,
+                    buffer.data(),
+                    mixxx::audio::ChannelCount::stereo()));
+    EXPECT_EQ(freeChunkCount(*pReader1),
+            static_cast<std::size_t>(CachingReader::kResidentSamplesNumberOfCachedChunks));
+
+    // The frames after the end are silent
+    SampleUtil::fill(buffer.data(), 1.0f, buffer.size());
+    EXPECT_EQ(CachingReader::ReadResult::PARTIALLY_AVAILABLE,
+            pReader1->read((frameLength - kFramesPerRead / 2) * 2,
+                    kFramesPerRead * 2,
+                    false,
+                    buffer.data(),
+                    mixxx::audio::ChannelCount::stereo()));
+    for (SINT i = kFramesPerRead; i < kFramesPerRead * 2; ++i) {
+        EXPECT_EQ(0.0f, buffer[i]);
+    }
+
+    // The sample is released with the last reader
+    pReader1.reset();
+    EXPECT_EQ(1, ResidentSamplePool::sampleCount());
+    pReader2.reset();
+    EXPECT_EQ(0, ResidentSamplePool::sampleCount());
+}
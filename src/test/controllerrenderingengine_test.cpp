@@ -1,5 +1,6 @@
 #include "controllers/rendering/controllerrenderingengine.h"
 
+#include <benchmark/benchmark.h>
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
@@ -51,3 +52,57 @@ TEST_F(ControllerRenderingEngineTest, createValidRendererWithSupportedTypes) {
         EXPECT_TRUE(screenTest.stop());
     }
 }
+
+TEST_F(ControllerRenderingEngineTest, damagedRect) {
+    QImage previousFrame(QSize(320, 240), QImage::Format_RGB16);
+    previousFrame.fill(Qt::black);
+    QImage frame = previousFrame.copy();
+    EXPECT_TRUE(ControllerRenderingEngine::damagedRect(previousFrame, frame).isEmpty());
+
+    frame.setPixel(10, 20, 0xFFFF);
+    EXPECT_EQ(QRect(10, 20, 1, 1), ControllerRenderingEngine::damagedRect(previousFrame, frame));
+
+    frame.setPixel(319, 5, 0x1234);
+    frame.setPixel(0, 239, 0x4321);
+    EXPECT_EQ(QRect(0, 5, 320, 235), ControllerRenderingEngine::damagedRect(previousFrame, frame));
+
+    // Frames of a different size or format are damaged entirely
+    EXPECT_EQ(frame.rect(), ControllerRenderingEngine::damagedRect(QImage(), frame));
+    EXPECT_EQ(frame.rect(),
+            ControllerRenderingEngine::damagedRect(
+                    previousFrame.convertToFormat(QImage::Format_RGB888), frame));
+}
+
+TEST_F(ControllerRenderingEngineTest, damagedRectMultiBytePixel) {
+    QImage previousFrame(QSize(64, 32), QImage::Format_RGB888);
+    previousFrame.fill(Qt::black);
+    QImage frame = previousFrame.copy();
+    // Only the last byte of the pixel changes
+    frame.setPixel(7, 3, qRgb(0, 0, 1));
+    frame.setPixel(8, 4, qRgb(1, 0, 0));
+    EXPECT_EQ(QRect(7, 3, 2, 2), ControllerRenderingEngine::damagedRect(previousFrame, frame));
+}
+
+namespace {
+
+// Consecutive frames of a fake 480x272 RGB16 screen, that differ in a square
+// of the given size, e.g. a moving playhead or a counter
+static void BM_ControllerRenderingEngine_DamagedRect(benchmark::State& state) {
+    const int damageSize = static_cast<int>(state.range(0));
+    QImage previousFrame(QSize(480, 272), QImage::Format_RGB16);
+    previousFrame.fill(Qt::darkGray);
+    QImage frame = previousFrame.copy();
+    frame.fill(Qt::white, QRect(100, 10, damageSize, damageSize));
+    QRect dirtyRect;
+    for (auto _ : state) {
+        dirtyRect = ControllerRenderingEngine::damagedRect(previousFrame, frame);
+        benchmark::DoNotOptimize(dirtyRect);
+        std::swap(previousFrame, frame);
+    }
+    // Bytes that a device with partial updates receives per frame, instead
+    // of the whole frame
+    state.counters["bytes_per_frame"] = dirtyRect.width() * dirtyRect.height() * 2;
+}
+BENCHMARK(BM_ControllerRenderingEngine_DamagedRect)->Range(1, 256);
+
+} // namespace
@@ -1,5 +1,6 @@
 #include "controllers/scripting/legacy/controllerscriptenginelegacy.h"
 
+#include <benchmark/benchmark.h>
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
@@ -11,6 +12,7 @@
 #include <QtDebug>
 #include <bit>
 #include <memory>
+#include <vector>
 
 #include "control/controlobject.h"
 #include "control/controlpotmeter.h"
@@ -78,6 +80,37 @@ class ControllerScriptEngineLegacyTest : public ControllerScriptEngineLegacy, pu
         return !evaluate(code).isError();
     }
 
+    // Simulates a jog wheel that sends a tick after each of the intervals
+    // in turn, while the scratch timer of the deck fires every millisecond.
+    // Returns the resulting scratch rate.
+    double scratchWithTickIntervals(const std::vector<int>& tickIntervalsMillis,
+            int durationMillis,
+            int pauseMillis = 0) {
+        auto* pInterface = qobject_cast<ControllerScriptInterfaceLegacy*>(
+                evaluate(QStringLiteral("engine")).toQObject());
+        EXPECT_NE(nullptr, pInterface);
+        if (!pInterface) {
+            return 0.0;
+        }
+        // 100 ticks per second at normal speed
+        EXPECT_TRUE(evaluateAndAssert(QStringLiteral(
+                "engine.scratchEnable(1, 100, 60, 1.0 / 8, (1.0 / 8) / 32, false)")));
+        const int timerId = pInterface->m_scratchTimers.key(1);
+        std::size_t intervalIndex = 0;
+        int millisUntilTick = tickIntervalsMillis[0];
+        for (int millis = 0; millis < durationMillis + pauseMillis; ++millis) {
+            mixxx::Time::addTestTime(1ms);
+            if (millis < durationMillis && --millisUntilTick == 0) {
+                EXPECT_TRUE(evaluateAndAssert(QStringLiteral("engine.scratchTick(1, 1)")));
+                intervalIndex = (intervalIndex + 1) % tickIntervalsMillis.size();
+                millisUntilTick = tickIntervalsMillis[intervalIndex];
+            }
+            pInterface->scratchProcess(timerId);
+        }
+        return ControlObject::get(ConfigKey(QStringLiteral("[Channel1]"),
+                QStringLiteral("scratch2")));
+    }
+
     void processEvents() {
         // QCoreApplication::processEvents() only processes events that were
         // queued when the method was called. Hence, all subsequent events that
@@ -104,7 +137,7 @@ class ControllerScriptEngineLegacyTest : public ControllerScriptEngineLegacy, pu
             const LegacyControllerMapping::ScreenInfo& screeninfo,
             const QImage& frame,
             const QDateTime& timestamp) {
-        handleScreenFrame(screeninfo, frame, timestamp);
+        handleScreenFrame(screeninfo, frame, timestamp, frame.rect());
     }
 #endif
 };
@@ -191,6 +224,54 @@ TEST_F(ControllerScriptEngineLegacyTest, getSetParameter) {
     EXPECT_DOUBLE_EQ(2.0, co->get());
 }
 
+TEST_F(ControllerScriptEngineLegacyTest, getControl) {
+    auto co = std::make_unique<ControlPotmeter>(ConfigKey("[Test]", "co"),
+            -10.0,
+            10.0);
+    EXPECT_TRUE(evaluateAndAssert(
+            "var control = engine.getControl('[Test]', 'co');"
+            "control.value = control.value + 5;"));
+    EXPECT_DOUBLE_EQ(5.0, co->get());
+
+    EXPECT_TRUE(evaluateAndAssert("control.parameter = 0.25;"));
+    EXPECT_DOUBLE_EQ(-5.0, co->get());
+
+    co->set(2.0);
+    EXPECT_DOUBLE_EQ(2.0, evaluate("control.value").toNumber());
+    EXPECT_DOUBLE_EQ(0.6, evaluate("control.parameter").toNumber());
+    EXPECT_EQ(QStringLiteral("[Test]"), evaluate("control.group").toString());
+    EXPECT_EQ(QStringLiteral("co"), evaluate("control.name").toString());
+
+    // NaNs are ignored
+    EXPECT_TRUE(evaluateAndAssert("control.value = NaN;"));
+    EXPECT_DOUBLE_EQ(2.0, co->get());
+
+    EXPECT_TRUE(evaluateAndAssert("control.reset();"));
+    EXPECT_DOUBLE_EQ(0.0, co->get());
+
+    EXPECT_TRUE(evaluate("engine.getControl('[Test]', 'missing')").isNull());
+}
+
+TEST_F(ControllerScriptEngineLegacyTest, softTakeover_getControl) {
+    auto co = std::make_unique<ControlPotmeter>(ConfigKey("[Test]", "co"),
+            -10.0,
+            10.0);
+    co->setParameter(0.0);
+    EXPECT_TRUE(evaluateAndAssert(
+            "engine.softTakeover('[Test]', 'co', true);"
+            "var control = engine.getControl('[Test]', 'co');"
+            "control.value = 0.0;"));
+    // The first set after enabling is always ignored.
+    EXPECT_DOUBLE_EQ(-10.0, co->get());
+
+    SoftTakeover::TestAccess::advanceTimePastThreshold();
+    co->setParameter(0.5);
+
+    // Ignore the change since it occurred after the threshold and is too large.
+    EXPECT_TRUE(evaluateAndAssert("control.value = -10.0;"));
+    EXPECT_DOUBLE_EQ(0.0, co->get());
+}
+
 TEST_F(ControllerScriptEngineLegacyTest, softTakeover_setValue) {
     auto co = std::make_unique<ControlPotmeter>(ConfigKey("[Test]", "co"),
             -10.0,
@@ -308,6 +389,44 @@ TEST_F(ControllerScriptEngineLegacyTest, trigger) {
     EXPECT_DOUBLE_EQ(1.0, pass->get());
 }
 
+class ControllerScriptEngineLegacyScratchTest : public ControllerScriptEngineLegacyTest {
+  protected:
+    ControllerScriptEngineLegacyScratchTest()
+            : m_scratch2(ConfigKey(QStringLiteral("[Channel1]"), QStringLiteral("scratch2"))),
+              m_scratch2Enable(ConfigKey(QStringLiteral("[Channel1]"),
+                      QStringLiteral("scratch2_enable"))),
+              m_trackLoaded(ConfigKey(QStringLiteral("[Channel1]"),
+                      QStringLiteral("track_loaded"))) {
+        m_trackLoaded.set(1.0);
+    }
+
+    ControlObject m_scratch2;
+    ControlObject m_scratch2Enable;
+    ControlObject m_trackLoaded;
+};
+
+TEST_F(ControllerScriptEngineLegacyScratchTest, scratchTick_FixedInterval) {
+    // One tick every 10 ms is the normal speed
+    EXPECT_NEAR(1.0, scratchWithTickIntervals({10}, 2000), 0.05);
+    EXPECT_DOUBLE_EQ(1.0, m_scratch2Enable.get());
+}
+
+TEST_F(ControllerScriptEngineLegacyScratchTest, scratchTick_FixedIntervalDoubleSpeed) {
+    EXPECT_NEAR(2.0, scratchWithTickIntervals({5}, 2000), 0.1);
+}
+
+TEST_F(ControllerScriptEngineLegacyScratchTest, scratchTick_IrregularInterval) {
+    // Controllers send their messages at an irregular rate, the average
+    // speed is still the normal speed
+    EXPECT_NEAR(1.0, scratchWithTickIntervals({5, 15}, 2000), 0.1);
+    EXPECT_NEAR(1.0, scratchWithTickIntervals({3, 17, 10}, 2000), 0.1);
+}
+
+TEST_F(ControllerScriptEngineLegacyScratchTest, scratchTick_StoppedWheel) {
+    // The rate drops to zero after the ticks have stopped
+    EXPECT_NEAR(0.0, scratchWithTickIntervals({10}, 2000, 500), 0.01);
+}
+
 // ControllerEngine::connectControl has a lot of quirky, inconsistent legacy behaviors
 // depending on how it is invoked, so we need a lot of tests to make sure old scripts
 // do not break.
@@ -847,3 +966,48 @@ TEST_F(ControllerScriptEngineLegacyTest, screenWillSentRawDataIfConfigured) {
     ASSERT_ALL_EXPECTED_MSG();
 }
 #endif
+
+namespace {
+
+class BenchmarkScriptEngineLegacy : public ControllerScriptEngineLegacy {
+  public:
+    BenchmarkScriptEngineLegacy()
+            : ControllerScriptEngineLegacy(nullptr, logger) {
+        initialize();
+    }
+
+    QJSValue evaluate(const QString& code) {
+        return jsEngine()->evaluate(code);
+    }
+};
+
+void runScriptBenchmark(benchmark::State& state, const QString& setup, const QString& code) {
+    ControlPotmeter potmeter(ConfigKey("[Benchmark]", "co"), 0.0, 1.0);
+    BenchmarkScriptEngineLegacy engine;
+    engine.evaluate(setup);
+    QJSValue function = engine.evaluate(
+            QStringLiteral("(function () { for (var i = 0; i < 1000; ++i) { %1 } })")
+                    .arg(code));
+    for (auto _ : state) {
+        function.call();
+    }
+    // Reported as accesses per second
+    state.SetItemsProcessed(state.iterations() * 1000);
+}
+
+} // namespace
+
+static void BM_ControllerScriptEngineLegacy_GetSetValue(benchmark::State& state) {
+    runScriptBenchmark(state,
+            QString(),
+            QStringLiteral("engine.setValue('[Benchmark]', 'co', "
+                           "1 - engine.getValue('[Benchmark]', 'co'));"));
+}
+BENCHMARK(BM_ControllerScriptEngineLegacy_GetSetValue);
+
+static void BM_ControllerScriptEngineLegacy_GetControlValue(benchmark::State& state) {
+    runScriptBenchmark(state,
+            QStringLiteral("var control = engine.getControl('[Benchmark]', 'co');"),
+            QStringLiteral("control.value = 1 - control.value;"));
+}
+BENCHMARK(BM_ControllerScriptEngineLegacy_GetControlValue);
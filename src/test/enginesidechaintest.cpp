@@ -0,0 +1,179 @@
+#include <gtest/gtest.h>
+
+#include <QDeadlineTimer>
+#include <QMutex>
+#include <QWaitCondition>
+#include <vector>
+
+#include "engine/engine.h"
+#include "engine/sidechain/enginesidechain.h"
+#include "engine/sidechain/sidechainworker.h"
+#include "test/mixxxtest.h"
+#include "util/compatibility/qmutex.h"
+
+namespace {
+
+constexpr int kFramesPerWrite = 512;
+constexpr int kSamplesPerWrite = kFramesPerWrite * mixxx::kEngineChannelOutputCount;
+constexpr std::size_t kBufferSize = EngineSideChain::SIDECHAIN_BUFFER_SIZE;
+// Only reached if the test fails
+constexpr qint64 kTimeoutMillis = 10000;
+
+class ReceivedSamples {
+  public:
+    explicit ReceivedSamples(bool blocked = false)
+            : m_blocked(blocked),
+              m_processing(false) {
+    }
+
+    void append(const CSAMPLE* pBuffer, std::size_t bufferSize) {
+        const auto locker = lockMutex(&m_mutex);
+        m_processing = true;
+        m_changed.wakeAll();
+        while (m_blocked) {
+            m_changed.wait(&m_mutex);
+        }
+        m_samples.insert(m_samples.end(), pBuffer, pBuffer + bufferSize);
+        m_changed.wakeAll();
+    }
+
+    void unblock() {
+        const auto locker = lockMutex(&m_mutex);
+        m_blocked = false;
+        m_changed.wakeAll();
+    }
+
+    bool waitUntilProcessing() {
+        return waitFor([this] { return m_processing; });
+    }
+
+    // Waits until at least minSize samples have been received
+    bool waitForSize(std::size_t minSize) {
+        return waitFor([this, minSize] { return m_samples.size() >= minSize; });
+    }
+
+    std::size_t size() {
+        const auto locker = lockMutex(&m_mutex);
+        return m_samples.size();
+    }
+
+    // Only safe after the worker has been destroyed
+    const std::vector<CSAMPLE>& samples() const {
+        return m_samples;
+    }
+
+  private:
+    template<typename Predicate>
+    bool waitFor(Predicate predicate) {
+        const auto locker = lockMutex(&m_mutex);
+        QDeadlineTimer deadline(kTimeoutMillis);
+        while (!predicate()) {
+            if (!m_changed.wait(&m_mutex, deadline)) {
+                return predicate();
+            }
+        }
+        return true;
+    }
+
+    QMutex m_mutex;
+    QWaitCondition m_changed;
+    std::vector<CSAMPLE> m_samples;
+    bool m_blocked;
+    bool m_processing;
+};
+
+class TestSideChainWorker : public SideChainWorker {
+  public:
+    explicit TestSideChainWorker(ReceivedSamples* pReceived)
+            : m_pReceived(pReceived) {
+    }
+
+    void process(const CSAMPLE* pBuffer, const std::size_t bufferSize) override {
+        m_pReceived->append(pBuffer, bufferSize);
+    }
+
+    void shutdown() override {
+    }
+
+  private:
+    ReceivedSamples* const m_pReceived;
+};
+
+} // namespace
+
+class EngineSideChainTest : public MixxxTest {
+  protected:
+    EngineSideChainTest()
+            : m_sidechainMix(kSamplesPerWrite),
+              m_writtenSamples(0) {
+    }
+
+    // Writes the next samples of a continuous stream, but only after the
+    // worker has made room for them, i.e. it never drops any samples
+    // unless it is blocked.
+    void writeNextSamples(EngineSideChain* pSideChain, ReceivedSamples* pFast) {
+        if (m_writtenSamples + kSamplesPerWrite > kBufferSize) {
+            ASSERT_TRUE(pFast->waitForSize(m_writtenSamples + kSamplesPerWrite - kBufferSize));
+        }
+        for (auto& sample : m_sidechainMix) {
+            sample = static_cast<CSAMPLE>(m_writtenSamples++ % 65536);
+        }
+        pSideChain->writeSamples(m_sidechainMix.data(), kFramesPerWrite);
+    }
+
+    static quint64 droppedSamples(
+            const EngineSideChain& sideChain, const SideChainWorker* pWorker) {
+        return sideChain.droppedSamples(pWorker);
+    }
+
+    static void expectContinuousStream(const std::vector<CSAMPLE>& samples) {
+        for (std::size_t i = 0; i < samples.size(); ++i) {
+            ASSERT_EQ(static_cast<CSAMPLE>(i % 65536), samples[i]) << "i=" << i;
+        }
+    }
+
+    std::vector<CSAMPLE> m_sidechainMix;
+    std::size_t m_writtenSamples;
+};
+
+TEST_F(EngineSideChainTest, SlowWorkerDoesNotBlockOthers) {
+    ReceivedSamples fast;
+    ReceivedSamples slow(true);
+
+    {
+        EngineSideChain sideChain(config(), m_sidechainMix.data());
+        auto* pFastWorker = new TestSideChainWorker(&fast);
+        auto* pSlowWorker = new TestSideChainWorker(&slow);
+        sideChain.addSideChainWorker(pFastWorker);
+        sideChain.addSideChainWorker(pSlowWorker);
+
+        // The fast worker continues to receive all samples while the slow
+        // worker is stuck in process()
+        while (m_writtenSamples < 4 * kBufferSize) {
+            writeNextSamples(&sideChain, &fast);
+        }
+        ASSERT_TRUE(slow.waitUntilProcessing());
+        EXPECT_EQ(0u, slow.size());
+        EXPECT_EQ(0u, droppedSamples(sideChain, pFastWorker));
+        // Only the slow worker misses the samples that didn't fit into its
+        // FIFO
+        EXPECT_GE(droppedSamples(sideChain, pSlowWorker), 2 * kBufferSize);
+
+        // The slow worker continues after it has recovered
+        slow.unblock();
+        ASSERT_TRUE(slow.waitForSize(kBufferSize / 2));
+        while (m_writtenSamples < 6 * kBufferSize) {
+            writeNextSamples(&sideChain, &fast);
+        }
+        EXPECT_EQ(0u, droppedSamples(sideChain, pFastWorker));
+    }
+
+    // The fast worker received the whole stream except for the samples
+    // that were still pending at shutdown
+    EXPECT_GE(fast.samples().size(), m_writtenSamples - kBufferSize);
+    expectContinuousStream(fast.samples());
+    // The slow worker received the beginning of the stream
+    ASSERT_GE(slow.samples().size(), kBufferSize / 2);
+    expectContinuousStream(std::vector<CSAMPLE>(
+            slow.samples().begin(), slow.samples().begin() + kBufferSize / 2));
+}
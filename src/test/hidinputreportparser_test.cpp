@@ -0,0 +1,118 @@
+#include "controllers/hid/hidinputreportparser.h"
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "control/controlpotmeter.h"
+#include "test/mixxxtest.h"
+
+namespace {
+
+QByteArray makeReport(std::initializer_list<quint8> bytes) {
+    QByteArray report;
+    for (const auto byte : bytes) {
+        report.append(static_cast<char>(byte));
+    }
+    return report;
+}
+
+class HidInputReportParserTest : public MixxxTest {
+};
+
+TEST_F(HidInputReportParserTest, SetControlParameter) {
+    const ConfigKey key(QStringLiteral("[Test]"), QStringLiteral("pot"));
+    ControlPotmeter potmeter(key, 0.0, 10.0);
+
+    HidInputReportParser parser;
+    HidInputReportParser::Field field;
+    field.reportId = 1;
+    field.offset = 2;
+    field.control = key;
+    ASSERT_TRUE(parser.addField(field));
+
+    // The first report only initializes the field
+    EXPECT_TRUE(parser.parse(makeReport({0x01, 0x00, 0xFF})));
+    EXPECT_DOUBLE_EQ(0.0, potmeter.get());
+
+    EXPECT_TRUE(parser.parse(makeReport({0x01, 0x00, 0x33})));
+    EXPECT_DOUBLE_EQ(2.0, potmeter.get());
+
+    // Reports of other ReportIDs are not handled
+    EXPECT_FALSE(parser.parse(makeReport({0x02, 0x00, 0xFF})));
+    EXPECT_DOUBLE_EQ(2.0, potmeter.get());
+}
+
+TEST_F(HidInputReportParserTest, DispatchChangedBitsOnly) {
+    std::vector<std::pair<int, double>> calls;
+    HidInputReportParser parser;
+    for (int bit = 0; bit < 8; ++bit) {
+        HidInputReportParser::Field field;
+        field.offset = 1;
+        field.bitmask = 1u << bit;
+        field.callback = [&calls, bit](double value) {
+            calls.emplace_back(bit, value);
+        };
+        ASSERT_TRUE(parser.addField(field));
+    }
+
+    EXPECT_TRUE(parser.parse(makeReport({0x00, 0x00, 0x00})));
+    EXPECT_TRUE(calls.empty());
+
+    EXPECT_TRUE(parser.parse(makeReport({0x00, 0x24, 0x00})));
+    ASSERT_EQ(2u, calls.size());
+    EXPECT_EQ(std::make_pair(2, 1.0), calls[0]);
+    EXPECT_EQ(std::make_pair(5, 1.0), calls[1]);
+
+    // Unrelated bytes and identical reports don't dispatch anything
+    calls.clear();
+    EXPECT_TRUE(parser.parse(makeReport({0x00, 0x24, 0x7F})));
+    EXPECT_TRUE(parser.parse(makeReport({0x00, 0x24, 0x7F})));
+    EXPECT_TRUE(calls.empty());
+
+    EXPECT_TRUE(parser.parse(makeReport({0x00, 0x04, 0x7F})));
+    ASSERT_EQ(1u, calls.size());
+    EXPECT_EQ(std::make_pair(5, 0.0), calls[0]);
+}
+
+TEST_F(HidInputReportParserTest, UnpackLittleEndian) {
+    std::vector<double> values;
+    HidInputReportParser parser;
+    HidInputReportParser::Field field;
+    field.reportId = 3;
+    field.offset = 1;
+    field.pack = HidInputReportParser::Pack::Int16;
+    field.callback = [&values](double value) {
+        values.push_back(value);
+    };
+    ASSERT_TRUE(parser.addField(field));
+    field.offset = 3;
+    field.pack = HidInputReportParser::Pack::UInt32;
+    ASSERT_TRUE(parser.addField(field));
+
+    EXPECT_TRUE(parser.parse(makeReport({0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00})));
+    EXPECT_TRUE(parser.parse(makeReport({0x03, 0xFE, 0xFF, 0x78, 0x56, 0x34, 0x12})));
+    ASSERT_EQ(2u, values.size());
+    EXPECT_DOUBLE_EQ(-2.0, values[0]);
+    EXPECT_DOUBLE_EQ(305419896.0, values[1]);
+
+    // Fields beyond the end of a short report are skipped
+    values.clear();
+    EXPECT_TRUE(parser.parse(makeReport({0x03, 0x01, 0x00})));
+    ASSERT_EQ(1u, values.size());
+    EXPECT_DOUBLE_EQ(1.0, values[0]);
+}
+
+TEST_F(HidInputReportParserTest, RejectInvalidFields) {
+    HidInputReportParser parser;
+    HidInputReportParser::Field field;
+    field.offset = 1;
+    // Neither callback nor control
+    EXPECT_FALSE(parser.addField(field));
+    // Unknown control
+    field.control = ConfigKey(QStringLiteral("[Test]"), QStringLiteral("missing"));
+    EXPECT_FALSE(parser.addField(field));
+    EXPECT_TRUE(parser.isEmpty());
+}
+
+} // namespace
@@ -95,6 +95,20 @@ class HotcueControlTest : public BaseSignalPathTest {
         ProcessBuffer();
     }
 
+    // Returns the frames of the hotcue hints in the order they are hinted
+    QList<SINT> hotcueHintFrames() {
+        HintVector hints;
+        m_pChannel1->getEngineBuffer()->m_pCueControl->hintReader(&hints);
+        QList<SINT> frames;
+        for (const auto& hint : std::as_const(hints)) {
+            if (hint.type == Hint::Type::HotCue) {
+                EXPECT_EQ(Hint::kFrameCountSpeculative, hint.frameCount);
+                frames.append(hint.frame);
+            }
+        }
+        return frames;
+    }
+
     std::unique_ptr<ControlProxy> m_pPlay;
     std::unique_ptr<ControlProxy> m_pBeatloopActivate;
     std::unique_ptr<ControlProxy> m_pBeatloopSize;
@@ -262,6 +276,33 @@ TEST_F(HotcueControlTest, SetCueManual) {
                          .isValid());
 }
 
+TEST_F(HotcueControlTest, HintRecentlyUsedHotcuesFirst) {
+    createAndLoadFakeTrack();
+    m_pQuantizeEnabled->set(0);
+
+    constexpr mixxx::audio::FramePos hotcue1Position(100);
+    constexpr mixxx::audio::FramePos hotcue2Position(1000);
+
+    setCurrentFramePosition(hotcue1Position);
+    m_pHotcue1SetCue->set(1);
+    m_pHotcue1SetCue->set(0);
+    setCurrentFramePosition(hotcue2Position);
+    m_pHotcue2Activate->set(1);
+    m_pHotcue2Activate->set(0);
+
+    // Unused hotcues are hinted in the order of their index
+    EXPECT_EQ(QList<SINT>({100, 1000}), hotcueHintFrames());
+
+    // Previewing hotcue 2 makes it the most recently used one
+    m_pHotcue2Activate->set(1);
+    m_pHotcue2Activate->set(0);
+    EXPECT_EQ(QList<SINT>({1000, 100}), hotcueHintFrames());
+
+    m_pHotcue1Goto->set(1);
+    m_pHotcue1Goto->set(0);
+    EXPECT_EQ(QList<SINT>({100, 1000}), hotcueHintFrames());
+}
+
 TEST_F(HotcueControlTest, SetLoopAutoNoRedundantLoopCue) {
     createAndLoadFakeTrack();
 
@@ -1,6 +1,9 @@
+#include <benchmark/benchmark.h>
 #include <gmock/gmock.h>
 
 #include <QScopedPointer>
+#include <memory>
+#include <vector>
 
 #include "control/controlpotmeter.h"
 #include "control/controlpushbutton.h"
@@ -100,6 +103,27 @@ class MidiControllerTest : public MixxxTest {
         m_pController->m_pScriptEngineLegacy->shutdown();
     }
 
+    void setControllerOpen(bool open) {
+        m_pController->setOpen(open);
+    }
+
+    void queueOutputMessage(unsigned char status, unsigned char control, unsigned char value) {
+        m_pController->queueOutputMessage(status, control, value);
+    }
+
+    void flushOutputFrame() {
+        m_pController->flushOutputFrame();
+    }
+
+    void sendRaw(const QList<int>& data) {
+        m_pController->send(data);
+    }
+
+    // Calls the implementation of the base class that is mocked otherwise
+    void closeMidiController() {
+        m_pController->MidiController::close();
+    }
+
     std::shared_ptr<LegacyMidiControllerMapping> m_pMapping;
     QScopedPointer<MockMidiController> m_pController;
 };
@@ -674,3 +698,97 @@ TEST_F(MidiControllerTest, JSInputHandler_ControllerShutdownSlot) {
     shutdownController();
     EXPECT_EQ(getControllerMapping()->getInputMappings().count(), 0);
 }
+
+TEST_F(MidiControllerTest, ReceiveMessage_ControlCreatedAfterMapping) {
+    ConfigKey key("[Channel1]", "test_pot");
+    unsigned char channel = 0x01;
+    unsigned char control = 0x10;
+
+    addMapping(MidiInputMapping(MidiKey(MidiUtils::statusFromOpCodeAndChannel(
+                                                MidiOpCode::ControlChange, channel),
+                                        control),
+            MidiOptions(),
+            key));
+    m_pController->setMapping(m_pMapping->clone());
+
+    // The control is resolved when the first message arrives
+    {
+        ControlPotmeter potmeter(key, 0.0, 1.0);
+        receivedShortMessage(MidiOpCode::ControlChange, channel, control, 0x7F);
+        EXPECT_DOUBLE_EQ(1.0, potmeter.get());
+    }
+
+    // A recreated control replaces the resolved one
+    ControlPotmeter potmeter(key, 0.0, 1.0);
+    receivedShortMessage(MidiOpCode::ControlChange, channel, control, 0x7F);
+    EXPECT_DOUBLE_EQ(1.0, potmeter.get());
+}
+
+TEST_F(MidiControllerTest, Output_CloseFlushesPendingFrame) {
+    setControllerOpen(true);
+    queueOutputMessage(0x90, 0x01, 0x7F);
+    queueOutputMessage(0x90, 0x02, 0x7F);
+
+    // Sent before the port is closed by the sub-class
+    EXPECT_CALL(*m_pController, sendShortMsg(0x90, 0x01, 0x7F));
+    EXPECT_CALL(*m_pController, sendShortMsg(0x90, 0x02, 0x7F));
+    closeMidiController();
+    setControllerOpen(false);
+}
+
+TEST_F(MidiControllerTest, Output_RawSendResetsSentValues) {
+    setControllerOpen(true);
+    EXPECT_CALL(*m_pController, sendShortMsg(0x90, 0x01, 0x7F)).Times(2);
+    EXPECT_CALL(*m_pController, sendBytes(testing::_)).WillOnce(testing::Return(true));
+
+    queueOutputMessage(0x90, 0x01, 0x7F);
+    flushOutputFrame();
+    // A redundant message is dropped
+    queueOutputMessage(0x90, 0x01, 0x7F);
+    flushOutputFrame();
+
+    // The SysEx message might have switched the LED off
+    sendRaw({0xF0, 0x00, 0x20, 0x29, 0xF7});
+    queueOutputMessage(0x90, 0x01, 0x7F);
+    flushOutputFrame();
+    setControllerOpen(false);
+}
+
+namespace {
+
+class BenchmarkMidiController : public MockMidiController {
+  public:
+    using MidiController::receivedShortMessage;
+};
+
+} // namespace
+
+static void BM_MidiController_ReceiveControlChange(benchmark::State& state) {
+    const int numControls = static_cast<int>(state.range(0));
+    auto pMapping = std::make_shared<LegacyMidiControllerMapping>();
+    std::vector<std::unique_ptr<ControlPotmeter>> controls;
+    for (int i = 0; i < numControls; ++i) {
+        const ConfigKey key(QStringLiteral("[Benchmark]"), QStringLiteral("pot_%1").arg(i));
+        controls.push_back(std::make_unique<ControlPotmeter>(key, 0.0, 1.0));
+        const MidiKey midiKey(MidiUtils::statusFromOpCodeAndChannel(
+                                      MidiOpCode::ControlChange, i / 128),
+                i % 128);
+        pMapping->addInputMapping(midiKey.key, MidiInputMapping(midiKey, MidiOptions(), key));
+    }
+    BenchmarkMidiController controller;
+    controller.setMapping(pMapping);
+
+    const auto timestamp = mixxx::Time::elapsed();
+    int i = 0;
+    for (auto _ : state) {
+        controller.receivedShortMessage(
+                MidiUtils::statusFromOpCodeAndChannel(MidiOpCode::ControlChange, i / 128),
+                i % 128,
+                i & 0x7F,
+                timestamp);
+        i = (i + 1) % numControls;
+    }
+    // Reported as messages per second
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_MidiController_ReceiveControlChange)->Range(16, 2048);
@@ -0,0 +1,89 @@
+#include "controllers/midi/midioutputframe.h"
+
+#include <gtest/gtest.h>
+
+#include <tuple>
+#include <vector>
+
+namespace {
+
+using Message = std::tuple<int, int, int>;
+
+class MidiOutputFrameTest : public testing::Test {
+  protected:
+    int flush(int maxMessages = 1024) {
+        return m_frame.flush(maxMessages,
+                [this](unsigned char status, unsigned char control, unsigned char value) {
+                    m_sent.emplace_back(status, control, value);
+                });
+    }
+
+    MidiOutputFrame m_frame;
+    std::vector<Message> m_sent;
+};
+
+TEST_F(MidiOutputFrameTest, LatestValueWins) {
+    EXPECT_TRUE(m_frame.queueMessage(0x90, 0x01, 0x7F));
+    EXPECT_TRUE(m_frame.queueMessage(0x90, 0x02, 0x7F));
+    EXPECT_TRUE(m_frame.queueMessage(0x90, 0x01, 0x00));
+    EXPECT_TRUE(m_frame.queueMessage(0x90, 0x01, 0x40));
+    EXPECT_TRUE(m_frame.hasPendingMessages());
+
+    EXPECT_EQ(2, flush());
+    EXPECT_EQ((std::vector<Message>{{0x90, 0x01, 0x40}, {0x90, 0x02, 0x7F}}), m_sent);
+    EXPECT_FALSE(m_frame.hasPendingMessages());
+}
+
+TEST_F(MidiOutputFrameTest, DropRedundantMessages) {
+    m_frame.queueMessage(0xB0, 0x10, 0x01);
+    flush();
+    m_sent.clear();
+
+    EXPECT_FALSE(m_frame.queueMessage(0xB0, 0x10, 0x01));
+    // Changed and reverted within a single frame
+    EXPECT_TRUE(m_frame.queueMessage(0xB0, 0x10, 0x02));
+    EXPECT_FALSE(m_frame.queueMessage(0xB0, 0x10, 0x01));
+    EXPECT_EQ(0, flush());
+    EXPECT_TRUE(m_sent.empty());
+
+    m_frame.clear();
+    EXPECT_TRUE(m_frame.queueMessage(0xB0, 0x10, 0x01));
+}
+
+TEST_F(MidiOutputFrameTest, ForgetSentValues) {
+    m_frame.queueMessage(0xB0, 0x10, 0x01);
+    flush();
+    m_frame.queueMessage(0xB0, 0x11, 0x01);
+    m_sent.clear();
+
+    m_frame.forgetSentValues();
+    EXPECT_TRUE(m_frame.queueMessage(0xB0, 0x10, 0x01));
+    // Pending messages are kept
+    EXPECT_EQ(2, flush());
+    EXPECT_EQ((std::vector<Message>{{0xB0, 0x11, 0x01}, {0xB0, 0x10, 0x01}}), m_sent);
+}
+
+TEST_F(MidiOutputFrameTest, BoundedFrameSize) {
+    for (int control = 0; control < 10; ++control) {
+        m_frame.queueMessage(0x90, static_cast<unsigned char>(control), 0x7F);
+    }
+    EXPECT_EQ(4, flush(4));
+    EXPECT_EQ(4, flush(4));
+    EXPECT_EQ(2, flush(4));
+    EXPECT_FALSE(m_frame.hasPendingMessages());
+    ASSERT_EQ(10u, m_sent.size());
+    for (int control = 0; control < 10; ++control) {
+        EXPECT_EQ(Message(0x90, control, 0x7F), m_sent[control]);
+    }
+}
+
+TEST_F(MidiOutputFrameTest, DirectlySentMessageSupersedesPending) {
+    m_frame.queueMessage(0x90, 0x01, 0x7F);
+    m_frame.queueMessage(0x90, 0x02, 0x7F);
+    m_frame.messageSent(0x90, 0x01, 0x00);
+    EXPECT_EQ(1, flush());
+    EXPECT_EQ((std::vector<Message>{{0x90, 0x02, 0x7F}}), m_sent);
+    EXPECT_FALSE(m_frame.queueMessage(0x90, 0x01, 0x00));
+}
+
+} // namespace
@@ -1,7 +1,10 @@
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
 
+#include <QElapsedTimer>
 #include <QScopedPointer>
+#include <QThread>
+#include <atomic>
 
 #include "controllers/midi/portmidicontroller.h"
 #include "controllers/midi/portmididevice.h"
@@ -9,6 +12,8 @@
 
 using ::testing::_;
 using ::testing::DoAll;
+using ::testing::Invoke;
+using ::testing::InvokeWithoutArgs;
 using ::testing::NotNull;
 using ::testing::Return;
 using ::testing::Sequence;
@@ -89,6 +94,23 @@ class PortMidiControllerTest : public MixxxTest {
         m_pController->setPortMidiOutputDevice(m_mockOutput);
     }
 
+    static void setPortMidiDevices(PortMidiController* pController,
+            PortMidiDevice* pInputDevice,
+            PortMidiDevice* pOutputDevice) {
+        pController->setPortMidiInputDevice(pInputDevice);
+        pController->setPortMidiOutputDevice(pOutputDevice);
+    }
+
+    bool waitFor(const bool& condition) {
+        QElapsedTimer timer;
+        timer.start();
+        while (!condition && timer.elapsed() < 10000) {
+            application()->processEvents();
+            QThread::msleep(1);
+        }
+        return condition;
+    }
+
     void openDevice() {
         m_pController->open();
     }
@@ -101,6 +123,10 @@ class PortMidiControllerTest : public MixxxTest {
         m_pController->poll();
     }
 
+    bool isPolling() const {
+        return m_pController->isPolling();
+    }
+
     PmDeviceInfo m_inputDeviceInfo;
     PmDeviceInfo m_outputDeviceInfo;
     MockPortMidiDevice* m_mockInput;
@@ -138,6 +164,9 @@ TEST_F(PortMidiControllerTest, OpenClose) {
     EXPECT_CALL(*m_mockInput, close())
             .InSequence(input)
             .WillOnce(Return(pmNoError));
+    // Polled by the input thread while open
+    EXPECT_CALL(*m_mockInput, read(NotNull(), _))
+            .WillRepeatedly(Return(0));
 
     Sequence output;
     ON_CALL(*m_mockOutput, isOpen())
@@ -443,3 +472,120 @@ TEST_F(PortMidiControllerTest, Poll_Read_SysEx_BufferOverflow) {
     pollDevice();
     pollDevice();
 };
+
+TEST_F(PortMidiControllerTest, InputThread_Read) {
+    std::vector<PmEvent> messages;
+    messages.push_back(MakeEvent(0x403C90, 0x0));
+    messages.push_back(MakeEvent(0x403C80, 0x1));
+
+    ON_CALL(*m_mockInput, isOpen())
+            .WillByDefault(Return(true));
+    EXPECT_CALL(*m_mockInput, openInput(MIXXX_PORTMIDI_BUFFER_LEN))
+            .WillOnce(Return(pmNoError));
+    EXPECT_CALL(*m_mockInput, read(NotNull(), _))
+            .WillOnce(DoAll(SetArrayArgument<0>(messages.begin(), messages.end()),
+                    Return(static_cast<int>(messages.size()))))
+            .WillRepeatedly(Return(0));
+    EXPECT_CALL(*m_mockInput, close())
+            .WillOnce(Return(pmNoError));
+    ON_CALL(*m_mockOutput, isOpen())
+            .WillByDefault(Return(false));
+    EXPECT_CALL(*m_mockOutput, openOutput())
+            .WillOnce(Return(pmNoError));
+
+    // The events are delivered in the controller thread
+    bool received = false;
+    Sequence read;
+    EXPECT_CALL(*m_pController, receivedShortMessage(0x90, 0x3C, 0x40, _))
+            .InSequence(read);
+    EXPECT_CALL(*m_pController, receivedShortMessage(0x80, 0x3C, 0x40, _))
+            .InSequence(read)
+            .WillOnce(InvokeWithoutArgs([&received] { received = true; }));
+
+    openDevice();
+    EXPECT_FALSE(isPolling());
+    EXPECT_TRUE(waitFor(received));
+    closeDevice();
+};
+
+TEST_F(PortMidiControllerTest, InputThread_SharedBetweenDevices) {
+    std::vector<PmEvent> messages;
+    messages.push_back(MakeEvent(0x403C90, 0x0));
+    const PmEvent otherMessage = MakeEvent(0x403D90, 0x0);
+
+    auto* pOtherMockInput = new MockPortMidiDevice(&m_inputDeviceInfo, 1);
+    auto* pOtherMockOutput = new MockPortMidiDevice(&m_outputDeviceInfo, 1);
+    MockPortMidiController otherController(
+            &m_inputDeviceInfo, &m_outputDeviceInfo, 1, 1);
+    setPortMidiDevices(&otherController, pOtherMockInput, pOtherMockOutput);
+
+    for (auto* pMockInput : {m_mockInput, pOtherMockInput}) {
+        ON_CALL(*pMockInput, isOpen())
+                .WillByDefault(Return(true));
+        EXPECT_CALL(*pMockInput, openInput(MIXXX_PORTMIDI_BUFFER_LEN))
+                .WillOnce(Return(pmNoError));
+        EXPECT_CALL(*pMockInput, close())
+                .WillOnce(Return(pmNoError));
+    }
+    for (auto* pMockOutput : {m_mockOutput, pOtherMockOutput}) {
+        ON_CALL(*pMockOutput, isOpen())
+                .WillByDefault(Return(false));
+        EXPECT_CALL(*pMockOutput, openOutput())
+                .WillOnce(Return(pmNoError));
+    }
+    EXPECT_CALL(*m_mockInput, read(NotNull(), _))
+            .WillOnce(DoAll(SetArrayArgument<0>(messages.begin(), messages.end()),
+                    Return(static_cast<int>(messages.size()))))
+            .WillRepeatedly(Return(0));
+    // The other device sends a message whenever requested by the test
+    std::atomic<bool> otherMessagePending(true);
+    EXPECT_CALL(*pOtherMockInput, read(NotNull(), _))
+            .WillRepeatedly(Invoke([&otherMessagePending, otherMessage](
+                                           PmEvent* pBuffer, int32_t) {
+                if (!otherMessagePending.exchange(false)) {
+                    return 0;
+                }
+                pBuffer[0] = otherMessage;
+                return 1;
+            }));
+
+    // Each event is delivered to the controller of its device
+    bool received = false;
+    int otherReceivedCount = 0;
+    bool otherReceived = false;
+    EXPECT_CALL(*m_pController, receivedShortMessage(0x90, 0x3C, 0x40, _))
+            .WillOnce(InvokeWithoutArgs([&received] { received = true; }));
+    EXPECT_CALL(otherController, receivedShortMessage(0x90, 0x3D, 0x40, _))
+            .Times(2)
+            .WillRepeatedly(InvokeWithoutArgs([&otherReceivedCount, &otherReceived] {
+                ++otherReceivedCount;
+                otherReceived = true;
+            }));
+
+    openDevice();
+    otherController.open();
+    EXPECT_TRUE(waitFor(received));
+    EXPECT_TRUE(waitFor(otherReceived));
+    EXPECT_EQ(1, otherReceivedCount);
+
+    // Closing one device does not stop reading the other one
+    closeDevice();
+    otherReceived = false;
+    otherMessagePending = true;
+    EXPECT_TRUE(waitFor(otherReceived));
+    EXPECT_EQ(2, otherReceivedCount);
+    otherController.close();
+};
+
+TEST_F(PortMidiControllerTest, InputThread_TimestampToElapsedTime) {
+    const auto elapsedNow = mixxx::Duration::fromSeconds(10);
+    EXPECT_EQ(mixxx::Duration::fromMillis(9995),
+            PortMidiInputThread::toElapsedTime(995, 1000, elapsedNow));
+    EXPECT_EQ(elapsedNow,
+            PortMidiInputThread::toElapsedTime(1000, 1000, elapsedNow));
+    // Timestamps from a different clock
+    EXPECT_EQ(elapsedNow,
+            PortMidiInputThread::toElapsedTime(2000, 1000, elapsedNow));
+    EXPECT_EQ(elapsedNow,
+            PortMidiInputThread::toElapsedTime(0, 100000, elapsedNow));
+};
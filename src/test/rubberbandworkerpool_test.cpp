@@ -0,0 +1,149 @@
+#include "engine/bufferscalers/rubberbandworkerpool.h"
+
+#include <benchmark/benchmark.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+#include "engine/bufferscalers/rubberbandwrapper.h"
+#include "test/mixxxtest.h"
+#include "util/spinparkevent.h"
+
+namespace {
+
+constexpr mixxx::audio::SampleRate kSampleRate(44100);
+constexpr SINT kCallbackFrames = 512;
+
+// A stem deck with keylock enabled, i.e. a stretcher for 8 channels whose
+// input is fed from a looped sine wave
+class KeylockDeck {
+  public:
+    KeylockDeck()
+            : m_input(mixxx::audio::ChannelCount::stem(),
+                      std::vector<float>(kCallbackFrames)),
+              m_output(mixxx::audio::ChannelCount::stem(),
+                      std::vector<float>(kCallbackFrames)) {
+        for (std::size_t ch = 0; ch < m_input.size(); ch++) {
+            m_inputPtrs.push_back(m_input[ch].data());
+            m_outputPtrs.push_back(m_output[ch].data());
+        }
+        // All stems have the same signal, so every stretcher instance must
+        // produce the same output regardless of the thread that runs it
+        for (auto& channel : m_input) {
+            for (SINT i = 0; i < kCallbackFrames; i++) {
+                channel[i] = static_cast<float>(std::sin(i * 0.05));
+            }
+        }
+        m_rubberBand.setup(kSampleRate,
+                mixxx::audio::ChannelCount::stem(),
+                RubberBandStretcher::OptionProcessRealTime);
+        m_rubberBand.setTimeRatio(1.0 / 1.08);
+        m_rubberBand.setPitchScale(1.0);
+    }
+
+    // Produce one callback worth of stretched audio
+    void process() {
+        while (m_rubberBand.available() < kCallbackFrames) {
+            const auto required = std::clamp<std::size_t>(
+                    m_rubberBand.getSamplesRequired(), 1, kCallbackFrames);
+            m_rubberBand.process(m_inputPtrs.data(), required, false);
+        }
+        m_rubberBand.retrieve(m_outputPtrs.data(), kCallbackFrames, kCallbackFrames);
+    }
+
+    const std::vector<std::vector<float>>& output() const {
+        return m_output;
+    }
+
+  private:
+    RubberBandWrapper m_rubberBand;
+    std::vector<std::vector<float>> m_input;
+    std::vector<std::vector<float>> m_output;
+    std::vector<const float*> m_inputPtrs;
+    std::vector<float*> m_outputPtrs;
+};
+
+class RubberBandWorkerPoolTest : public MixxxTest {
+  protected:
+    void SetUp() override {
+        RubberBandWorkerPool::createInstance();
+    }
+
+    void TearDown() override {
+        RubberBandWorkerPool::destroy();
+    }
+};
+
+TEST_F(RubberBandWorkerPoolTest, StemInstancesProduceIdenticalOutput) {
+    KeylockDeck deck;
+    for (int callback = 0; callback < 50; callback++) {
+        deck.process();
+        const auto& output = deck.output();
+        for (std::size_t ch = 2; ch < output.size(); ch++) {
+            ASSERT_EQ(output[ch % 2], output[ch])
+                    << "callback" << callback << "channel" << ch;
+        }
+    }
+}
+
+TEST(SpinParkEventTest, PingPong) {
+    SpinParkEvent ping;
+    SpinParkEvent pong;
+    constexpr int kRoundTrips = 1000;
+    std::thread worker([&] {
+        for (int i = 0; i < kRoundTrips; i++) {
+            ping.wait();
+            // Let the other side park from time to time
+            if (i % 100 == 0) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+            pong.set();
+        }
+    });
+    for (int i = 0; i < kRoundTrips; i++) {
+        EXPECT_FALSE(pong.isSet());
+        ping.set();
+        pong.wait();
+    }
+    worker.join();
+    EXPECT_FALSE(ping.isSet());
+    EXPECT_FALSE(pong.isSet());
+}
+
+// Measures the duration of the audio callback for stem decks with keylock
+// enabled. Besides the mean, the jitter is reported as the 99th percentile
+// and the maximum callback duration.
+static void BM_RubberBandStemDecksCallback(benchmark::State& state) {
+    RubberBandWorkerPool::createInstance();
+    {
+        std::vector<std::unique_ptr<KeylockDeck>> decks;
+        for (int i = 0; i < state.range(0); i++) {
+            decks.push_back(std::make_unique<KeylockDeck>());
+        }
+        std::vector<double> callbackMicros;
+        callbackMicros.reserve(state.max_iterations);
+        for (auto _ : state) {
+            const auto start = std::chrono::steady_clock::now();
+            for (const auto& pDeck : decks) {
+                pDeck->process();
+            }
+            callbackMicros.push_back(std::chrono::duration<double, std::micro>(
+                    std::chrono::steady_clock::now() - start)
+                                             .count());
+        }
+        if (!callbackMicros.empty()) {
+            std::sort(callbackMicros.begin(), callbackMicros.end());
+            state.counters["p50_us"] = callbackMicros[callbackMicros.size() / 2];
+            state.counters["p99_us"] = callbackMicros[callbackMicros.size() * 99 / 100];
+            state.counters["max_us"] = callbackMicros.back();
+        }
+    }
+    RubberBandWorkerPool::destroy();
+}
+BENCHMARK(BM_RubberBandStemDecksCallback)->Arg(1)->Arg(4);
+
+} // namespace
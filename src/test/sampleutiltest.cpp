@@ -466,6 +466,43 @@ TEST_F(SampleUtilTest, mixMultichannelToStereo) {
     EXPECT_FLOAT_EQ(destination[3], 0.9f + 1.1f + 1.3f /* + 1.5f*/);
 }
 
+TEST_F(SampleUtilTest, mixMultichannelToStereoWithRampingGain) {
+    EXPECT_TRUE(buffers.size() > 1 && sizes[0] > 16 && sizes[1] > 16);
+    CSAMPLE* source = buffers[0];
+    CSAMPLE* destination = buffers[1];
+    for (int i = 0; i < 16; ++i) {
+        source[i] = i * 0.1f;
+    }
+    const CSAMPLE_GAIN oldGains[] = {1.0f, 0.5f, 0.0f, 1.0f};
+    // The last stem ramps down to 0.5 in the first and 0 in the second frame
+    const CSAMPLE_GAIN newGains[] = {1.0f, 0.5f, 0.0f, 0.0f};
+
+    SampleUtil::mixMultichannelToStereoWithRampingGain(destination,
+            source,
+            oldGains,
+            newGains,
+            2,
+            mixxx::audio::ChannelCount::stem());
+
+    EXPECT_FLOAT_EQ(destination[0], 0.0f + 0.2f * 0.5f + 0.6f * 0.5f);
+    EXPECT_FLOAT_EQ(destination[1], 0.1f + 0.3f * 0.5f + 0.7f * 0.5f);
+    EXPECT_FLOAT_EQ(destination[2], 0.8f + 1.0f * 0.5f);
+    EXPECT_FLOAT_EQ(destination[3], 0.9f + 1.1f * 0.5f);
+
+    SampleUtil::mixMultichannelToStereoWithRampingGain(destination,
+            source,
+            oldGains,
+            newGains,
+            2,
+            mixxx::audio::ChannelCount::stem(),
+            0b0001);
+
+    EXPECT_FLOAT_EQ(destination[0], /*0.0f +*/ 0.2f * 0.5f + 0.6f * 0.5f);
+    EXPECT_FLOAT_EQ(destination[1], /*0.1f +*/ 0.3f * 0.5f + 0.7f * 0.5f);
+    EXPECT_FLOAT_EQ(destination[2], /*0.8f +*/ 1.0f * 0.5f);
+    EXPECT_FLOAT_EQ(destination[3], /*0.9f +*/ 1.1f * 0.5f);
+}
+
 static void BM_MemCpy(benchmark::State& state) {
     SINT size = static_cast<SINT>(state.range(0));
     CSAMPLE* buffer = SampleUtil::alloc(size);
@@ -0,0 +1,110 @@
+#include "skin/legacy/skinimagecache.h"
+
+#include <gtest/gtest.h>
+
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QTemporaryDir>
+
+#include "test/mixxxtest.h"
+
+namespace {
+
+const QByteArray kSvg = QByteArrayLiteral(
+        "<svg xmlns=\"http://www.w3.org/2000/svg\" width=\"4\" height=\"2\">"
+        "<rect width=\"4\" height=\"2\" fill=\"#ff0000\"/></svg>");
+
+class SkinImageCacheTest : public MixxxTest {
+  protected:
+    void SetUp() override {
+        ASSERT_TRUE(m_cacheDir.isValid());
+        ASSERT_TRUE(m_sourceDir.isValid());
+        SkinImageCache::setDirectory(m_cacheDir.path());
+        m_svgPath = m_sourceDir.filePath(QStringLiteral("image.svg"));
+        writeSvg(kSvg);
+    }
+
+    void TearDown() override {
+        SkinImageCache::setDirectory(QString());
+    }
+
+    void writeSvg(const QByteArray& content) {
+        QFile file(m_svgPath);
+        ASSERT_TRUE(file.open(QIODevice::WriteOnly | QIODevice::Truncate));
+        ASSERT_EQ(content.size(), file.write(content));
+    }
+
+    void setEntryTimes(const QDateTime& time) {
+        const QDir cacheDir(m_cacheDir.path());
+        for (const auto& fileName : cacheDir.entryList(QDir::Files)) {
+            QFile file(cacheDir.filePath(fileName));
+            ASSERT_TRUE(file.open(QIODevice::ReadWrite));
+            ASSERT_TRUE(file.setFileTime(time, QFileDevice::FileModificationTime));
+        }
+    }
+
+    qint64 entrySizeBytes() const {
+        const QFileInfoList entries = QDir(m_cacheDir.path()).entryInfoList(QDir::Files);
+        return entries.isEmpty() ? 0 : entries.first().size();
+    }
+
+    static QImage makeImage() {
+        QImage image(4, 2, QImage::Format_ARGB32_Premultiplied);
+        image.fill(Qt::red);
+        image.setPixel(1, 1, qRgb(0, 0, 255));
+        return image;
+    }
+
+    QTemporaryDir m_cacheDir;
+    QTemporaryDir m_sourceDir;
+    QString m_svgPath;
+};
+
+TEST_F(SkinImageCacheTest, StoreAndLoad) {
+    EXPECT_TRUE(SkinImageCache::loadImage(m_svgPath, 1.0).isNull());
+
+    const QImage image = makeImage();
+    SkinImageCache::storeImage(m_svgPath, 1.0, image);
+    EXPECT_EQ(image, SkinImageCache::loadImage(m_svgPath, 1.0));
+
+    // Entries are specific to the scale factor
+    EXPECT_TRUE(SkinImageCache::loadImage(m_svgPath, 2.0).isNull());
+}
+
+TEST_F(SkinImageCacheTest, InvalidateModifiedFile) {
+    SkinImageCache::storeImage(m_svgPath, 1.0, makeImage());
+    ASSERT_FALSE(SkinImageCache::loadImage(m_svgPath, 1.0).isNull());
+
+    QByteArray modifiedSvg = kSvg;
+    modifiedSvg.replace("#ff0000", "#00ff00");
+    writeSvg(modifiedSvg);
+    EXPECT_TRUE(SkinImageCache::loadImage(m_svgPath, 1.0).isNull());
+}
+
+TEST_F(SkinImageCacheTest, EvictLeastRecentlyUsed) {
+    const QImage image = makeImage();
+    SkinImageCache::storeImage(m_svgPath, 1.0, image);
+    SkinImageCache::storeImage(m_svgPath, 2.0, image);
+    SkinImageCache::storeImage(m_svgPath, 3.0, image);
+    setEntryTimes(QDateTime::currentDateTime().addDays(-1));
+    // Entries are used when they are loaded
+    ASSERT_FALSE(SkinImageCache::loadImage(m_svgPath, 1.0).isNull());
+    ASSERT_FALSE(SkinImageCache::loadImage(m_svgPath, 3.0).isNull());
+
+    // Enabling the cache again shrinks it to the maximum size
+    SkinImageCache::setDirectory(m_cacheDir.path(), 2 * entrySizeBytes());
+    EXPECT_EQ(2, QDir(m_cacheDir.path()).entryList(QDir::Files).size());
+    EXPECT_FALSE(SkinImageCache::loadImage(m_svgPath, 1.0).isNull());
+    EXPECT_TRUE(SkinImageCache::loadImage(m_svgPath, 2.0).isNull());
+    EXPECT_FALSE(SkinImageCache::loadImage(m_svgPath, 3.0).isNull());
+}
+
+TEST_F(SkinImageCacheTest, Disabled) {
+    SkinImageCache::setDirectory(QString());
+    SkinImageCache::storeImage(m_svgPath, 1.0, makeImage());
+    EXPECT_TRUE(SkinImageCache::loadImage(m_svgPath, 1.0).isNull());
+    EXPECT_TRUE(QDir(m_cacheDir.path()).isEmpty());
+}
+
+} // namespace
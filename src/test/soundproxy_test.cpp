@@ -3,8 +3,12 @@
 #include <QtDebug>
 
 #include "analyzer/analyzersilence.h"
+#include "sources/audiosourcepcmcacheproxy.h"
 #include "sources/audiosourcestereoproxy.h"
 #include "sources/soundsourceproxy.h"
+#ifdef __MAD__
+#include "sources/soundsourcemp3.h"
+#endif
 #include "test/mixxxtest.h"
 #include "test/soundsourceproviderregistration.h"
 #include "track/taglib/trackmetadata_file.h"
@@ -39,6 +43,16 @@ const CSAMPLE kMaxDecodingError = 0.01f;
 
 class SoundSourceProxyTest : public MixxxTest, SoundSourceProviderRegistration {
   protected:
+    void SetUp() override {
+        m_previousDecodedAudioCacheDir = mixxx::AudioSourcePcmCacheProxy::storageDir();
+    }
+
+    void TearDown() override {
+        // The cache directory of a test is deleted with the test data
+        mixxx::AudioSourcePcmCacheProxy::setEnabled(false);
+        mixxx::AudioSourcePcmCacheProxy::setStorageDir(m_previousDecodedAudioCacheDir);
+    }
+
     static QStringList getFileNameSuffixes() {
         QStringList availableFileNameSuffixes;
         availableFileNameSuffixes
@@ -171,6 +185,7 @@ class SoundSourceProxyTest : public MixxxTest, SoundSourceProviderRegistration {
 
   private:
     mixxx::SampleBuffer m_skipSampleBuffer;
+    QString m_previousDecodedAudioCacheDir;
 };
 
 TEST_F(SoundSourceProxyTest, open) {
@@ -236,6 +251,37 @@ TEST_F(SoundSourceProxyTest, readArtist) {
     EXPECT_EQ("Test Artist", pTrack->getArtist());
 }
 
+TEST_F(SoundSourceProxyTest, updateTrackFromPreparedImport) {
+    const QString filePath =
+            getTestDir().filePath(QStringLiteral("id3-test-data/cover-test-jpg.mp3"));
+    const auto preparedImport = SoundSourceProxy::prepareImportFromNewFile(
+            mixxx::FileAccess(mixxx::FileInfo(filePath)));
+    ASSERT_TRUE(preparedImport);
+    EXPECT_EQ(mixxx::MetadataSource::ImportResult::Succeeded, preparedImport->result);
+    EXPECT_FALSE(preparedImport->coverImage.isNull());
+
+    auto pTrack = Track::newTemporary(filePath);
+    EXPECT_EQ(
+            SoundSourceProxy::UpdateTrackFromSourceResult::MetadataImportedAndUpdated,
+            SoundSourceProxy(pTrack).updateTrackFromSource(
+                    SoundSourceProxy::UpdateTrackFromSourceMode::Once,
+                    SyncTrackMetadataParams{},
+                    &*preparedImport));
+    EXPECT_EQ("test22kMono", pTrack->getTitle());
+    EXPECT_EQ(CoverInfo::METADATA, pTrack->getCoverInfo().type);
+
+    // The prepared import must be ignored when re-importing
+    pTrack->setTitle("");
+    const SoundSourceProxy::PreparedImport emptyImport;
+    EXPECT_EQ(
+            SoundSourceProxy::UpdateTrackFromSourceResult::MetadataImportedAndUpdated,
+            SoundSourceProxy(pTrack).updateTrackFromSource(
+                    SoundSourceProxy::UpdateTrackFromSourceMode::Always,
+                    SyncTrackMetadataParams{},
+                    &emptyImport));
+    EXPECT_EQ("test22kMono", pTrack->getTitle());
+}
+
 TEST_F(SoundSourceProxyTest, readNoTitle) {
     // We need to verify every track has at least a title to not have empty lines in the library
 
@@ -401,6 +447,119 @@ TEST_F(SoundSourceProxyTest, seekForwardBackward) {
     }
 }
 
+#ifdef __MAD__
+TEST_F(SoundSourceProxyTest, mp3SeekIndexCache) {
+    const QString filePath = getTestDir().filePath(
+            QStringLiteral("id3-test-data/cover-test-vbr.mp3"));
+    const auto fileUrl = QUrl::fromLocalFile(filePath);
+
+    // Parses all frame headers and caches the seek index
+    mixxx::SoundSourceMp3 parsedSource(fileUrl);
+    ASSERT_EQ(mixxx::AudioSource::OpenResult::Succeeded,
+            parsedSource.open(mixxx::AudioSource::OpenMode::Strict));
+    const auto pSeekIndex = mixxx::Mp3SeekIndexCache::load(QFileInfo(filePath));
+    ASSERT_TRUE(pSeekIndex);
+    EXPECT_EQ(parsedSource.frameIndexMax(), pSeekIndex->seekFrames.back().frameIndex);
+
+    // Restored from the cached seek index
+    mixxx::SoundSourceMp3 cachedSource(fileUrl);
+    ASSERT_EQ(mixxx::AudioSource::OpenResult::Succeeded,
+            cachedSource.open(mixxx::AudioSource::OpenMode::Strict));
+    EXPECT_EQ(parsedSource.getSignalInfo(), cachedSource.getSignalInfo());
+    EXPECT_EQ(parsedSource.getBitrate(), cachedSource.getBitrate());
+    ASSERT_EQ(parsedSource.frameIndexRange(), cachedSource.frameIndexRange());
+
+    // Seek into the middle of the stream and decode until the end
+    const auto readRange = mixxx::IndexRange::between(
+            parsedSource.frameIndexMin() + parsedSource.frameLength() / 2,
+            parsedSource.frameIndexMax());
+    mixxx::SampleBuffer parsedData(
+            parsedSource.getSignalInfo().frames2samples(readRange.length()));
+    mixxx::SampleBuffer cachedData(
+            cachedSource.getSignalInfo().frames2samples(readRange.length()));
+    const auto parsedFrames = parsedSource.readSampleFrames(
+            mixxx::WritableSampleFrames(
+                    readRange,
+                    mixxx::SampleBuffer::WritableSlice(parsedData)));
+    const auto cachedFrames = cachedSource.readSampleFrames(
+            mixxx::WritableSampleFrames(
+                    readRange,
+                    mixxx::SampleBuffer::WritableSlice(cachedData)));
+    ASSERT_EQ(parsedFrames.frameIndexRange(), cachedFrames.frameIndexRange());
+    expectDecodedSamplesEqual(
+            parsedSource.getSignalInfo().frames2samples(parsedFrames.frameLength()),
+            &parsedData[0],
+            &cachedData[0],
+            "Decoding mismatch with cached seek index");
+}
+#endif
+
+TEST_F(SoundSourceProxyTest, decodedAudioCache) {
+    mixxx::AudioSourcePcmCacheProxy::setStorageDir(
+            getTestDataDir().filePath(QStringLiteral("decodedaudio")));
+    mixxx::AudioSourcePcmCacheProxy::setMaxSizeBytes(256 * 1024 * 1024);
+    mixxx::AudioSourcePcmCacheProxy::setEnabled(true);
+
+    for (const auto& filePath : getFilePaths()) {
+        const QFileInfo fileInfo(filePath);
+        const QString fileType = mixxx::SoundSource::getTypeFromFile(fileInfo);
+        if (!mixxx::AudioSourcePcmCacheProxy::isCacheableFileType(fileType)) {
+            continue;
+        }
+        qDebug() << "Caching decoded audio of" << filePath;
+
+        auto pDecodedSource = openAudioSource(filePath);
+        // Obtaining an AudioSource may fail for unsupported file formats,
+        // even if the corresponding file extension is supported, e.g.
+        // AAC vs. ALAC in .m4a files
+        if (!pDecodedSource) {
+            continue;
+        }
+        const auto frameIndexRange = pDecodedSource->frameIndexRange();
+        mixxx::SampleBuffer decodedData(
+                pDecodedSource->getSignalInfo().frames2samples(frameIndexRange.length()));
+        const auto decodedFrames = pDecodedSource->readSampleFrames(
+                mixxx::WritableSampleFrames(
+                        frameIndexRange,
+                        mixxx::SampleBuffer::WritableSlice(decodedData)));
+
+        // The first pass fills the cache file, the second pass reads from it
+        for (int pass = 0; pass < 2; ++pass) {
+            auto pCachedSource = mixxx::AudioSourcePcmCacheProxy::create(
+                    openAudioSource(filePath), fileInfo, fileType);
+            ASSERT_TRUE(pCachedSource);
+            ASSERT_EQ(frameIndexRange, pCachedSource->frameIndexRange());
+            mixxx::SampleBuffer cachedData(decodedData.size());
+            // Read backwards in chunks that are not aligned with the blocks
+            // of the cache file
+            constexpr SINT kChunkFrames = 5000;
+            SINT chunkEnd = frameIndexRange.end();
+            while (chunkEnd > frameIndexRange.start()) {
+                const SINT chunkStart = math_max(
+                        frameIndexRange.start(), chunkEnd - kChunkFrames);
+                const auto chunkRange = mixxx::IndexRange::between(chunkStart, chunkEnd);
+                const auto cachedFrames = pCachedSource->readSampleFrames(
+                        mixxx::WritableSampleFrames(
+                                chunkRange,
+                                mixxx::SampleBuffer::WritableSlice(
+                                        cachedData,
+                                        pCachedSource->getSignalInfo().frames2samples(
+                                                chunkStart - frameIndexRange.start()),
+                                        pCachedSource->getSignalInfo().frames2samples(
+                                                chunkRange.length()))));
+                EXPECT_EQ(chunkRange, cachedFrames.frameIndexRange());
+                chunkEnd = chunkStart;
+            }
+            expectDecodedSamplesEqual(
+                    pDecodedSource->getSignalInfo().frames2samples(
+                            decodedFrames.frameLength()),
+                    &decodedData[0],
+                    &cachedData[0],
+                    "Decoding mismatch with cached audio");
+        }
+    }
+}
+
 TEST_F(SoundSourceProxyTest, skipAndRead) {
     for (auto kReadFrameCount : kBufferSizes) {
         const QStringList filePaths = getFilePaths();
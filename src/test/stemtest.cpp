@@ -1,3 +1,4 @@
+#include <benchmark/benchmark.h>
 #include <gtest/gtest.h>
 
 #include <QtDebug>
@@ -5,6 +6,7 @@
 #include "sources/soundsourceproxy.cpp"
 #include "test/mixxxtest.h"
 #include "track/track.h"
+#include "util/math.h"
 #include "util/samplebuffer.h"
 
 using namespace mixxx;
@@ -152,4 +154,44 @@ TEST_F(StemTest, OpenStem) {
             sourceStem.getSignalInfo());
 }
 
+// Measures the decoding throughput of a stem file in chunks of the size
+// requested by the CachingReader, either as separate stems (8 channels) or
+// mixed down to stereo.
+static void BM_StemDecode(benchmark::State& state) {
+    const QDir testDir(QDir::cleanPath(
+            ConfigObject<ConfigValue>::computeResourcePath() + kTestPath));
+    SoundSourceSTEM sourceStem(QUrl::fromLocalFile(
+            testDir.filePath(QStringLiteral("stems/test.stem.mp4"))));
+
+    mixxx::AudioSource::OpenParams config;
+    config.setChannelCount(mixxx::audio::ChannelCount(
+            static_cast<int>(state.range(0))));
+    if (sourceStem.open(AudioSource::OpenMode::Strict, config) !=
+            AudioSource::OpenResult::Succeeded) {
+        state.SkipWithError("Failed to open stem file");
+        return;
+    }
+
+    const SINT chunkFrames = 8192;
+    const auto frameIndexRange = sourceStem.frameIndexRange();
+    SampleBuffer buffer(sourceStem.getSignalInfo().frames2samples(chunkFrames));
+    SINT decodedFrames = 0;
+    for (auto _ : state) {
+        for (SINT frameIndex = frameIndexRange.start();
+                frameIndex < frameIndexRange.end();
+                frameIndex += chunkFrames) {
+            const auto chunkRange = IndexRange::between(frameIndex,
+                    math_min(frameIndex + chunkFrames, frameIndexRange.end()));
+            const auto read = sourceStem.readSampleFrames(WritableSampleFrames(
+                    chunkRange,
+                    SampleBuffer::WritableSlice(buffer.data(),
+                            sourceStem.getSignalInfo().frames2samples(
+                                    chunkRange.length()))));
+            decodedFrames += read.frameLength();
+        }
+    }
+    state.SetItemsProcessed(decodedFrames);
+}
+BENCHMARK(BM_StemDecode)->Arg(2)->Arg(8)->Unit(benchmark::kMillisecond);
+
 } // namespace
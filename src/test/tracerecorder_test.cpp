@@ -0,0 +1,158 @@
+#include "util/tracerecorder.h"
+
+#include <gtest/gtest.h>
+
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTemporaryDir>
+#include <QThread>
+
+namespace {
+
+class TraceRecorderTest : public testing::Test {
+  protected:
+    void SetUp() override {
+        mixxx::TraceRecorder::clear();
+        mixxx::TraceRecorder::setEnabled(true);
+        mixxx::TraceRecorder::registerCurrentThread();
+    }
+
+    void TearDown() override {
+        mixxx::TraceRecorder::setEnabled(false);
+        mixxx::TraceRecorder::clear();
+    }
+
+    QJsonArray writeAndParseTraceEvents() {
+        QTemporaryDir tempDir;
+        const QString filePath = tempDir.filePath(QStringLiteral("trace.json"));
+        EXPECT_TRUE(mixxx::TraceRecorder::writeChromeTrace(filePath));
+        QFile file(filePath);
+        EXPECT_TRUE(file.open(QIODevice::ReadOnly));
+        const auto doc = QJsonDocument::fromJson(file.readAll());
+        return doc.object().value(QStringLiteral("traceEvents")).toArray();
+    }
+
+    static int countEvents(const QJsonArray& traceEvents,
+            const QString& name,
+            const QString& phase) {
+        int count = 0;
+        for (const auto& value : traceEvents) {
+            const auto event = value.toObject();
+            if (event.value(QStringLiteral("name")).toString() == name &&
+                    event.value(QStringLiteral("ph")).toString() == phase) {
+                ++count;
+            }
+        }
+        return count;
+    }
+
+    static QList<int> threadIdsOfEvents(const QJsonArray& traceEvents, const QString& name) {
+        QList<int> threadIds;
+        for (const auto& value : traceEvents) {
+            const auto event = value.toObject();
+            if (event.value(QStringLiteral("name")).toString() == name) {
+                threadIds.append(event.value(QStringLiteral("tid")).toInt());
+            }
+        }
+        return threadIds;
+    }
+};
+
+TEST_F(TraceRecorderTest, RecordSpansOfMultipleThreads) {
+    {
+        mixxx::ScopedTraceSpan span("main");
+    }
+    mixxx::TraceRecorder::recordInstant("xrun");
+
+    QThread* pThread = QThread::create([] {
+        mixxx::TraceRecorder::registerCurrentThread();
+        for (int i = 0; i < 3; ++i) {
+            mixxx::ScopedTraceSpan span("worker");
+        }
+    });
+    pThread->setObjectName(QStringLiteral("TraceRecorderTestWorker"));
+    pThread->start();
+    pThread->wait();
+    delete pThread;
+
+    const QJsonArray traceEvents = writeAndParseTraceEvents();
+    EXPECT_EQ(1, countEvents(traceEvents, QStringLiteral("main"), QStringLiteral("X")));
+    EXPECT_EQ(1, countEvents(traceEvents, QStringLiteral("xrun"), QStringLiteral("i")));
+    EXPECT_EQ(3, countEvents(traceEvents, QStringLiteral("worker"), QStringLiteral("X")));
+
+    bool workerThreadNamed = false;
+    for (const auto& value : traceEvents) {
+        const auto event = value.toObject();
+        if (event.value(QStringLiteral("ph")).toString() == QStringLiteral("M") &&
+                event.value(QStringLiteral("args"))
+                                .toObject()
+                                .value(QStringLiteral("name"))
+                                .toString() == QStringLiteral("TraceRecorderTestWorker")) {
+            workerThreadNamed = true;
+        }
+    }
+    EXPECT_TRUE(workerThreadNamed);
+}
+
+TEST_F(TraceRecorderTest, DisabledRecordsNothing) {
+    mixxx::TraceRecorder::setEnabled(false);
+    {
+        mixxx::ScopedTraceSpan span("disabled");
+    }
+    mixxx::TraceRecorder::recordInstant("disabled");
+
+    const QJsonArray traceEvents = writeAndParseTraceEvents();
+    EXPECT_EQ(0, countEvents(traceEvents, QStringLiteral("disabled"), QStringLiteral("X")));
+    EXPECT_EQ(0, countEvents(traceEvents, QStringLiteral("disabled"), QStringLiteral("i")));
+}
+
+TEST_F(TraceRecorderTest, UnregisteredThreadRecordsNothing) {
+    QThread* pThread = QThread::create([] {
+        mixxx::ScopedTraceSpan span("unregistered");
+        mixxx::TraceRecorder::recordInstant("unregistered");
+    });
+    pThread->start();
+    pThread->wait();
+    delete pThread;
+
+    const QJsonArray traceEvents = writeAndParseTraceEvents();
+    EXPECT_EQ(0, countEvents(traceEvents, QStringLiteral("unregistered"), QStringLiteral("X")));
+    EXPECT_EQ(0, countEvents(traceEvents, QStringLiteral("unregistered"), QStringLiteral("i")));
+}
+
+TEST_F(TraceRecorderTest, ReuseRingOfExitedThread) {
+    // Like the audio callback thread that is replaced when reopening the
+    // sound device
+    for (int i = 0; i < 2; ++i) {
+        QThread* pThread = QThread::create([] {
+            mixxx::TraceRecorder::registerCurrentThread();
+            mixxx::TraceRecorder::recordInstant("restarted");
+        });
+        pThread->start();
+        pThread->wait();
+        delete pThread;
+    }
+
+    const QJsonArray traceEvents = writeAndParseTraceEvents();
+    const QList<int> threadIds = threadIdsOfEvents(traceEvents, QStringLiteral("restarted"));
+    ASSERT_EQ(2, threadIds.size());
+    EXPECT_EQ(threadIds.first(), threadIds.last());
+}
+
+TEST_F(TraceRecorderTest, KeepsMostRecentEvents) {
+    for (int i = 0; i < mixxx::TraceRecorder::kEventsPerThread; ++i) {
+        mixxx::ScopedTraceSpan span("old");
+    }
+    for (int i = 0; i < 10; ++i) {
+        mixxx::ScopedTraceSpan span("new");
+    }
+
+    const QJsonArray traceEvents = writeAndParseTraceEvents();
+    EXPECT_EQ(10, countEvents(traceEvents, QStringLiteral("new"), QStringLiteral("X")));
+    EXPECT_EQ(mixxx::TraceRecorder::kEventsPerThread - 10,
+            countEvents(traceEvents, QStringLiteral("old"), QStringLiteral("X")));
+}
+
+} // namespace
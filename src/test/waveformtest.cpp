@@ -0,0 +1,170 @@
+#include <benchmark/benchmark.h>
+#include <gtest/gtest.h>
+
+#include <memory>
+
+#include "waveform/waveform.h"
+
+namespace {
+
+constexpr int kAudioSampleRate = 44100;
+constexpr int kVisualSampleRate = 441;
+
+// About 6 minutes of audio
+constexpr SINT kFrameLength = 16 * 1024 * 1024;
+
+std::unique_ptr<Waveform> createWaveform(int stemCount) {
+    auto pWaveform = std::make_unique<Waveform>(
+            kAudioSampleRate, kFrameLength, kVisualSampleRate, -1, stemCount);
+    WaveformData* pData = pWaveform->data();
+    for (int i = 0; i < pWaveform->getDataSize(); ++i) {
+        pData[i].filtered.low = static_cast<unsigned char>(i);
+        pData[i].filtered.mid = static_cast<unsigned char>(i + 1);
+        pData[i].filtered.high = static_cast<unsigned char>(i + 2);
+        pData[i].filtered.all = static_cast<unsigned char>(i + 3);
+        for (int stemIdx = 0; stemIdx < stemCount; ++stemIdx) {
+            pData[i].stems[stemIdx] = static_cast<unsigned char>(i + stemIdx);
+        }
+    }
+    pWaveform->setCompletion(pWaveform->getDataSize());
+    return pWaveform;
+}
+
+void expectWaveformsEqual(const Waveform& expected, const Waveform& actual, int stemCount) {
+    ASSERT_EQ(expected.getDataSize(), actual.getDataSize());
+    EXPECT_EQ(expected.getAudioVisualRatio(), actual.getAudioVisualRatio());
+    EXPECT_EQ(expected.getDataSize(), actual.getCompletion());
+    EXPECT_EQ(expected.hasStem(), actual.hasStem());
+    for (int i = 0; i < expected.getDataSize(); ++i) {
+        EXPECT_EQ(expected.getLow(i), actual.getLow(i));
+        EXPECT_EQ(expected.getMid(i), actual.getMid(i));
+        EXPECT_EQ(expected.getHigh(i), actual.getHigh(i));
+        EXPECT_EQ(expected.getAll(i), actual.getAll(i));
+        for (int stemIdx = 0; stemIdx < stemCount; ++stemIdx) {
+            EXPECT_EQ(expected.get(i).stems[stemIdx], actual.get(i).stems[stemIdx]);
+        }
+    }
+}
+
+class WaveformTest : public testing::Test {
+};
+
+TEST_F(WaveformTest, packedRoundtrip) {
+    const auto pWaveform = createWaveform(0);
+    const QByteArray packed = pWaveform->toPackedByteArray();
+    EXPECT_TRUE(Waveform::isPackedByteArray(packed));
+    const Waveform waveform(packed);
+    expectWaveformsEqual(*pWaveform, waveform, 0);
+    EXPECT_EQ(Waveform::SaveState::Saved, waveform.saveState());
+}
+
+TEST_F(WaveformTest, packedRoundtripWithStems) {
+    const auto pWaveform = createWaveform(mixxx::kMaxSupportedStems);
+    const QByteArray packed = pWaveform->toPackedByteArray();
+    EXPECT_TRUE(Waveform::isPackedByteArray(packed));
+    const Waveform waveform(packed);
+    expectWaveformsEqual(*pWaveform, waveform, mixxx::kMaxSupportedStems);
+    EXPECT_EQ(Waveform::SaveState::Saved, waveform.saveState());
+}
+
+TEST_F(WaveformTest, legacyProtobufFormat) {
+    const auto pWaveform = createWaveform(0);
+    const QByteArray data = pWaveform->toByteArray();
+    EXPECT_FALSE(Waveform::isPackedByteArray(data));
+    EXPECT_FALSE(Waveform::isPackedByteArray(qCompress(data)));
+    const Waveform waveform(data);
+    expectWaveformsEqual(*pWaveform, waveform, 0);
+    // Migrated to the packed format when it is saved
+    EXPECT_EQ(Waveform::SaveState::SavePending, waveform.saveState());
+}
+
+TEST_F(WaveformTest, truncatedPackedData) {
+    const auto pWaveform = createWaveform(0);
+    QByteArray packed = pWaveform->toPackedByteArray();
+    packed.chop(1);
+    const Waveform waveform(packed);
+    EXPECT_EQ(0, waveform.getDataSize());
+    EXPECT_EQ(Waveform::SaveState::NotSaved, waveform.saveState());
+}
+
+TEST_F(WaveformTest, maxPyramid) {
+    const auto pWaveform = createWaveform(mixxx::kMaxSupportedStems);
+    // Incomplete waveforms are scanned without building the pyramid
+    pWaveform->setCompletion(0);
+    const auto pWaveformWithPyramid = createWaveform(mixxx::kMaxSupportedStems);
+    const int frameCount = pWaveformWithPyramid->getDataSize() / 2;
+    const int ranges[][2] = {
+            {0, 0},
+            {0, 1},
+            {1, 2},
+            {3, 17},
+            {-5, 300},
+            {255, 257},
+            {1000, 5000},
+            {frameCount - 300, frameCount + 10},
+            {0, frameCount},
+    };
+    for (const auto& range : ranges) {
+        for (int chn = 0; chn < 2; ++chn) {
+            const WaveformData expected = pWaveform->getMax(chn, range[0], range[1]);
+            const WaveformData actual =
+                    pWaveformWithPyramid->getMax(chn, range[0], range[1]);
+            EXPECT_EQ(expected.filtered.low, actual.filtered.low);
+            EXPECT_EQ(expected.filtered.mid, actual.filtered.mid);
+            EXPECT_EQ(expected.filtered.high, actual.filtered.high);
+            EXPECT_EQ(expected.filtered.all, actual.filtered.all);
+            for (int stemIdx = 0; stemIdx < mixxx::kMaxSupportedStems; ++stemIdx) {
+                EXPECT_EQ(expected.stems[stemIdx], actual.stems[stemIdx]);
+            }
+        }
+    }
+}
+
+// Looks up the maxima for a single pixel column of a zoomed out waveform
+static void BM_WaveformGetMax(benchmark::State& state) {
+    const auto pWaveform = createWaveform(0);
+    if (state.range(1)) {
+        // Build the pyramid before measuring
+        pWaveform->getMax(0, 0, 0);
+    } else {
+        pWaveform->setCompletion(0);
+    }
+    const int framesPerPixel = static_cast<int>(state.range(0));
+    const int frameCount = pWaveform->getDataSize() / 2;
+    int frameStart = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(pWaveform->getMax(0, frameStart, frameStart + framesPerPixel));
+        frameStart = (frameStart + framesPerPixel) % frameCount;
+    }
+}
+BENCHMARK(BM_WaveformGetMax)
+        ->Args({4, 0})
+        ->Args({4, 1})
+        ->Args({64, 0})
+        ->Args({64, 1})
+        ->Args({1024, 0})
+        ->Args({1024, 1});
+
+// Compares the load latency of the legacy analysis files (compressed
+// protobuf) with the packed format that is stored uncompressed.
+static void BM_WaveformLoadLegacy(benchmark::State& state) {
+    const auto pWaveform = createWaveform(static_cast<int>(state.range(0)));
+    const QByteArray stored = qCompress(pWaveform->toByteArray());
+    for (auto _ : state) {
+        const Waveform waveform(qUncompress(stored));
+        benchmark::DoNotOptimize(waveform.getDataSize());
+    }
+}
+BENCHMARK(BM_WaveformLoadLegacy)->Arg(0)->Arg(mixxx::kMaxSupportedStems);
+
+static void BM_WaveformLoadPacked(benchmark::State& state) {
+    const auto pWaveform = createWaveform(static_cast<int>(state.range(0)));
+    const QByteArray stored = pWaveform->toPackedByteArray();
+    for (auto _ : state) {
+        const Waveform waveform(stored);
+        benchmark::DoNotOptimize(waveform.getDataSize());
+    }
+}
+BENCHMARK(BM_WaveformLoadPacked)->Arg(0)->Arg(mixxx::kMaxSupportedStems);
+
+} // namespace
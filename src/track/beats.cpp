@@ -689,6 +689,14 @@ std::optional<BeatsPointer> Beats::trySetBpm(mixxx::Bpm bpm) const {
     return BeatsPointer(new Beats({}, *it, bpm, m_sampleRate, m_subVersion));
 }
 
+BeatsPointer Beats::withSubVersion(const QString& subVersion) const {
+    return BeatsPointer(new Beats(m_markers,
+            m_lastMarkerPosition,
+            m_lastMarkerBpm,
+            m_sampleRate,
+            subVersion));
+}
+
 bool Beats::isValid() const {
     if (!m_lastMarkerPosition.isValid() || !m_lastMarkerBpm.isValid()) {
         return false;
@@ -409,6 +409,9 @@ class Beats : private std::enable_shared_from_this<Beats> {
     /// failure.
     std::optional<BeatsPointer> trySetBpm(mixxx::Bpm bpm) const;
 
+    /// Returns the same beats with a different sub-version.
+    BeatsPointer withSubVersion(const QString& subVersion) const;
+
   protected:
     /// Type tag for making public constructors of derived classes inaccessible.
     ///
@@ -37,16 +37,22 @@ class AlphaBetaFilter {
     // Because the values come from a digital controller, the values for dx are
     // discrete rather than smooth.
     void observation(double dx) {
+        observation(dx, m_dt);
+    }
+
+    // Input an observation that covers dt seconds instead of the dt passed
+    // to init(), e.g. the measured time between two controller messages.
+    void observation(double dx, double dt) {
         if (!m_initialized) {
             return;
         }
 
-        double predicted_x = m_x + m_v * m_dt;
+        double predicted_x = m_x + m_v * dt;
         double predicted_v = m_v;
         double residual_x = dx - predicted_x;
 
         m_x = predicted_x + residual_x * m_alpha;
-        m_v = predicted_v + residual_x * m_beta / m_dt;
+        m_v = predicted_v + residual_x * m_beta / dt;
 
         // relative to previous
         m_x -= dx;
@@ -236,6 +236,16 @@ bool CmdlineArgs::parse(const QStringList& arguments, CmdlineArgs::ParseMode mod
     parser.addOption(timelinePath);
     parser.addOption(timelinePathDeprecated);
 
+    const QCommandLineOption tracePath(QStringLiteral("trace-path"),
+            forUserFeedback ? QCoreApplication::translate("CmdlineArgs",
+                                      "Records a timeline of the audio processing "
+                                      "and writes it to the given path on exit. The "
+                                      "file can be opened with chrome://tracing or "
+                                      "https://ui.perfetto.dev")
+                            : QString(),
+            QStringLiteral("path"));
+    parser.addOption(tracePath);
+
     const QCommandLineOption enableLegacyVuMeter(QStringLiteral("enable-legacy-vumeter"),
             forUserFeedback ? QCoreApplication::translate("CmdlineArgs",
                                       "Use legacy vu meter")
@@ -441,6 +451,10 @@ bool CmdlineArgs::parse(const QStringList& arguments, CmdlineArgs::ParseMode mod
         m_timelinePath = parser.value(timelinePathDeprecated);
     }
 
+    if (parser.isSet(tracePath)) {
+        m_tracePath = parser.value(tracePath);
+    }
+
     m_useLegacyVuMeter = parser.isSet(enableLegacyVuMeter);
     m_useLegacySpinny = parser.isSet(enableLegacySpinny);
     m_controllerDebug = parser.isSet(controllerDebug) || parser.isSet(controllerDebugDeprecated);
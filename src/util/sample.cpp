@@ -817,6 +817,41 @@ void SampleUtil::mixMultichannelToStereo(CSAMPLE* pDest,
     }
 }
 
+// static
+void SampleUtil::mixMultichannelToStereoWithRampingGain(CSAMPLE* M_RESTRICT pDest,
+        const CSAMPLE* M_RESTRICT pSrc,
+        const CSAMPLE_GAIN* pOldGains,
+        const CSAMPLE_GAIN* pNewGains,
+        SINT numFrames,
+        mixxx::audio::ChannelCount numChannels,
+        int excludeChannelMask) {
+    DEBUG_ASSERT(numChannels > mixxx::audio::ChannelCount::stereo());
+    const int stereoChCount = numChannels / mixxx::audio::ChannelCount::stereo();
+    DEBUG_ASSERT(stereoChCount < static_cast<int>(sizeof(excludeChannelMask) * 8));
+    SampleUtil::clear(pDest, numFrames * mixxx::audio::ChannelCount::stereo());
+    for (int stemIdx = 0; stemIdx < stereoChCount; stemIdx++) {
+        if (excludeChannelMask >> stemIdx & 0b1) {
+            continue;
+        }
+        const CSAMPLE_GAIN oldGain = pOldGains[stemIdx];
+        const CSAMPLE_GAIN newGain = pNewGains[stemIdx];
+        if (oldGain == CSAMPLE_GAIN_ZERO && newGain == CSAMPLE_GAIN_ZERO) {
+            // no need to add silence
+            continue;
+        }
+        const CSAMPLE* pStem = pSrc + stemIdx * mixxx::audio::ChannelCount::stereo();
+        // Same ramp as in copyWithRampingGain()
+        const CSAMPLE_GAIN gainDelta = (newGain - oldGain) / CSAMPLE_GAIN(numFrames);
+        const CSAMPLE_GAIN startGain = oldGain + gainDelta;
+        // note: LOOP VECTORIZED only with "int i" (not SINT i).
+        for (int i = 0; i < numFrames; ++i) {
+            const CSAMPLE_GAIN gain = startGain + gainDelta * i;
+            pDest[i * 2] += pStem[i * numChannels] * gain;
+            pDest[i * 2 + 1] += pStem[i * numChannels + 1] * gain;
+        }
+    }
+}
+
 // static
 void SampleUtil::doubleMonoToDualMono(CSAMPLE* pBuffer, SINT numFrames) {
     // backward loop
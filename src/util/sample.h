@@ -335,6 +335,20 @@ class SampleUtil {
             SINT numFrames,
             mixxx::audio::ChannelCount numChannels);
 
+    // Mixes the stereo pairs of a multi channel buffer down to stereo like
+    // mixMultichannelToStereo() while applying a separate gain ramp from
+    // pOldGains[i] to pNewGains[i] to the i-th stereo pair. This replaces
+    // extracting, scaling and re-inserting each stereo pair on its own.
+    // pOldGains and pNewGains must hold one gain per stereo pair. Stereo
+    // pairs selected by the exclude channel mask are not mixed.
+    static void mixMultichannelToStereoWithRampingGain(CSAMPLE* pDest,
+            const CSAMPLE* pSrc,
+            const CSAMPLE_GAIN* pOldGains,
+            const CSAMPLE_GAIN* pNewGains,
+            SINT numFrames,
+            mixxx::audio::ChannelCount numChannels,
+            int excludeChannelMask = 0);
+
     // In-place doubles the mono samples in pBuffer to dual mono samples.
     // (numFrames) samples will be read from pBuffer
     // (numFrames * 2) samples will be written into pBuffer
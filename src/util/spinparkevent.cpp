@@ -0,0 +1,117 @@
+#include "util/spinparkevent.h"
+
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#include <immintrin.h>
+#endif
+
+#include "util/assert.h"
+
+namespace {
+
+// The number of polling iterations before the waiting thread gets parked.
+// This is in the order of tens of microseconds, which is enough to cover
+// the hand off of a job that is processed in parallel with the waiting
+// thread, without burning a CPU core while the engine thread is idle.
+constexpr int kSpinCount = 2000;
+
+inline void cpuRelax() {
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+    _mm_pause();
+#elif defined(__aarch64__) || (defined(__arm__) && __ARM_ARCH >= 7)
+    __asm__ __volatile__("yield");
+#endif
+}
+
+} // anonymous namespace
+
+#ifdef __linux__
+static_assert(sizeof(std::atomic<int>) == sizeof(int),
+        "The futex requires a plain 32-bit integer");
+#endif
+static_assert(std::atomic<int>::is_always_lock_free);
+
+SpinParkEvent::SpinParkEvent()
+        : m_state(kUnset) {
+}
+
+void SpinParkEvent::set() {
+    if (m_state.exchange(kSet, std::memory_order_acq_rel) == kParked) {
+        unpark();
+    }
+}
+
+bool SpinParkEvent::tryWait() {
+    int expected = kSet;
+    return m_state.compare_exchange_strong(expected,
+            kUnset,
+            std::memory_order_acquire,
+            std::memory_order_relaxed);
+}
+
+void SpinParkEvent::wait() {
+    for (int i = 0; i < kSpinCount; ++i) {
+        // Only attempt the read-modify-write operation when the event is
+        // likely to succeed, to keep the cache line shared while spinning.
+        if (m_state.load(std::memory_order_relaxed) == kSet && tryWait()) {
+            return;
+        }
+        cpuRelax();
+    }
+    int expected = kUnset;
+    if (m_state.compare_exchange_strong(expected,
+                kParked,
+                std::memory_order_acquire,
+                std::memory_order_acquire)) {
+        park();
+    } else {
+        // The event has been set after we stopped spinning
+        DEBUG_ASSERT(expected == kSet);
+    }
+    DEBUG_ASSERT(m_state.load(std::memory_order_relaxed) == kSet);
+    m_state.store(kUnset, std::memory_order_relaxed);
+}
+
+#ifdef __linux__
+
+void SpinParkEvent::park() {
+    // Spurious wake ups are possible, so we have to check the state again
+    while (m_state.load(std::memory_order_acquire) == kParked) {
+        syscall(SYS_futex,
+                reinterpret_cast<int*>(&m_state),
+                FUTEX_WAIT_PRIVATE,
+                kParked,
+                nullptr,
+                nullptr,
+                0);
+    }
+}
+
+void SpinParkEvent::unpark() {
+    syscall(SYS_futex,
+            reinterpret_cast<int*>(&m_state),
+            FUTEX_WAKE_PRIVATE,
+            1,
+            nullptr,
+            nullptr,
+            0);
+}
+
+#else
+
+void SpinParkEvent::park() {
+    // set() releases the semaphore exactly once after it observed the
+    // parked state
+    m_parkSema.acquire();
+}
+
+void SpinParkEvent::unpark() {
+    m_parkSema.release();
+}
+
+#endif
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <QSemaphore>
+#include <atomic>
+
+/// A binary, auto-resetting event for handing off work between the engine
+/// thread and a dedicated worker thread.
+///
+/// wait() spins for a bounded number of iterations before parking the
+/// calling thread, so short hand offs never leave user space. set() never
+/// allocates or locks and only enters the kernel if the waiting thread has
+/// actually been parked. Parking uses a futex on Linux and falls back to a
+/// semaphore on other platforms.
+///
+/// At most one thread may wait on the event at any time.
+class SpinParkEvent {
+  public:
+    SpinParkEvent();
+
+    /// Sets the event and wakes up the waiting thread if it has been parked.
+    void set();
+
+    /// Blocks until the event is set, then resets it.
+    void wait();
+
+    /// Resets the event if it is set without blocking. Returns whether the
+    /// event has been set.
+    bool tryWait();
+
+    bool isSet() const {
+        return m_state.load(std::memory_order_acquire) == kSet;
+    }
+
+  private:
+    static constexpr int kUnset = 0;
+    static constexpr int kSet = 1;
+    static constexpr int kParked = 2;
+
+    void park();
+    void unpark();
+
+    std::atomic<int> m_state;
+#ifndef __linux__
+    QSemaphore m_parkSema;
+#endif
+};
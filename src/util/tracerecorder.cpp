@@ -0,0 +1,281 @@
+#include "util/tracerecorder.h"
+
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMutex>
+#include <QThread>
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include "util/compatibility/qmutex.h"
+#include "util/logger.h"
+
+namespace mixxx {
+
+namespace {
+
+const Logger kLogger("TraceRecorder");
+
+constexpr quint64 kEventIndexMask = TraceRecorder::kEventsPerThread - 1;
+static_assert((TraceRecorder::kEventsPerThread & kEventIndexMask) == 0,
+        "The number of events must be a power of 2");
+
+// Marks instant events
+constexpr qint64 kInstantEndNanos = -1;
+
+// All fields are atomic, because the ring buffer is read while the owning
+// thread continues writing into it. Relaxed atomic stores are as cheap as
+// plain stores on all supported platforms.
+struct TraceEvent {
+    std::atomic<const char*> name;
+    std::atomic<qint64> startNanos;
+    std::atomic<qint64> endNanos;
+};
+
+class TraceEventRing {
+  public:
+    explicit TraceEventRing(int threadId)
+            : m_threadId(threadId),
+              m_inUse(false),
+              m_events(new TraceEvent[TraceRecorder::kEventsPerThread]),
+              m_writeStarted(0),
+              m_writeFinished(0) {
+    }
+
+    int threadId() const {
+        return m_threadId;
+    }
+    const QString& threadName() const {
+        return m_threadName;
+    }
+
+    // The ownership is only changed while holding s_ringsMutex
+    bool isInUse() const {
+        return m_inUse;
+    }
+    void acquire(QString threadName) {
+        m_threadName = std::move(threadName);
+        m_inUse = true;
+    }
+    void release() {
+        m_inUse = false;
+    }
+
+    // Only called from the owning thread
+    void write(const char* name, qint64 startNanos, qint64 endNanos) {
+        const quint64 index = m_writeFinished.load(std::memory_order_relaxed);
+        // Seqlock: Readers discard events that might have been overwritten
+        // while copying them
+        m_writeStarted.store(index + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        TraceEvent& event = m_events[index & kEventIndexMask];
+        event.name.store(name, std::memory_order_relaxed);
+        event.startNanos.store(startNanos, std::memory_order_relaxed);
+        event.endNanos.store(endNanos, std::memory_order_relaxed);
+        m_writeFinished.store(index + 1, std::memory_order_release);
+    }
+
+    struct Snapshot {
+        const char* name;
+        qint64 startNanos;
+        qint64 endNanos;
+    };
+
+    std::vector<Snapshot> snapshot() const {
+        const quint64 end = m_writeFinished.load(std::memory_order_acquire);
+        const quint64 begin = end > static_cast<quint64>(TraceRecorder::kEventsPerThread)
+                ? end - TraceRecorder::kEventsPerThread
+                : 0;
+        std::vector<Snapshot> events;
+        events.reserve(end - begin);
+        for (quint64 i = begin; i < end; ++i) {
+            const TraceEvent& event = m_events[i & kEventIndexMask];
+            events.push_back(Snapshot{
+                    event.name.load(std::memory_order_relaxed),
+                    event.startNanos.load(std::memory_order_relaxed),
+                    event.endNanos.load(std::memory_order_relaxed)});
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        // Drop the oldest events that have been overwritten in the meantime
+        const quint64 overwritten = m_writeStarted.load(std::memory_order_relaxed);
+        const quint64 firstValid = overwritten > static_cast<quint64>(
+                                                         TraceRecorder::kEventsPerThread)
+                ? overwritten - TraceRecorder::kEventsPerThread
+                : 0;
+        if (firstValid > begin) {
+            const auto overwrittenCount = std::min(firstValid, end) - begin;
+            events.erase(events.begin(),
+                    events.begin() + static_cast<std::ptrdiff_t>(overwrittenCount));
+        }
+        return events;
+    }
+
+    void clear() {
+        m_writeStarted.store(0, std::memory_order_relaxed);
+        m_writeFinished.store(0, std::memory_order_relaxed);
+    }
+
+  private:
+    const int m_threadId;
+    QString m_threadName;
+    bool m_inUse;
+    const std::unique_ptr<TraceEvent[]> m_events;
+    std::atomic<quint64> m_writeStarted;
+    std::atomic<quint64> m_writeFinished;
+};
+
+// The ring buffers are never deleted, because threads may exit while
+// their events are still needed for the export. Instead the ring of an
+// exited thread is handed over to the next thread that registers, e.g.
+// the new audio callback thread after the sound device has been reopened.
+QMutex s_ringsMutex;
+std::vector<std::unique_ptr<TraceEventRing>> s_rings;
+
+// Kept separate from the registration below, because accessing a
+// thread_local with a destructor is more expensive on the hot path.
+thread_local TraceEventRing* t_pRing = nullptr;
+
+// Releases the ring of the thread when it exits
+class RingRegistration {
+  public:
+    ~RingRegistration() {
+        if (!m_pRing) {
+            return;
+        }
+        const auto locker = lockMutex(&s_ringsMutex);
+        m_pRing->release();
+    }
+
+    TraceEventRing* m_pRing = nullptr;
+};
+
+thread_local RingRegistration t_ringRegistration;
+
+void registerRingForCurrentThread() {
+    QString threadName = QThread::currentThread()->objectName();
+    const auto locker = lockMutex(&s_ringsMutex);
+    TraceEventRing* pRing = nullptr;
+    for (const auto& pReleasedRing : s_rings) {
+        if (!pReleasedRing->isInUse()) {
+            pRing = pReleasedRing.get();
+            break;
+        }
+    }
+    if (!pRing) {
+        const int threadId = static_cast<int>(s_rings.size()) + 1;
+        s_rings.push_back(std::make_unique<TraceEventRing>(threadId));
+        pRing = s_rings.back().get();
+    }
+    if (threadName.isEmpty()) {
+        threadName = QStringLiteral("Thread %1").arg(pRing->threadId());
+    }
+    pRing->acquire(std::move(threadName));
+    t_pRing = pRing;
+    t_ringRegistration.m_pRing = pRing;
+}
+
+} // anonymous namespace
+
+// static
+std::atomic<bool> TraceRecorder::s_enabled{false};
+
+// static
+void TraceRecorder::registerCurrentThread() {
+    if (t_pRing || !isEnabled()) {
+        return;
+    }
+    registerRingForCurrentThread();
+}
+
+// static
+void TraceRecorder::recordSpan(const char* name, qint64 startNanos, qint64 endNanos) {
+    if (!t_pRing) {
+        return;
+    }
+    t_pRing->write(name, startNanos, endNanos);
+}
+
+// static
+void TraceRecorder::recordInstant(const char* name) {
+    if (!isEnabled() || !t_pRing) {
+        return;
+    }
+    t_pRing->write(name, nowNanos(), kInstantEndNanos);
+}
+
+// static
+void TraceRecorder::clear() {
+    const auto locker = lockMutex(&s_ringsMutex);
+    for (const auto& pRing : s_rings) {
+        pRing->clear();
+    }
+}
+
+// static
+bool TraceRecorder::writeChromeTrace(const QString& filePath) {
+    QJsonArray traceEvents;
+    {
+        const auto locker = lockMutex(&s_ringsMutex);
+        // Timestamps are written in microseconds relative to the oldest event
+        std::vector<std::vector<TraceEventRing::Snapshot>> snapshots;
+        snapshots.reserve(s_rings.size());
+        qint64 originNanos = std::numeric_limits<qint64>::max();
+        for (const auto& pRing : s_rings) {
+            snapshots.push_back(pRing->snapshot());
+            if (!snapshots.back().empty()) {
+                originNanos = std::min(originNanos, snapshots.back().front().startNanos);
+            }
+        }
+        for (std::size_t i = 0; i < s_rings.size(); ++i) {
+            const auto& pRing = s_rings[i];
+            traceEvents.append(QJsonObject{
+                    {QStringLiteral("name"), QStringLiteral("thread_name")},
+                    {QStringLiteral("ph"), QStringLiteral("M")},
+                    {QStringLiteral("pid"), 1},
+                    {QStringLiteral("tid"), pRing->threadId()},
+                    {QStringLiteral("args"),
+                            QJsonObject{{QStringLiteral("name"), pRing->threadName()}}},
+            });
+            for (const auto& event : snapshots[i]) {
+                QJsonObject traceEvent{
+                        {QStringLiteral("name"), QString::fromLatin1(event.name)},
+                        {QStringLiteral("pid"), 1},
+                        {QStringLiteral("tid"), pRing->threadId()},
+                        {QStringLiteral("ts"), (event.startNanos - originNanos) / 1000.0},
+                };
+                if (event.endNanos == kInstantEndNanos) {
+                    traceEvent.insert(QStringLiteral("ph"), QStringLiteral("i"));
+                    // Draw a line across the thread
+                    traceEvent.insert(QStringLiteral("s"), QStringLiteral("t"));
+                } else {
+                    traceEvent.insert(QStringLiteral("ph"), QStringLiteral("X"));
+                    traceEvent.insert(QStringLiteral("dur"),
+                            (event.endNanos - event.startNanos) / 1000.0);
+                }
+                traceEvents.append(traceEvent);
+            }
+        }
+    }
+
+    QFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        kLogger.warning() << "Failed to open" << filePath << file.errorString();
+        return false;
+    }
+    const QJsonObject trace{
+            {QStringLiteral("traceEvents"), traceEvents},
+            {QStringLiteral("displayTimeUnit"), QStringLiteral("ns")},
+    };
+    if (file.write(QJsonDocument(trace).toJson(QJsonDocument::Compact)) < 0) {
+        kLogger.warning() << "Failed to write" << filePath << file.errorString();
+        return false;
+    }
+    kLogger.info() << "Wrote" << traceEvents.size() << "trace events to" << filePath;
+    return true;
+}
+
+} // namespace mixxx
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <QString>
+#include <QtGlobal>
+#include <atomic>
+#include <chrono>
+
+namespace mixxx {
+
+/// Records a timeline of short, time-critical code paths like the audio
+/// callback that can be inspected after the fact, e.g. to find out what
+/// caused an xrun.
+///
+/// Each thread writes into its own fixed-size ring buffer without locking,
+/// the oldest events are overwritten. Recording is disabled by default and
+/// costs a single relaxed atomic load per span while disabled. Only the
+/// events of threads that have been registered in advance are recorded,
+/// so recording never allocates or locks on a real-time thread.
+///
+/// The timeline is exported in the Chrome trace event format that can be
+/// opened with chrome://tracing or https://ui.perfetto.dev.
+class TraceRecorder {
+  public:
+    /// Number of events that are kept per thread
+    static constexpr int kEventsPerThread = 1 << 14;
+
+    static void setEnabled(bool enabled) {
+        s_enabled.store(enabled, std::memory_order_relaxed);
+    }
+    static bool isEnabled() {
+        return s_enabled.load(std::memory_order_relaxed);
+    }
+
+    static qint64 nowNanos() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch())
+                .count();
+    }
+
+    /// Allocates the ring buffer of the calling thread if recording is
+    /// enabled. Must be called during the setup of the thread, e.g. by the
+    /// first audio callback, and does nothing if called again. The buffer
+    /// of a thread that has exited is reused, so restarting a thread does
+    /// not allocate another one.
+    static void registerCurrentThread();
+
+    /// Records a span of the calling thread. The name must be a string
+    /// literal or otherwise outlive the recorder.
+    static void recordSpan(const char* name, qint64 startNanos, qint64 endNanos);
+
+    /// Records an instant event of the calling thread, e.g. an xrun.
+    static void recordInstant(const char* name);
+
+    /// Writes the events of all threads that are currently available.
+    /// Thread-safe, may be called while recording.
+    static bool writeChromeTrace(const QString& filePath);
+
+    /// Discards all recorded events. Not thread-safe, only for tests.
+    static void clear();
+
+  private:
+    static std::atomic<bool> s_enabled;
+};
+
+/// Records the lifetime of the scope as a span if recording is enabled.
+class ScopedTraceSpan final {
+  public:
+    explicit ScopedTraceSpan(const char* name)
+            : m_name(TraceRecorder::isEnabled() ? name : nullptr),
+              m_startNanos(m_name ? TraceRecorder::nowNanos() : 0) {
+    }
+    ~ScopedTraceSpan() {
+        if (m_name) {
+            TraceRecorder::recordSpan(m_name, m_startNanos, TraceRecorder::nowNanos());
+        }
+    }
+
+    ScopedTraceSpan(const ScopedTraceSpan&) = delete;
+    ScopedTraceSpan& operator=(const ScopedTraceSpan&) = delete;
+
+  private:
+    const char* const m_name;
+    const qint64 m_startNanos;
+};
+
+} // namespace mixxx
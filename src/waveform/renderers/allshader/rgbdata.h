@@ -2,6 +2,7 @@
 
 #include <QVector3D>
 #include <QVector>
+#include <algorithm>
 
 namespace allshader {
 class RGBData;
@@ -19,9 +20,15 @@ class allshader::RGBData {
         mData.push_back({r, g, b});
         mData.push_back({r, g, b});
     }
+    void setForRectangle(int index, float r, float g, float b) {
+        std::fill_n(mData.data() + index, 6, QVector3D{r, g, b});
+    }
     void clear() {
         mData.clear();
     }
+    void resize(int size) {
+        mData.resize(size);
+    }
     void reserve(int size) {
         mData.reserve(size);
     }
@@ -24,9 +24,28 @@ class allshader::VertexData {
         mData.push_back(b);
         mData.push_back(c);
     }
+    /// Overwrites the two triangles of a rectangle starting at index, for
+    /// geometry that is updated in place.
+    void setRectangle(
+            int index,
+            float x1,
+            float y1,
+            float x2,
+            float y2) {
+        QVector2D* pData = mData.data() + index;
+        pData[0] = {x1, y1};
+        pData[1] = {x2, y1};
+        pData[2] = {x1, y2};
+        pData[3] = {x1, y2};
+        pData[4] = {x2, y2};
+        pData[5] = {x2, y1};
+    }
     void clear() {
         mData.clear();
     }
+    void resize(int size) {
+        mData.resize(size);
+    }
     void reserve(int size) {
         mData.reserve(size);
     }
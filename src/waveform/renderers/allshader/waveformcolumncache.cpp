@@ -0,0 +1,73 @@
+#include "waveform/renderers/allshader/waveformcolumncache.h"
+
+#include <cmath>
+
+namespace {
+
+// Keeps the vertex coordinates exactly representable with a float
+constexpr int kMaxOriginDistance = 1 << 20;
+
+// The visual increment is derived from the displayed positions each frame
+// and is subject to rounding noise even at a constant zoom level
+constexpr double kVisualIncrementTolerance = 1e-9;
+
+} // namespace
+
+namespace allshader {
+
+bool WaveformColumnCache::isCompatible(const Parameters& parameters) const {
+    // Weak pointers are equal only if they share the reference count, so a
+    // new waveform that is allocated at the address of an expired one is
+    // never mistaken for it.
+    if (parameters.pWaveform != m_parameters.pWaveform ||
+            parameters.completion != m_parameters.completion ||
+            parameters.length != m_parameters.length ||
+            parameters.breadth != m_parameters.breadth) {
+        return false;
+    }
+    for (int i = 0; i < 4; ++i) {
+        if (parameters.gains[i] != m_parameters.gains[i]) {
+            return false;
+        }
+    }
+    return std::abs(parameters.visualIncrementPerPixel -
+                   m_parameters.visualIncrementPerPixel) <=
+            kVisualIncrementTolerance * m_parameters.visualIncrementPerPixel;
+}
+
+QVarLengthArray<WaveformColumnCache::ColumnRange, 2> WaveformColumnCache::update(
+        int firstColumn, Parameters parameters) {
+    QVarLengthArray<ColumnRange, 2> ranges;
+    const int length = parameters.length;
+    if (length <= 0) {
+        invalidate();
+        return ranges;
+    }
+    if (!isCompatible(parameters) ||
+            std::abs(firstColumn - m_originColumn) > kMaxOriginDistance) {
+        m_parameters = std::move(parameters);
+        m_originColumn = firstColumn;
+        m_firstColumn = firstColumn;
+        ranges.append({firstColumn, length});
+        return ranges;
+    }
+
+    const int cachedFirstColumn = m_firstColumn;
+    const int cachedEndColumn = m_firstColumn + length;
+    const int endColumn = firstColumn + length;
+    m_firstColumn = firstColumn;
+    if (firstColumn >= cachedEndColumn || endColumn <= cachedFirstColumn) {
+        // Jumped, nothing to reuse
+        ranges.append({firstColumn, length});
+        return ranges;
+    }
+    if (firstColumn < cachedFirstColumn) {
+        ranges.append({firstColumn, cachedFirstColumn - firstColumn});
+    }
+    if (endColumn > cachedEndColumn) {
+        ranges.append({cachedEndColumn, endColumn - cachedEndColumn});
+    }
+    return ranges;
+}
+
+} // namespace allshader
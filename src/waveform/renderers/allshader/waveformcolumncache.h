@@ -0,0 +1,82 @@
+#pragma once
+
+#include <QVarLengthArray>
+#include <QWeakPointer>
+
+#include "waveform/waveform.h"
+
+namespace allshader {
+class WaveformColumnCache;
+}
+
+/// Bookkeeping for reusing the per column geometry of the allshader signal
+/// renderers across frames.
+///
+/// A column is identified by its absolute index, which is the visual frame
+/// at its center divided by the visual increment per pixel. The geometry of
+/// the visible columns is kept in a ring buffer with one slot per column, so
+/// while scrolling only the newly exposed columns have to be generated and
+/// the buffer as a whole is moved into place with a uniform offset. All
+/// columns are regenerated when anything that affects every column changes:
+/// zoom, gain, size or the waveform itself.
+class allshader::WaveformColumnCache {
+  public:
+    struct Parameters {
+        // Only used for identifying the waveform. A cached window must not
+        // keep an ejected track's waveform alive.
+        QWeakPointer<const Waveform> pWaveform;
+        int completion = 0;
+        int length = 0;
+        double visualIncrementPerPixel = 0.0;
+        float breadth = 0.f;
+        float gains[4]{};
+    };
+
+    struct ColumnRange {
+        int first;
+        int count;
+    };
+
+    /// Moves the cached window to the parameters.length columns starting at
+    /// firstColumn and returns the columns whose geometry must be generated.
+    QVarLengthArray<ColumnRange, 2> update(int firstColumn, Parameters parameters);
+
+    /// Forces all columns to be generated by the next update(), e.g. after
+    /// the colors have changed.
+    void invalidate() {
+        m_parameters = Parameters();
+    }
+
+    /// The ring buffer slot for a column of the current window.
+    int slot(int column) const {
+        if (m_parameters.length <= 0) {
+            return 0;
+        }
+        const int slot = (column - m_originColumn) % m_parameters.length;
+        return slot < 0 ? slot + m_parameters.length : slot;
+    }
+    int firstSlot() const {
+        return slot(m_firstColumn);
+    }
+    int slotCount() const {
+        return m_parameters.length;
+    }
+
+    /// The x coordinate of the center of a column in the cached geometry.
+    /// Coordinates are relative to an origin column to retain the float
+    /// precision of the vertices for long tracks at high zoom levels.
+    float x(int column) const {
+        return static_cast<float>(column - m_originColumn);
+    }
+    /// The translation that moves the first column of the window to x = 0.
+    float offset() const {
+        return -x(m_firstColumn);
+    }
+
+  private:
+    bool isCompatible(const Parameters& parameters) const;
+
+    Parameters m_parameters;
+    int m_originColumn = 0;
+    int m_firstColumn = 0;
+};
@@ -16,6 +16,7 @@ WaveformRendererFiltered::WaveformRendererFiltered(
 
 void WaveformRendererFiltered::onSetup(const QDomNode& node) {
     Q_UNUSED(node);
+    m_columnCache.invalidate();
 }
 
 void WaveformRendererFiltered::initializeGL() {
@@ -75,18 +76,27 @@ void WaveformRendererFiltered::paintGL() {
 
     const float heightFactor = allGain * halfBreadth / m_maxValue;
 
-    // Effective visual frame for x
-    double xVisualFrame = qRound(firstVisualFrame / visualIncrementPerPixel) *
-            visualIncrementPerPixel;
-
     const int numVerticesPerLine = 6; // 2 triangles
 
+    // Only the columns that scrolled into view since the last frame are
+    // generated, see WaveformColumnCache. The ring buffer of columns is
+    // translated into place as a whole.
+    const int firstColumn = qRound(firstVisualFrame / visualIncrementPerPixel);
+    const auto columnRanges = m_columnCache.update(firstColumn,
+            {waveform,
+                    waveform->getCompletion(),
+                    length,
+                    visualIncrementPerPixel,
+                    breadth,
+                    {allGain, bandGain[0], bandGain[1], bandGain[2]}});
+
     int reserved[4];
     // low, mid, high
     for (int bandIndex = 0; bandIndex < 3; bandIndex++) {
-        m_vertices[bandIndex].clear();
-        reserved[bandIndex] = numVerticesPerLine * length;
-        m_vertices[bandIndex].reserve(reserved[bandIndex]);
+        reserved[bandIndex] = numVerticesPerLine * m_columnCache.slotCount();
+        if (m_vertices[bandIndex].size() != reserved[bandIndex]) {
+            m_vertices[bandIndex].resize(reserved[bandIndex]);
+        }
     }
 
     // the horizontal line
@@ -94,56 +104,60 @@ void WaveformRendererFiltered::paintGL() {
     m_vertices[3].clear();
     m_vertices[3].reserve(reserved[3]);
 
+    const float axisStart = m_columnCache.x(firstColumn);
     m_vertices[3].addRectangle(
-            0.f,
+            axisStart,
             halfBreadth - 0.5f * devicePixelRatio,
-            static_cast<float>(length),
+            axisStart + static_cast<float>(length),
             halfBreadth + 0.5f * devicePixelRatio);
 
     const double maxSamplingRange = visualIncrementPerPixel / 2.0;
 
-    for (int pos = 0; pos < length; ++pos) {
-        const int visualFrameStart = std::lround(xVisualFrame - maxSamplingRange);
-        const int visualFrameStop = std::lround(xVisualFrame + maxSamplingRange);
+    for (const auto& columnRange : columnRanges) {
+        for (int column = columnRange.first;
+                column < columnRange.first + columnRange.count;
+                ++column) {
+            // Effective visual frame for x
+            const double xVisualFrame = column * visualIncrementPerPixel;
+            const int visualFrameStart = std::lround(xVisualFrame - maxSamplingRange);
+            const int visualFrameStop = std::lround(xVisualFrame + maxSamplingRange);
 
-        const int visualIndexStart = std::max(visualFrameStart * 2, 0);
-        const int visualIndexStop =
-                std::min(std::max(visualFrameStop, visualFrameStart + 1) * 2, dataSize - 1);
+            const int visualIndexStart = std::max(visualFrameStart * 2, 0);
+            const int visualIndexStop =
+                    std::min(std::max(visualFrameStop, visualFrameStart + 1) * 2,
+                            dataSize - 1);
 
-        const float fpos = static_cast<float>(pos);
+            const float fpos = m_columnCache.x(column);
+            const int vertexIndex = numVerticesPerLine * m_columnCache.slot(column);
 
-        // 3 bands, 2 channels
-        float max[3][2]{};
+            // 3 bands, 2 channels
+            float max[3][2]{};
 
-        for (int i = visualIndexStart; i < visualIndexStop; i += 2) {
             for (int chn = 0; chn < 2; chn++) {
-                const WaveformData& waveformData = data[i + chn];
-                const float filteredLow = static_cast<float>(waveformData.filtered.low);
-                const float filteredMid = static_cast<float>(waveformData.filtered.mid);
-                const float filteredHigh = static_cast<float>(waveformData.filtered.high);
-
-                max[0][chn] = math_max(max[0][chn], filteredLow);
-                max[1][chn] = math_max(max[1][chn], filteredMid);
-                max[2][chn] = math_max(max[2][chn], filteredHigh);
+                const WaveformData waveformData = waveform->getMax(
+                        chn, visualIndexStart / 2, (visualIndexStop + 1) / 2);
+                max[0][chn] = static_cast<float>(waveformData.filtered.low);
+                max[1][chn] = static_cast<float>(waveformData.filtered.mid);
+                max[2][chn] = static_cast<float>(waveformData.filtered.high);
             }
-        }
 
-        for (int bandIndex = 0; bandIndex < 3; bandIndex++) {
-            max[bandIndex][0] *= bandGain[bandIndex];
-            max[bandIndex][1] *= bandGain[bandIndex];
-
-            // lines are thin rectangles
-            m_vertices[bandIndex].addRectangle(
-                    fpos - 0.5f,
-                    halfBreadth - heightFactor * max[bandIndex][0],
-                    fpos + 0.5f,
-                    halfBreadth + heightFactor * max[bandIndex][1]);
+            for (int bandIndex = 0; bandIndex < 3; bandIndex++) {
+                max[bandIndex][0] *= bandGain[bandIndex];
+                max[bandIndex][1] *= bandGain[bandIndex];
+
+                // lines are thin rectangles
+                m_vertices[bandIndex].setRectangle(
+                        vertexIndex,
+                        fpos - 0.5f,
+                        halfBreadth - heightFactor * max[bandIndex][0],
+                        fpos + 0.5f,
+                        halfBreadth + heightFactor * max[bandIndex][1]);
+            }
         }
-
-        xVisualFrame += visualIncrementPerPixel;
     }
 
-    const QMatrix4x4 matrix = matrixForWidgetGeometry(m_waveformRenderer, true);
+    QMatrix4x4 matrix = matrixForWidgetGeometry(m_waveformRenderer, true);
+    matrix.translate(m_columnCache.offset(), 0.f);
 
     const int matrixLocation = m_shader.matrixLocation();
     const int colorLocation = m_shader.colorLocation();
@@ -189,7 +203,15 @@ void WaveformRendererFiltered::paintGL() {
         m_shader.setAttributeArray(
                 positionLocation, GL_FLOAT, m_vertices[i].constData(), 2);
 
-        glDrawArrays(GL_TRIANGLES, 0, m_vertices[i].size());
+        if (i < 3) {
+            // The ring buffer of columns wraps around at the slot of the
+            // first visible column
+            const int firstSlotIndex = numVerticesPerLine * m_columnCache.firstSlot();
+            glDrawArrays(GL_TRIANGLES, firstSlotIndex, reserved[i] - firstSlotIndex);
+            glDrawArrays(GL_TRIANGLES, 0, firstSlotIndex);
+        } else {
+            glDrawArrays(GL_TRIANGLES, 0, m_vertices[i].size());
+        }
     }
 
     m_shader.disableAttributeArray(positionLocation);
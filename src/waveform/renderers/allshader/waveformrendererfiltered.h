@@ -3,6 +3,7 @@
 #include "shaders/unicolorshader.h"
 #include "util/class.h"
 #include "waveform/renderers/allshader/vertexdata.h"
+#include "waveform/renderers/allshader/waveformcolumncache.h"
 #include "waveform/renderers/allshader/waveformrenderersignalbase.h"
 
 namespace allshader {
@@ -23,6 +24,7 @@ class allshader::WaveformRendererFiltered final : public allshader::WaveformRend
     const bool m_bRgbStacked;
     mixxx::UnicolorShader m_shader;
     VertexData m_vertices[4];
+    WaveformColumnCache m_columnCache;
 
     DISALLOW_COPY_AND_ASSIGN(WaveformRendererFiltered);
 };
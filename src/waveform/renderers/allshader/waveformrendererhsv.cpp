@@ -16,6 +16,7 @@ WaveformRendererHSV::WaveformRendererHSV(
 
 void WaveformRendererHSV::onSetup(const QDomNode& node) {
     Q_UNUSED(node);
+    m_columnCache.invalidate();
 }
 
 void WaveformRendererHSV::initializeGL() {
@@ -77,110 +78,116 @@ void WaveformRendererHSV::paintGL() {
 
     const float heightFactor = allGain * halfBreadth / m_maxValue;
 
-    // Effective visual frame for x
-    double xVisualFrame = qRound(firstVisualFrame / visualIncrementPerPixel) *
-            visualIncrementPerPixel;
-
     const int numVerticesPerLine = 6; // 2 triangles
 
-    const int reserved = numVerticesPerLine * (length + 1);
-
-    m_vertices.clear();
-    m_vertices.reserve(reserved);
-    m_colors.clear();
-    m_colors.reserve(reserved);
+    // Only the columns that scrolled into view since the last frame are
+    // generated, see WaveformColumnCache
+    const int firstColumn = qRound(firstVisualFrame / visualIncrementPerPixel);
+    const auto columnRanges = m_columnCache.update(firstColumn,
+            {waveform,
+                    waveform->getCompletion(),
+                    length,
+                    visualIncrementPerPixel,
+                    breadth,
+                    {allGain}});
+
+    const int reserved = numVerticesPerLine * (m_columnCache.slotCount() + 1);
+    if (m_vertices.size() != reserved) {
+        m_vertices.resize(reserved);
+        m_colors.resize(reserved);
+    }
 
-    m_vertices.addRectangle(0.f,
+    // The axis occupies the first rectangle and is moved along with the columns
+    const float axisStart = m_columnCache.x(firstColumn);
+    m_vertices.setRectangle(0,
+            axisStart,
             halfBreadth - 0.5f * devicePixelRatio,
-            static_cast<float>(length),
+            axisStart + static_cast<float>(length),
             halfBreadth + 0.5f * devicePixelRatio);
-    m_colors.addForRectangle(
+    m_colors.setForRectangle(0,
             static_cast<float>(m_axesColor_r),
             static_cast<float>(m_axesColor_g),
             static_cast<float>(m_axesColor_b));
 
     const double maxSamplingRange = visualIncrementPerPixel / 2.0;
 
-    for (int pos = 0; pos < length; ++pos) {
-        const int visualFrameStart = std::lround(xVisualFrame - maxSamplingRange);
-        const int visualFrameStop = std::lround(xVisualFrame + maxSamplingRange);
-
-        const int visualIndexStart = std::max(visualFrameStart * 2, 0);
-        const int visualIndexStop =
-                std::min(std::max(visualFrameStop, visualFrameStart + 1) * 2, dataSize - 1);
-
-        const float fpos = static_cast<float>(pos);
-
-        // per channel
-        float maxLow[2]{};
-        float maxMid[2]{};
-        float maxHigh[2]{};
-        float maxAll[2]{};
-
-        for (int chn = 0; chn < 2; chn++) {
-            // Find the max values for low, mid, high and all in the waveform data
-            uchar u8maxLow{};
-            uchar u8maxMid{};
-            uchar u8maxHigh{};
-            uchar u8maxAll{};
-            // data is interleaved left / right
-            for (int i = visualIndexStart + chn; i < visualIndexStop + chn; i += 2) {
-                const WaveformData& waveformData = data[i];
-
-                u8maxLow = math_max(u8maxLow, waveformData.filtered.low);
-                u8maxMid = math_max(u8maxMid, waveformData.filtered.mid);
-                u8maxHigh = math_max(u8maxHigh, waveformData.filtered.high);
-                u8maxAll = math_max(u8maxAll, waveformData.filtered.all);
+    for (const auto& columnRange : columnRanges) {
+        for (int column = columnRange.first;
+                column < columnRange.first + columnRange.count;
+                ++column) {
+            // Effective visual frame for x
+            const double xVisualFrame = column * visualIncrementPerPixel;
+            const int visualFrameStart = std::lround(xVisualFrame - maxSamplingRange);
+            const int visualFrameStop = std::lround(xVisualFrame + maxSamplingRange);
+
+            const int visualIndexStart = std::max(visualFrameStart * 2, 0);
+            const int visualIndexStop =
+                    std::min(std::max(visualFrameStop, visualFrameStart + 1) * 2,
+                            dataSize - 1);
+
+            const float fpos = m_columnCache.x(column);
+            const int vertexIndex = numVerticesPerLine * (1 + m_columnCache.slot(column));
+
+            // per channel
+            float maxLow[2]{};
+            float maxMid[2]{};
+            float maxHigh[2]{};
+            float maxAll[2]{};
+
+            for (int chn = 0; chn < 2; chn++) {
+                // Find the max values for low, mid, high and all in the waveform data
+                const WaveformData waveformData = waveform->getMax(
+                        chn, visualIndexStart / 2, (visualIndexStop + 1) / 2);
+
+                // Cast to float
+                maxLow[chn] = static_cast<float>(waveformData.filtered.low);
+                maxMid[chn] = static_cast<float>(waveformData.filtered.mid);
+                maxHigh[chn] = static_cast<float>(waveformData.filtered.high);
+                maxAll[chn] = static_cast<float>(waveformData.filtered.all);
             }
 
-            // Cast to float
-            maxLow[chn] = static_cast<float>(u8maxLow);
-            maxMid[chn] = static_cast<float>(u8maxMid);
-            maxHigh[chn] = static_cast<float>(u8maxHigh);
-            maxAll[chn] = static_cast<float>(u8maxAll);
-        }
-
-        float total{};
-        float lo{};
-        float hi{};
-
-        if (maxAll[0] != 0.f && maxAll[1] != 0.f) {
-            // Calculate sum, to normalize
-            // Also multiply on 1.2 to prevent very dark or light color
-            total = (maxLow[0] + maxLow[1] + maxMid[0] + maxMid[1] +
-                            maxHigh[0] + maxHigh[1]) *
-                    1.2f;
-
-            // prevent division by zero
-            if (total != 0.f) {
-                // Normalize low and high (mid not need, because it not change the color)
-                lo = (maxLow[0] + maxLow[1]) / total;
-                hi = (maxHigh[0] + maxHigh[1]) / total;
+            float total{};
+            float lo{};
+            float hi{};
+
+            if (maxAll[0] != 0.f && maxAll[1] != 0.f) {
+                // Calculate sum, to normalize
+                // Also multiply on 1.2 to prevent very dark or light color
+                total = (maxLow[0] + maxLow[1] + maxMid[0] + maxMid[1] +
+                                maxHigh[0] + maxHigh[1]) *
+                        1.2f;
+
+                // prevent division by zero
+                if (total != 0.f) {
+                    // Normalize low and high (mid not need, because it not change the color)
+                    lo = (maxLow[0] + maxLow[1]) / total;
+                    hi = (maxHigh[0] + maxHigh[1]) / total;
+                }
             }
-        }
 
-        // Set color
-        QColor color;
-        color.setHsvF(h, 1.0f - hi, 1.0f - lo);
-
-        // lines are thin rectangles
-        // maxAll[0] is for left channel, maxAll[1] is for right channel
-        m_vertices.addRectangle(fpos - 0.5f,
-                halfBreadth - heightFactor * maxAll[0],
-                fpos + 0.5f,
-                halfBreadth + heightFactor * maxAll[1]);
-        m_colors.addForRectangle(
-                static_cast<float>(color.redF()),
-                static_cast<float>(color.greenF()),
-                static_cast<float>(color.blueF()));
-
-        xVisualFrame += visualIncrementPerPixel;
+            // Set color
+            QColor color;
+            color.setHsvF(h, 1.0f - hi, 1.0f - lo);
+
+            // lines are thin rectangles
+            // maxAll[0] is for left channel, maxAll[1] is for right channel
+            m_vertices.setRectangle(vertexIndex,
+                    fpos - 0.5f,
+                    halfBreadth - heightFactor * maxAll[0],
+                    fpos + 0.5f,
+                    halfBreadth + heightFactor * maxAll[1]);
+            m_colors.setForRectangle(vertexIndex,
+                    static_cast<float>(color.redF()),
+                    static_cast<float>(color.greenF()),
+                    static_cast<float>(color.blueF()));
+        }
     }
 
     DEBUG_ASSERT(reserved == m_vertices.size());
     DEBUG_ASSERT(reserved == m_colors.size());
 
-    const QMatrix4x4 matrix = matrixForWidgetGeometry(m_waveformRenderer, true);
+    QMatrix4x4 matrix = matrixForWidgetGeometry(m_waveformRenderer, true);
+    matrix.translate(m_columnCache.offset(), 0.f);
 
     const int matrixLocation = m_shader.matrixLocation();
     const int positionLocation = m_shader.positionLocation();
@@ -197,7 +204,12 @@ void WaveformRendererHSV::paintGL() {
     m_shader.setAttributeArray(
             colorLocation, GL_FLOAT, m_colors.constData(), 3);
 
-    glDrawArrays(GL_TRIANGLES, 0, m_vertices.size());
+    // The axis, followed by the ring buffer of columns which wraps around
+    // at the slot of the first visible column
+    const int firstSlotIndex = numVerticesPerLine * (m_columnCache.firstSlot() + 1);
+    glDrawArrays(GL_TRIANGLES, 0, numVerticesPerLine);
+    glDrawArrays(GL_TRIANGLES, firstSlotIndex, reserved - firstSlotIndex);
+    glDrawArrays(GL_TRIANGLES, numVerticesPerLine, firstSlotIndex - numVerticesPerLine);
 
     m_shader.disableAttributeArray(positionLocation);
     m_shader.disableAttributeArray(colorLocation);
@@ -24,6 +24,7 @@ WaveformRendererRGB::WaveformRendererRGB(WaveformWidgetRenderer* waveformWidget,
 
 void WaveformRendererRGB::onSetup(const QDomNode& node) {
     Q_UNUSED(node);
+    m_columnCache.invalidate();
 }
 
 void WaveformRendererRGB::initializeGL() {
@@ -98,147 +99,168 @@ void WaveformRendererRGB::paintGL() {
     const float mid_b = static_cast<float>(m_rgbMidColor_b);
     const float high_b = static_cast<float>(m_rgbHighColor_b);
 
-    // Effective visual frame for x
-    double xVisualFrame = qRound(firstVisualFrame / visualIncrementPerPixel) *
-            visualIncrementPerPixel;
-
     const int numVerticesPerLine = 6; // 2 triangles
+    // Slip renderer only render a single channel, so the vertices count doesn't change
+    const int numVerticesPerColumn =
+            numVerticesPerLine * (splitLeftRight && !m_isSlipRenderer ? 2 : 1);
+
+    // Only the columns that scrolled into view since the last frame are
+    // generated, see WaveformColumnCache
+    const int firstColumn = qRound(firstVisualFrame / visualIncrementPerPixel);
+    const auto columnRanges = m_columnCache.update(firstColumn,
+            {waveform,
+                    waveform->getCompletion(),
+                    length,
+                    visualIncrementPerPixel,
+                    breadth,
+                    {allGain, lowGain, midGain, highGain}});
+
+    const int reserved = numVerticesPerLine + numVerticesPerColumn * m_columnCache.slotCount();
+    if (m_vertices.size() != reserved) {
+        m_vertices.resize(reserved);
+        m_colors.resize(reserved);
+    }
 
-    const int reserved = numVerticesPerLine *
-            // Slip rendere only render a single channel, so the vertices count doesn't change
-            ((splitLeftRight && !m_isSlipRenderer ? length * 2 : length) + 1);
-
-    m_vertices.clear();
-    m_vertices.reserve(reserved);
-    m_colors.clear();
-    m_colors.reserve(reserved);
-
-    m_vertices.addRectangle(0.f,
+    // The axis occupies the first rectangle and is moved along with the columns
+    const float axisStart = m_columnCache.x(firstColumn);
+    m_vertices.setRectangle(0,
+            axisStart,
             halfBreadth - 0.5f * devicePixelRatio,
-            static_cast<float>(length),
+            axisStart + static_cast<float>(length),
             m_isSlipRenderer ? halfBreadth : halfBreadth + 0.5f * devicePixelRatio);
-    m_colors.addForRectangle(
+    m_colors.setForRectangle(0,
             static_cast<float>(m_axesColor_r),
             static_cast<float>(m_axesColor_g),
             static_cast<float>(m_axesColor_b));
 
     const double maxSamplingRange = visualIncrementPerPixel / 2.0;
 
-    for (int pos = 0; pos < length; ++pos) {
-        const int visualFrameStart = std::lround(xVisualFrame - maxSamplingRange);
-        const int visualFrameStop = std::lround(xVisualFrame + maxSamplingRange);
-
-        const int visualIndexStart = std::max(visualFrameStart * 2, 0);
-        const int visualIndexStop =
-                std::min(std::max(visualFrameStop, visualFrameStart + 1) * 2, dataSize - 1);
-
-        const float fpos = static_cast<float>(pos);
-
-        // Find the max values for low, mid, high and all in the waveform data.
-        // - Max of left and right
-        uchar u8maxLow[2]{};
-        uchar u8maxMid[2]{};
-        uchar u8maxHigh[2]{};
-        // - Per channel
-        uchar u8maxAllChn[2]{};
-        for (int chn = 0; chn < 2; chn++) {
-            // In case we don't render individual color per channel, we use only
-            // the first field of the arrays to perform signal max
-            int signalChn = splitLeftRight ? chn : 0;
-            // data is interleaved left / right
-            for (int i = visualIndexStart + chn; i < visualIndexStop + chn; i += 2) {
-                const WaveformData& waveformData = data[i];
+    for (const auto& columnRange : columnRanges) {
+        for (int column = columnRange.first;
+                column < columnRange.first + columnRange.count;
+                ++column) {
+            // Effective visual frame for x
+            const double xVisualFrame = column * visualIncrementPerPixel;
+            const int visualFrameStart = std::lround(xVisualFrame - maxSamplingRange);
+            const int visualFrameStop = std::lround(xVisualFrame + maxSamplingRange);
+
+            const int visualIndexStart = std::max(visualFrameStart * 2, 0);
+            const int visualIndexStop =
+                    std::min(std::max(visualFrameStop, visualFrameStart + 1) * 2,
+                            dataSize - 1);
+
+            const float fpos = m_columnCache.x(column);
+            int vertexIndex = numVerticesPerLine +
+                    numVerticesPerColumn * m_columnCache.slot(column);
+
+            // Find the max values for low, mid, high and all in the waveform data.
+            // - Max of left and right
+            uchar u8maxLow[2]{};
+            uchar u8maxMid[2]{};
+            uchar u8maxHigh[2]{};
+            // - Per channel
+            uchar u8maxAllChn[2]{};
+            for (int chn = 0; chn < 2; chn++) {
+                // In case we don't render individual color per channel, we use only
+                // the first field of the arrays to perform signal max
+                int signalChn = splitLeftRight ? chn : 0;
+                const WaveformData waveformData = waveform->getMax(
+                        chn, visualIndexStart / 2, (visualIndexStop + 1) / 2);
 
                 u8maxLow[signalChn] = math_max(u8maxLow[signalChn], waveformData.filtered.low);
                 u8maxMid[signalChn] = math_max(u8maxMid[signalChn], waveformData.filtered.mid);
-                u8maxHigh[signalChn] = math_max(u8maxHigh[signalChn], waveformData.filtered.high);
-                u8maxAllChn[chn] = math_max(u8maxAllChn[chn], waveformData.filtered.all);
+                u8maxHigh[signalChn] =
+                        math_max(u8maxHigh[signalChn], waveformData.filtered.high);
+                u8maxAllChn[chn] = waveformData.filtered.all;
             }
-        }
-        float maxAllChn[2]{static_cast<float>(u8maxAllChn[0]), static_cast<float>(u8maxAllChn[1])};
-
-        // In case we don't render individual color per channel, all the
-        // signal information is in the first field of each array. If
-        // this is the split render, we only render the left channel
-        // anyway.
-        for (int chn = 0;
-                chn < (splitLeftRight && !m_isSlipRenderer ? 2 : 1);
-                chn++) {
-            // Cast to float
-            float maxLow = static_cast<float>(u8maxLow[chn]);
-            float maxMid = static_cast<float>(u8maxMid[chn]);
-            float maxHigh = static_cast<float>(u8maxHigh[chn]);
-
-            // Calculate the squared magnitude of the maxLow, maxMid and maxHigh values.
-            // We take the square root to get the magnitude below.
-            const float sum = math_pow2(maxLow) + math_pow2(maxMid) + math_pow2(maxHigh);
-
-            // Apply the gains
-            maxLow *= lowGain;
-            maxMid *= midGain;
-            maxHigh *= highGain;
-
-            // Calculate the squared magnitude of the gained maxLow, maxMid and maxHigh values
-            // We take the square root to get the magnitude below.
-            const float sumGained = math_pow2(maxLow) + math_pow2(maxMid) + math_pow2(maxHigh);
-
-            // The maxAll values will be used to draw the amplitude. We scale them according to
-            // magnitude of the gained maxLow, maxMid and maxHigh values
-            if (sum != 0.f) {
-                // magnitude = sqrt(sum) and magnitudeGained = sqrt(sumGained), and
-                // factor = magnitudeGained / magnitude, but we can do with a single sqrt:
-                const float factor = std::sqrt(sumGained / sum);
-                maxAllChn[chn] *= factor;
-                if (!splitLeftRight) {
-                    maxAllChn[chn + 1] *= factor;
+            float maxAllChn[2]{
+                    static_cast<float>(u8maxAllChn[0]), static_cast<float>(u8maxAllChn[1])};
+
+            // In case we don't render individual color per channel, all the
+            // signal information is in the first field of each array. If
+            // this is the split render, we only render the left channel
+            // anyway.
+            for (int chn = 0;
+                    chn < (splitLeftRight && !m_isSlipRenderer ? 2 : 1);
+                    chn++) {
+                // Cast to float
+                float maxLow = static_cast<float>(u8maxLow[chn]);
+                float maxMid = static_cast<float>(u8maxMid[chn]);
+                float maxHigh = static_cast<float>(u8maxHigh[chn]);
+
+                // Calculate the squared magnitude of the maxLow, maxMid and maxHigh values.
+                // We take the square root to get the magnitude below.
+                const float sum = math_pow2(maxLow) + math_pow2(maxMid) + math_pow2(maxHigh);
+
+                // Apply the gains
+                maxLow *= lowGain;
+                maxMid *= midGain;
+                maxHigh *= highGain;
+
+                // Calculate the squared magnitude of the gained maxLow, maxMid and maxHigh values
+                // We take the square root to get the magnitude below.
+                const float sumGained = math_pow2(maxLow) + math_pow2(maxMid) + math_pow2(maxHigh);
+
+                // The maxAll values will be used to draw the amplitude. We scale them according to
+                // magnitude of the gained maxLow, maxMid and maxHigh values
+                if (sum != 0.f) {
+                    // magnitude = sqrt(sum) and magnitudeGained = sqrt(sumGained), and
+                    // factor = magnitudeGained / magnitude, but we can do with a single sqrt:
+                    const float factor = std::sqrt(sumGained / sum);
+                    maxAllChn[chn] *= factor;
+                    if (!splitLeftRight) {
+                        maxAllChn[chn + 1] *= factor;
+                    }
                 }
-            }
 
-            // Use the gained maxLow, maxMid and maxHigh values to calculate the color components
-            float red = maxLow * low_r + maxMid * mid_r + maxHigh * high_r;
-            float green = maxLow * low_g + maxMid * mid_g + maxHigh * high_g;
-            float blue = maxLow * low_b + maxMid * mid_b + maxHigh * high_b;
-
-            // Normalize the color components using the maximum of the three
-            const float maxComponent = math_max3(red, green, blue);
-            if (maxComponent == 0.f) {
-                // Avoid division by 0
-                red = 0.f;
-                green = 0.f;
-                blue = 0.f;
-            } else {
-                const float normFactor = 1.f / maxComponent;
-                red *= normFactor;
-                green *= normFactor;
-                blue *= normFactor;
-            }
+                // Use the gained maxLow, maxMid and maxHigh values to calculate the color components
+                float red = maxLow * low_r + maxMid * mid_r + maxHigh * high_r;
+                float green = maxLow * low_g + maxMid * mid_g + maxHigh * high_g;
+                float blue = maxLow * low_b + maxMid * mid_b + maxHigh * high_b;
+
+                // Normalize the color components using the maximum of the three
+                const float maxComponent = math_max3(red, green, blue);
+                if (maxComponent == 0.f) {
+                    // Avoid division by 0
+                    red = 0.f;
+                    green = 0.f;
+                    blue = 0.f;
+                } else {
+                    const float normFactor = 1.f / maxComponent;
+                    red *= normFactor;
+                    green *= normFactor;
+                    blue *= normFactor;
+                }
 
-            // Lines are thin rectangles
-            if (!splitLeftRight) {
-                m_vertices.addRectangle(fpos - 0.5f,
-                        halfBreadth - heightFactorAbs * maxAllChn[0],
-                        fpos + 0.5f,
-                        m_isSlipRenderer
-                                ? halfBreadth
-                                : halfBreadth + heightFactorAbs * maxAllChn[1]);
-            } else {
-                // note: heightFactor is the same for left and right,
-                // but negative for left (chn 0) and positive for right (chn 1)
-                m_vertices.addRectangle(fpos - 0.5f,
-                        halfBreadth,
-                        fpos + 0.5f,
-                        halfBreadth + heightFactor[chn] * maxAllChn[chn]);
+                // Lines are thin rectangles
+                if (!splitLeftRight) {
+                    m_vertices.setRectangle(vertexIndex,
+                            fpos - 0.5f,
+                            halfBreadth - heightFactorAbs * maxAllChn[0],
+                            fpos + 0.5f,
+                            m_isSlipRenderer
+                                    ? halfBreadth
+                                    : halfBreadth + heightFactorAbs * maxAllChn[1]);
+                } else {
+                    // note: heightFactor is the same for left and right,
+                    // but negative for left (chn 0) and positive for right (chn 1)
+                    m_vertices.setRectangle(vertexIndex,
+                            fpos - 0.5f,
+                            halfBreadth,
+                            fpos + 0.5f,
+                            halfBreadth + heightFactor[chn] * maxAllChn[chn]);
+                }
+                m_colors.setForRectangle(vertexIndex, red, green, blue);
+                vertexIndex += numVerticesPerLine;
             }
-            m_colors.addForRectangle(red, green, blue);
         }
-
-        xVisualFrame += visualIncrementPerPixel;
     }
 
     DEBUG_ASSERT(reserved == m_vertices.size());
     DEBUG_ASSERT(reserved == m_colors.size());
 
-    const QMatrix4x4 matrix = matrixForWidgetGeometry(m_waveformRenderer, true);
+    QMatrix4x4 matrix = matrixForWidgetGeometry(m_waveformRenderer, true);
+    matrix.translate(m_columnCache.offset(), 0.f);
 
     const int matrixLocation = m_shader.matrixLocation();
     const int positionLocation = m_shader.positionLocation();
@@ -255,7 +277,13 @@ void WaveformRendererRGB::paintGL() {
     m_shader.setAttributeArray(
             colorLocation, GL_FLOAT, m_colors.constData(), 3);
 
-    glDrawArrays(GL_TRIANGLES, 0, m_vertices.size());
+    // The axis, followed by the ring buffer of columns which wraps around
+    // at the slot of the first visible column
+    const int firstSlotIndex =
+            numVerticesPerLine + numVerticesPerColumn * m_columnCache.firstSlot();
+    glDrawArrays(GL_TRIANGLES, 0, numVerticesPerLine);
+    glDrawArrays(GL_TRIANGLES, firstSlotIndex, reserved - firstSlotIndex);
+    glDrawArrays(GL_TRIANGLES, numVerticesPerLine, firstSlotIndex - numVerticesPerLine);
 
     m_shader.disableAttributeArray(positionLocation);
     m_shader.disableAttributeArray(colorLocation);
@@ -4,6 +4,7 @@
 #include "util/class.h"
 #include "waveform/renderers/allshader/rgbdata.h"
 #include "waveform/renderers/allshader/vertexdata.h"
+#include "waveform/renderers/allshader/waveformcolumncache.h"
 #include "waveform/renderers/allshader/waveformrenderersignalbase.h"
 
 namespace allshader {
@@ -31,6 +32,7 @@ class allshader::WaveformRendererRGB final : public allshader::WaveformRendererS
     mixxx::RGBShader m_shader;
     VertexData m_vertices;
     RGBData m_colors;
+    WaveformColumnCache m_columnCache;
 
     bool m_isSlipRenderer;
     WaveformRendererSignalBase::Options m_options;
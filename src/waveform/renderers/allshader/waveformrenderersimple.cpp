@@ -15,6 +15,7 @@ WaveformRendererSimple::WaveformRendererSimple(
 
 void WaveformRendererSimple::onSetup(const QDomNode& node) {
     Q_UNUSED(node);
+    m_columnCache.invalidate();
 }
 
 void WaveformRendererSimple::initializeGL() {
@@ -72,73 +73,87 @@ void WaveformRendererSimple::paintGL() {
 
     const float heightFactor = allGain * halfBreadth / m_maxValue;
 
-    // Effective visual frame for x, which we will increment for each pixel advanced
-    double xVisualFrame = qRound(firstVisualFrame / visualIncrementPerPixel) *
-            visualIncrementPerPixel;
-
     const int numVerticesPerLine = 6; // 2 triangles
 
+    // Only the columns that scrolled into view since the last frame are
+    // generated, see WaveformColumnCache. The ring buffer of columns is
+    // translated into place as a whole.
+    const int firstColumn = qRound(firstVisualFrame / visualIncrementPerPixel);
+    const auto columnRanges = m_columnCache.update(firstColumn,
+            {waveform,
+                    waveform->getCompletion(),
+                    length,
+                    visualIncrementPerPixel,
+                    breadth,
+                    {allGain}});
+
     int reserved[2];
 
-    reserved[0] = numVerticesPerLine * length;
-    m_vertices[0].clear();
-    m_vertices[0].reserve(reserved[0]);
+    reserved[0] = numVerticesPerLine * m_columnCache.slotCount();
+    if (m_vertices[0].size() != reserved[0]) {
+        m_vertices[0].resize(reserved[0]);
+    }
 
     // the horizontal line
     reserved[1] = numVerticesPerLine;
     m_vertices[1].clear();
     m_vertices[1].reserve(reserved[1]);
 
+    const float axisStart = m_columnCache.x(firstColumn);
     m_vertices[1].addRectangle(
-            0.f,
+            axisStart,
             halfBreadth - 0.5f * devicePixelRatio,
-            static_cast<float>(length),
+            axisStart + static_cast<float>(length),
             halfBreadth + 0.5f * devicePixelRatio);
 
     // We will iterate over a range of waveform data, centered around xVisualFrame
     const double maxSamplingRange = visualIncrementPerPixel / 2.0;
 
-    for (int pos = 0; pos < length; ++pos) {
-        // Calculate the start and end of the range of waveform data, centered around xVisualFrame
-        const int visualFrameStart = std::lround(xVisualFrame - maxSamplingRange);
-        const int visualFrameStop = std::lround(xVisualFrame + maxSamplingRange);
-
-        // Calculate the actual (deinterleaved) indices.
-        //
-        // Make sure we stay inside data at the lower boundary
-        const int visualIndexStart = std::max(visualFrameStart * 2, 0);
-        // and at the upper boundary.
-        // Note: * dataSize - 1, because below we add chn = 1
-        //       * visualFrameStart + 1, because we want to have at least 1 value
-        const int visualIndexStop =
-                std::min(std::max(visualFrameStop, visualFrameStart + 1) * 2, dataSize - 1);
-
-        // 2 channels
-        float max[2]{};
-
-        for (int chn = 0; chn < 2; chn++) {
-            // data is interleaved left / right
-            for (int i = visualIndexStart + chn; i < visualIndexStop + chn; i += 2) {
-                const WaveformData& waveformData = data[i];
-                const float filteredAll = static_cast<float>(waveformData.filtered.all);
-
-                max[chn] = math_max(max[chn], filteredAll);
+    for (const auto& columnRange : columnRanges) {
+        for (int column = columnRange.first;
+                column < columnRange.first + columnRange.count;
+                ++column) {
+            // Effective visual frame for x
+            const double xVisualFrame = column * visualIncrementPerPixel;
+
+            // Calculate the start and end of the range of waveform data, centered around xVisualFrame
+            const int visualFrameStart = std::lround(xVisualFrame - maxSamplingRange);
+            const int visualFrameStop = std::lround(xVisualFrame + maxSamplingRange);
+
+            // Calculate the actual (deinterleaved) indices.
+            //
+            // Make sure we stay inside data at the lower boundary
+            const int visualIndexStart = std::max(visualFrameStart * 2, 0);
+            // and at the upper boundary.
+            // Note: * dataSize - 1, because below we add chn = 1
+            //       * visualFrameStart + 1, because we want to have at least 1 value
+            const int visualIndexStop =
+                    std::min(std::max(visualFrameStop, visualFrameStart + 1) * 2,
+                            dataSize - 1);
+
+            // 2 channels
+            float max[2]{};
+
+            for (int chn = 0; chn < 2; chn++) {
+                const WaveformData waveformData = waveform->getMax(
+                        chn, visualIndexStart / 2, (visualIndexStop + 1) / 2);
+                max[chn] = static_cast<float>(waveformData.filtered.all);
             }
-        }
 
-        const float fpos = static_cast<float>(pos);
+            const float fpos = m_columnCache.x(column);
 
-        // lines are thin rectangles
-        m_vertices[0].addRectangle(
-                fpos - 0.5f,
-                halfBreadth - heightFactor * max[0],
-                fpos + 0.5f,
-                halfBreadth + heightFactor * max[1]);
-
-        xVisualFrame += visualIncrementPerPixel;
+            // lines are thin rectangles
+            m_vertices[0].setRectangle(
+                    numVerticesPerLine * m_columnCache.slot(column),
+                    fpos - 0.5f,
+                    halfBreadth - heightFactor * max[0],
+                    fpos + 0.5f,
+                    halfBreadth + heightFactor * max[1]);
+        }
     }
 
-    const QMatrix4x4 matrix = matrixForWidgetGeometry(m_waveformRenderer, true);
+    QMatrix4x4 matrix = matrixForWidgetGeometry(m_waveformRenderer, true);
+    matrix.translate(m_columnCache.offset(), 0.f);
 
     const int matrixLocation = m_shader.matrixLocation();
     const int colorLocation = m_shader.colorLocation();
@@ -164,7 +179,15 @@ void WaveformRendererSimple::paintGL() {
         m_shader.setAttributeArray(
                 positionLocation, GL_FLOAT, m_vertices[i].constData(), 2);
 
-        glDrawArrays(GL_TRIANGLES, 0, m_vertices[i].size());
+        if (i == 0) {
+            // The ring buffer of columns wraps around at the slot of the
+            // first visible column
+            const int firstSlotIndex = numVerticesPerLine * m_columnCache.firstSlot();
+            glDrawArrays(GL_TRIANGLES, firstSlotIndex, reserved[i] - firstSlotIndex);
+            glDrawArrays(GL_TRIANGLES, 0, firstSlotIndex);
+        } else {
+            glDrawArrays(GL_TRIANGLES, 0, m_vertices[i].size());
+        }
     }
 
     m_shader.disableAttributeArray(positionLocation);
@@ -3,6 +3,7 @@
 #include "shaders/unicolorshader.h"
 #include "util/class.h"
 #include "waveform/renderers/allshader/vertexdata.h"
+#include "waveform/renderers/allshader/waveformcolumncache.h"
 #include "waveform/renderers/allshader/waveformrenderersignalbase.h"
 
 namespace allshader {
@@ -22,6 +23,7 @@ class allshader::WaveformRendererSimple final : public allshader::WaveformRender
   private:
     mixxx::UnicolorShader m_shader;
     VertexData m_vertices[2];
+    WaveformColumnCache m_columnCache;
 
     DISALLOW_COPY_AND_ASSIGN(WaveformRendererSimple);
 };
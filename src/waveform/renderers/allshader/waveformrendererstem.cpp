@@ -146,12 +146,9 @@ void WaveformRendererStem::paintGL() {
                 // - Max of left and right
                 uchar u8max{};
                 for (int chn = 0; chn < 2; chn++) {
-                    // data is interleaved left / right
-                    for (int i = visualIndexStart + chn; i < visualIndexStop + chn; i += 2) {
-                        const WaveformData& waveformData = data[i];
-
-                        u8max = math_max(u8max, waveformData.stems[stemIdx]);
-                    }
+                    const WaveformData waveformData = waveform->getMax(
+                            chn, visualIndexStart / 2, (visualIndexStop + 1) / 2);
+                    u8max = math_max(u8max, waveformData.stems[stemIdx]);
                 }
 
                 // Cast to float
@@ -1,13 +1,54 @@
 #include "waveform/waveform.h"
 
 #include <QtDebug>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
 
 #include "analyzer/constants.h"
 #include "engine/engine.h"
 #include "proto/waveform.pb.h"
+#include "util/assert.h"
+#include "util/math.h"
 
 using namespace mixxx::track;
 
+namespace {
+
+constexpr char kPackedMagic[4] = {'M', 'X', 'W', 'P'};
+constexpr quint32 kPackedFormatVersion = 1;
+
+// Header of the packed format, followed by dataSize elements of either
+// WaveformFilteredData (stemCount == 0) or WaveformData (stemCount > 0).
+struct PackedWaveformHeader {
+    char magic[4];
+    quint32 formatVersion;
+    qint32 dataSize;
+    qint32 stemCount;
+    double visualSampleRate;
+    double audioVisualRatio;
+};
+
+static_assert(std::is_trivially_copyable_v<PackedWaveformHeader>);
+static_assert(std::is_trivially_copyable_v<WaveformData>);
+static_assert(offsetof(WaveformData, filtered) == 0);
+
+std::size_t packedElementSize(int stemCount) {
+    return stemCount > 0 ? sizeof(WaveformData) : sizeof(WaveformFilteredData);
+}
+
+inline void storeMax(WaveformData* pMax, const WaveformData& data) {
+    pMax->filtered.low = math_max(pMax->filtered.low, data.filtered.low);
+    pMax->filtered.mid = math_max(pMax->filtered.mid, data.filtered.mid);
+    pMax->filtered.high = math_max(pMax->filtered.high, data.filtered.high);
+    pMax->filtered.all = math_max(pMax->filtered.all, data.filtered.all);
+    for (int stemIdx = 0; stemIdx < mixxx::kMaxSupportedStems; ++stemIdx) {
+        pMax->stems[stemIdx] = math_max(pMax->stems[stemIdx], data.stems[stemIdx]);
+    }
+}
+
+} // anonymous namespace
+
 // Return the smallest power of 2 which is greater than the desired size when
 // squared.
 int computeTextureStride(int size) {
@@ -25,7 +66,9 @@ Waveform::Waveform(const QByteArray& data)
           m_visualSampleRate(0),
           m_audioVisualRatio(0),
           m_textureStride(computeTextureStride(0)),
-          m_completion(-1) {
+          m_completion(-1),
+          m_stemCount(0),
+          m_maxPyramidLevelCount(-1) {
     readByteArray(data);
 }
 
@@ -42,7 +85,8 @@ Waveform::Waveform(
           m_audioVisualRatio(0),
           m_textureStride(1024),
           m_completion(-1),
-          m_stemCount(stemCount) {
+          m_stemCount(stemCount),
+          m_maxPyramidLevelCount(-1) {
     int numberOfVisualSamples = 0;
     if (audioSampleRate > 0) {
         if (maxVisualSamples == -1) {
@@ -151,11 +195,89 @@ QByteArray Waveform::toByteArray() const {
     return QByteArray(output.data(), static_cast<int>(output.length()));
 }
 
+QByteArray Waveform::toPackedByteArray() const {
+    const int dataSize = getDataSize();
+    const std::size_t elementSize = packedElementSize(m_stemCount);
+    QByteArray packed(static_cast<int>(sizeof(PackedWaveformHeader) +
+                              dataSize * elementSize),
+            Qt::Uninitialized);
+    PackedWaveformHeader header;
+    std::memcpy(header.magic, kPackedMagic, sizeof(header.magic));
+    header.formatVersion = kPackedFormatVersion;
+    header.dataSize = dataSize;
+    header.stemCount = m_stemCount;
+    header.visualSampleRate = m_visualSampleRate;
+    header.audioVisualRatio = m_audioVisualRatio;
+    char* pOut = packed.data();
+    std::memcpy(pOut, &header, sizeof(header));
+    pOut += sizeof(header);
+    if (m_stemCount > 0) {
+        std::memcpy(pOut, m_data.data(), dataSize * elementSize);
+    } else {
+        for (int i = 0; i < dataSize; ++i) {
+            std::memcpy(pOut, &m_data[i].filtered, elementSize);
+            pOut += elementSize;
+        }
+    }
+    return packed;
+}
+
+// static
+bool Waveform::isPackedByteArray(const QByteArray& data) {
+    return data.size() >= static_cast<int>(sizeof(PackedWaveformHeader)) &&
+            std::memcmp(data.constData(), kPackedMagic, sizeof(kPackedMagic)) == 0;
+}
+
+bool Waveform::readPackedByteArray(const QByteArray& data) {
+    PackedWaveformHeader header;
+    std::memcpy(&header, data.constData(), sizeof(header));
+    if (header.formatVersion != kPackedFormatVersion) {
+        qWarning() << "Unsupported packed waveform format version"
+                   << header.formatVersion;
+        return false;
+    }
+    if (header.dataSize < 0 || header.stemCount < 0 ||
+            header.stemCount > mixxx::kMaxSupportedStems) {
+        qWarning() << "Invalid packed waveform header";
+        return false;
+    }
+    const std::size_t elementSize = packedElementSize(header.stemCount);
+    if (static_cast<std::size_t>(data.size()) !=
+            sizeof(header) + header.dataSize * elementSize) {
+        qWarning() << "Unexpected size of packed waveform data:"
+                   << data.size();
+        return false;
+    }
+
+    assign(header.dataSize);
+    m_stemCount = header.stemCount;
+    m_visualSampleRate = header.visualSampleRate;
+    m_audioVisualRatio = header.audioVisualRatio;
+    const char* pIn = data.constData() + sizeof(header);
+    if (m_stemCount > 0) {
+        std::memcpy(m_data.data(), pIn, m_dataSize * elementSize);
+    } else {
+        for (int i = 0; i < m_dataSize; ++i) {
+            std::memcpy(&m_data[i].filtered, pIn, elementSize);
+            pIn += elementSize;
+        }
+    }
+
+    m_completion = m_dataSize;
+    m_saveState = SaveState::Saved;
+    return true;
+}
+
 void Waveform::readByteArray(const QByteArray& data) {
     if (data.isNull()) {
         return;
     }
 
+    if (isPackedByteArray(data)) {
+        readPackedByteArray(data);
+        return;
+    }
+
     io::Waveform waveform;
 
     if (!waveform.ParseFromArray(data.constData(), data.size())) {
@@ -235,7 +357,9 @@ void Waveform::readByteArray(const QByteArray& data) {
     }
 
     m_completion = dataSize;
-    m_saveState = SaveState::Saved;
+    // Rewritten in the packed format when the analyses of the track are
+    // saved the next time
+    m_saveState = SaveState::SavePending;
 }
 
 void Waveform::resize(int size) {
@@ -251,6 +375,78 @@ void Waveform::assign(int size) {
     m_saveState = SaveState::SavePending;
 }
 
+// Returns the number of levels, which is 0 while the waveform is incomplete
+int Waveform::buildMaxPyramid() const {
+    // The data of incomplete waveforms is still written by the analyzer
+    if (getCompletion() < m_dataSize) {
+        return 0;
+    }
+    const auto locker = lockMutex(&m_mutex);
+    const int builtLevelCount = m_maxPyramidLevelCount.loadAcquire();
+    if (builtLevelCount >= 0) {
+        return builtLevelCount;
+    }
+    std::vector<std::vector<WaveformData>> maxPyramid;
+    const WaveformData* pPrevLevel = m_data.data();
+    int prevFrameCount = m_dataSize / 2;
+    while (prevFrameCount > 1) {
+        const int frameCount = (prevFrameCount + 1) / 2;
+        std::vector<WaveformData> level(frameCount * 2);
+        for (int frame = 0; frame < frameCount; ++frame) {
+            for (int chn = 0; chn < 2; ++chn) {
+                WaveformData max = pPrevLevel[frame * 4 + chn];
+                if (frame * 2 + 1 < prevFrameCount) {
+                    storeMax(&max, pPrevLevel[frame * 4 + 2 + chn]);
+                }
+                level[frame * 2 + chn] = max;
+            }
+        }
+        maxPyramid.push_back(std::move(level));
+        pPrevLevel = maxPyramid.back().data();
+        prevFrameCount = frameCount;
+    }
+    m_maxPyramid = std::move(maxPyramid);
+    const int levelCount = static_cast<int>(m_maxPyramid.size());
+    // Publish the levels for concurrent readers
+    m_maxPyramidLevelCount.storeRelease(levelCount);
+    return levelCount;
+}
+
+WaveformData Waveform::getMax(int chn, int frameStart, int frameStop) const {
+    WaveformData max{};
+    // Each level halves the range [lo, hi) after the unaligned blocks at
+    // its boundaries have been consumed. The last level is scanned.
+    int lo = math_max(frameStart, 0);
+    int hi = math_min(frameStop, m_dataSize / 2);
+    int levelCount = m_maxPyramidLevelCount.loadAcquire();
+    if (levelCount < 0) {
+        levelCount = buildMaxPyramid();
+    }
+    const WaveformData* pLevel = m_data.data();
+    int level = 0;
+    while (lo < hi) {
+        if (level >= levelCount) {
+            for (int frame = lo; frame < hi; ++frame) {
+                storeMax(&max, pLevel[frame * 2 + chn]);
+            }
+            break;
+        }
+        if (lo & 1) {
+            storeMax(&max, pLevel[lo * 2 + chn]);
+            ++lo;
+        }
+        if (hi & 1) {
+            --hi;
+            storeMax(&max, pLevel[hi * 2 + chn]);
+        }
+        lo /= 2;
+        hi /= 2;
+        pLevel = m_maxPyramid[level].data();
+        ++level;
+    }
+    return max;
+}
+
 void Waveform::dump() const {
     qDebug() << "Waveform" << this
              << "size(" + QString::number(getDataSize()) + ")"
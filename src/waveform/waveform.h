@@ -75,8 +75,20 @@ class Waveform {
         m_description = description;
     }
 
+    /// Serialize into the protobuf format that is used for
+    /// exchanging waveforms and for legacy analysis files.
     QByteArray toByteArray() const;
 
+    /// Serialize into a fixed binary layout that could be read back
+    /// with a single copy, i.e. without parsing or decompressing.
+    /// The layout depends on the native byte order and is only intended
+    /// for local storage.
+    QByteArray toPackedByteArray() const;
+
+    /// Check if the data has been created by toPackedByteArray().
+    /// The constructor accepts both the packed and the protobuf format.
+    static bool isPackedByteArray(const QByteArray& data);
+
     SaveState saveState() const {
         return m_saveState;
     }
@@ -133,12 +145,23 @@ class Waveform {
         return m_stemCount > 0;
     }
 
+    /// The maxima of all values of the given channel within the
+    /// visual frames [frameStart, frameStop).
+    ///
+    /// The first invocation after the waveform is complete precomputes
+    /// the maxima for blocks of 2^n visual frames. This allows to find
+    /// the maxima of arbitrary ranges in logarithmic time, e.g. when
+    /// rendering zoomed out waveforms.
+    WaveformData getMax(int chn, int frameStart, int frameStop) const;
+
     void dump() const;
 
   private:
     void readByteArray(const QByteArray& data);
+    bool readPackedByteArray(const QByteArray& data);
     void resize(int size);
     void assign(int size);
+    int buildMaxPyramid() const;
 
     inline WaveformData& at(int i) { return m_data[i];}
     inline unsigned char& low(int i) { return m_data[i].filtered.low;}
@@ -181,6 +204,13 @@ class Waveform {
     // The number of stem contained in waveform samples. 0 if not a stem waveform
     int m_stemCount;
 
+    // Level n contains the maxima of m_data for blocks of 2^(n+1) visual
+    // frames, interleaved like m_data. Built on demand by getMax() and not
+    // allowed to change after the number of levels has been published.
+    // The number of levels is -1 until then.
+    mutable std::vector<std::vector<WaveformData>> m_maxPyramid;
+    mutable QAtomicInt m_maxPyramidLevelCount;
+
     mutable QMutex m_mutex;
 
     DISALLOW_COPY_AND_ASSIGN(Waveform);
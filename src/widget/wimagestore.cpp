@@ -5,6 +5,7 @@
 #include <QPainter>
 
 #include "skin/legacy/imgloader.h"
+#include "skin/legacy/skinimagecache.h"
 
 // static
 QHash<ImageKey, std::weak_ptr<QImage>> WImageStore::m_dictionary;
@@ -57,22 +58,29 @@ std::shared_ptr<QImage> WImageStore::getImage(const PixmapSource& source, double
 // static
 QImage* WImageStore::getImageNoCache(const PixmapSource& source, double scaleFactor) {
     if (source.isSVG()) {
-        QSvgRenderer renderer;
+        if (source.getPath().isEmpty()) {
+            return nullptr;
+        }
 
-        if (!source.getPath().isEmpty()) {
-            if (!renderer.load(source.getPath())) {
-                // The above line already logs a warning
-                return nullptr;
-            }
-        } else {
+        QImage cachedImage = SkinImageCache::loadImage(source.getPath(), scaleFactor);
+        if (!cachedImage.isNull()) {
+            return new QImage(std::move(cachedImage));
+        }
+
+        QSvgRenderer renderer;
+        if (!renderer.load(source.getPath())) {
+            // The above line already logs a warning
             return nullptr;
         }
 
         auto* pImage = new QImage(renderer.defaultSize() * scaleFactor,
                 QImage::Format_ARGB32_Premultiplied);
         pImage->fill(Qt::transparent);
-        QPainter painter(pImage);
-        renderer.render(&painter);
+        {
+            QPainter painter(pImage);
+            renderer.render(&painter);
+        }
+        SkinImageCache::storeImage(source.getPath(), scaleFactor, *pImage);
         return pImage;
     } else {
         return m_loader->getImage(source.getPath(), scaleFactor);
@@ -4,6 +4,8 @@
 #include <QApplication>
 #include <QWindow>
 #endif
+#include <QDir>
+#include <QFileDialog>
 #include <QUrl>
 
 #include "config.h"
@@ -13,6 +15,7 @@
 #include "util/cmdlineargs.h"
 #include "util/desktophelper.h"
 #include "util/experiment.h"
+#include "util/tracerecorder.h"
 #include "vinylcontrol/defs_vinylcontrol.h"
 
 namespace {
@@ -589,6 +592,19 @@ void WMainMenuBar::initialize() {
                 &WMainMenuBar::slotDeveloperDebugger);
         pDeveloperMenu->addAction(pDeveloperDebugger);
 
+        QString saveTraceTitle = tr("Save Audio &Trace...");
+        QString saveTraceText = tr(
+                "Saves a timeline of the recent audio processing, e.g. to "
+                "investigate the cause of audio dropouts");
+        auto* pDeveloperSaveTrace = new QAction(saveTraceTitle, this);
+        pDeveloperSaveTrace->setStatusTip(saveTraceText);
+        pDeveloperSaveTrace->setWhatsThis(buildWhatsThis(saveTraceTitle, saveTraceText));
+        connect(pDeveloperSaveTrace,
+                &QAction::triggered,
+                this,
+                &WMainMenuBar::slotDeveloperSaveTrace);
+        pDeveloperMenu->addAction(pDeveloperSaveTrace);
+
         addMenu(pDeveloperMenu);
     }
 
@@ -886,6 +902,17 @@ void WMainMenuBar::slotDeveloperDebugger(bool toggle) {
                    ConfigValue(toggle ? 1 : 0));
 }
 
+void WMainMenuBar::slotDeveloperSaveTrace() {
+    const QString filePath = QFileDialog::getSaveFileName(this,
+            tr("Save Audio Trace"),
+            QDir::home().filePath(QStringLiteral("mixxx-trace.json")),
+            tr("Trace Files (*.json)"));
+    if (filePath.isEmpty()) {
+        return;
+    }
+    mixxx::TraceRecorder::writeChromeTrace(filePath);
+}
+
 void WMainMenuBar::slotVisitUrl(const QUrl& url) {
     mixxx::DesktopHelper::openUrl(url);
 }
@@ -95,6 +95,7 @@ class WMainMenuBar : public QMenuBar {
     void slotDeveloperStatsExperiment(bool enable);
     void slotDeveloperStatsBase(bool enable);
     void slotDeveloperDebugger(bool toggle);
+    void slotDeveloperSaveTrace();
     void slotVisitUrl(const QUrl& url);
 
   private:
@@ -7,6 +7,7 @@
 #include <QPainter>
 #include <QPen>
 #include <QVBoxLayout>
+#include <QtConcurrentRun>
 
 #include "analyzer/analyzerprogress.h"
 #include "control/controlproxy.h"
@@ -26,6 +27,13 @@
 #include "widget/controlwidgetconnection.h"
 #include "wskincolor.h"
 
+namespace {
+
+// Bounds the rate of overview updates while a track is being analyzed
+constexpr int kMinRenderIntervalMillis = 100;
+
+} // namespace
+
 WOverview::WOverview(
         const QString& group,
         PlayerManager* pPlayerManager,
@@ -65,7 +73,19 @@ WOverview::WOverview(
                   QStringLiteral("track_samples")),
           m_playpositionControl(
                   m_group,
-                  QStringLiteral("playposition")) {
+                  QStringLiteral("playposition")),
+          m_renderGeneration(0),
+          m_renderPending(false) {
+    m_renderTimer.setSingleShot(true);
+    connect(&m_renderTimer,
+            &QTimer::timeout,
+            this,
+            &WOverview::requestWaveformRender);
+    connect(&m_renderWatcher,
+            &QFutureWatcher<RenderJob>::finished,
+            this,
+            &WOverview::slotWaveformRendered);
+
     m_endOfTrackControl = make_parented<ControlProxy>(
             m_group, QStringLiteral("end_of_track"), this, ControlFlag::NoAssertIfMissing);
     m_endOfTrackControl->connectValueChanged(this, &WOverview::onEndOfTrackChange);
@@ -117,6 +137,12 @@ WOverview::WOverview(
     connect(m_pCueMenuPopup.get(), &WCueMenuPopup::aboutToHide, this, &WOverview::slotCueMenuPopupAboutToHide);
 }
 
+WOverview::~WOverview() {
+    // The job only holds copies, but its result must not be delivered to
+    // a destroyed widget
+    m_renderWatcher.waitForFinished();
+}
+
 void WOverview::setup(const QDomNode& node, const SkinContext& context) {
     m_scaleFactor = context.getScaleFactor();
     m_signalColors.setup(node, context);
@@ -305,30 +331,144 @@ void WOverview::slotWaveformSummaryUpdated() {
     if (m_pWaveform) {
         // If the waveform is already complete, just draw it.
         if (m_pWaveform->getCompletion() == m_pWaveform->getDataSize()) {
-            m_actualCompletion = 0;
-            if (drawNextPixmapPart()) {
-                update();
-            }
+            resetWaveformImage();
+            requestWaveformRender();
         }
     } else {
         // Null waveform pointer means waveform was cleared.
-        m_waveformSourceImage = QImage();
+        resetWaveformImage();
+        m_waveformImageScaled = QImage();
         m_analyzerProgress = kAnalyzerProgressUnknown;
-        m_actualCompletion = 0;
-        m_waveformPeak = -1.0;
-        m_pixmapDone = false;
 
         update();
     }
 }
 
+void WOverview::resetWaveformImage() {
+    // A running job still draws into the previous image, its result is
+    // discarded
+    ++m_renderGeneration;
+    m_waveformSourceImage = QImage();
+    m_actualCompletion = 0;
+    m_waveformPeak = -1.0;
+    m_pixmapDone = false;
+}
+
+void WOverview::requestWaveformRender() {
+    if (m_renderWatcher.isRunning()) {
+        m_renderPending = true;
+        return;
+    }
+    if (m_lastRenderStart.isValid()) {
+        const qint64 remainingMillis = kMinRenderIntervalMillis - m_lastRenderStart.elapsed();
+        if (remainingMillis > 0) {
+            if (!m_renderTimer.isActive()) {
+                m_renderTimer.start(static_cast<int>(remainingMillis));
+            }
+            return;
+        }
+    }
+    m_renderTimer.stop();
+    m_renderPending = false;
+
+    ConstWaveformPointer pWaveform = getWaveform();
+    if (!pWaveform) {
+        return;
+    }
+
+    WaveformWidgetFactory* widgetFactory = WaveformWidgetFactory::instance();
+    RenderJob job;
+    job.generation = m_renderGeneration;
+    job.pWaveform = pWaveform;
+    job.type = m_type;
+    job.signalColors = m_signalColors;
+    job.trackSamples = getTrackSamples();
+    job.length = length();
+    job.scaledSize = size() * m_devicePixelRatio;
+    job.orientation = m_orientation;
+    job.normalize = widgetFactory->isOverviewNormalized();
+    job.visualGain = static_cast<float>(
+            widgetFactory->getVisualGain(WaveformWidgetFactory::All));
+    // The job continues drawing into the source image, which is only
+    // accessed by one thread at a time. The GUI thread keeps painting the
+    // current scaled image until the job has finished.
+    job.sourceImage = std::move(m_waveformSourceImage);
+    m_waveformSourceImage = QImage();
+    job.scaledImage = m_waveformImageScaled;
+    job.actualCompletion = m_actualCompletion;
+    job.pixmapDone = m_pixmapDone;
+    job.waveformPeak = m_waveformPeak;
+    job.diffGain = m_diffGain;
+
+    m_lastRenderStart.start();
+    m_renderWatcher.setFuture(QtConcurrent::run(&WOverview::renderWaveform, std::move(job)));
+}
+
+// watcher
+void WOverview::slotWaveformRendered() {
+    RenderJob job = m_renderWatcher.result();
+    if (job.generation == m_renderGeneration) {
+        const bool changed = job.scaledImage.constBits() != m_waveformImageScaled.constBits();
+        m_waveformSourceImage = std::move(job.sourceImage);
+        m_waveformImageScaled = std::move(job.scaledImage);
+        m_actualCompletion = job.actualCompletion;
+        m_pixmapDone = job.pixmapDone;
+        m_waveformPeak = job.waveformPeak;
+        m_diffGain = job.diffGain;
+        if (changed) {
+            update();
+        }
+    } else {
+        // The image has been reset in the meantime
+        m_renderPending = true;
+    }
+    if (m_renderPending) {
+        requestWaveformRender();
+    }
+}
+
+// static
+WOverview::RenderJob WOverview::renderWaveform(RenderJob job) {
+    ScopedTimer t(QStringLiteral("WOverview::renderWaveform"));
+    const bool sourceImageChanged = drawNextPixmapPart(&job);
+    if (job.sourceImage.isNull()) {
+        return job;
+    }
+
+    float diffGain;
+    if (job.normalize && job.pixmapDone && job.waveformPeak > 1) {
+        diffGain = 255 - job.waveformPeak - 1;
+    } else {
+        diffGain = 255.0f - (255.0f / job.visualGain);
+    }
+
+    if (sourceImageChanged || job.diffGain != diffGain || job.scaledImage.isNull() ||
+            job.scaledImage.size() != job.scaledSize) {
+        QRect sourceRect(0,
+                static_cast<int>(diffGain),
+                job.sourceImage.width(),
+                job.sourceImage.height() -
+                        2 * static_cast<int>(diffGain));
+        QImage croppedImage = job.sourceImage.copy(sourceRect);
+        if (job.orientation == Qt::Vertical) {
+            // Rotate pixmap
+            croppedImage = croppedImage.transformed(QTransform(0, 1, 1, 0, 0, 0));
+        }
+        job.scaledImage = croppedImage.scaled(job.scaledSize,
+                Qt::IgnoreAspectRatio,
+                Qt::SmoothTransformation);
+        job.diffGain = diffGain;
+    }
+    return job;
+}
+
 void WOverview::onTrackAnalyzerProgress(TrackId trackId, AnalyzerProgress analyzerProgress) {
     if (!m_pCurrentTrack || (m_pCurrentTrack->getId() != trackId)) {
         return;
     }
 
-    bool updateNeeded = drawNextPixmapPart();
-    if (updateNeeded || (m_analyzerProgress != analyzerProgress)) {
+    requestWaveformRender();
+    if (m_analyzerProgress != analyzerProgress) {
         m_analyzerProgress = analyzerProgress;
         update();
     }
@@ -360,11 +500,9 @@ void WOverview::slotLoadingTrack(TrackPointer pNewTrack, TrackPointer pOldTrack)
                 &WOverview::receiveCuesUpdated);
     }
 
-    m_waveformSourceImage = QImage();
+    resetWaveformImage();
+    m_waveformImageScaled = QImage();
     m_analyzerProgress = kAnalyzerProgressUnknown;
-    m_actualCompletion = 0;
-    m_waveformPeak = -1.0;
-    m_pixmapDone = false;
     // Note: Here we already have the new track, but the engine and it's
     // Control Objects may still have the old one until the slotTrackLoaded()
     // signal has been received.
@@ -443,7 +581,7 @@ void WOverview::slotMinuteMarkersChanged(bool /*unused*/) {
 }
 
 void WOverview::slotNormalizeOrVisualGainChanged() {
-    update();
+    requestWaveformRender();
 }
 
 void WOverview::updateCues(const QList<CuePointer> &loadedCues) {
@@ -701,36 +839,9 @@ void WOverview::drawAxis(QPainter* pPainter) {
 }
 
 void WOverview::drawWaveformPixmap(QPainter* pPainter) {
-    WaveformWidgetFactory* widgetFactory = WaveformWidgetFactory::instance();
-    if (!m_waveformSourceImage.isNull()) {
+    // The scaled image is rendered in the background, see renderWaveform()
+    if (!m_waveformImageScaled.isNull()) {
         PainterScope painterScope(pPainter);
-        float diffGain;
-        bool normalize = widgetFactory->isOverviewNormalized();
-        if (normalize && m_pixmapDone && m_waveformPeak > 1) {
-            diffGain = 255 - m_waveformPeak - 1;
-        } else {
-            const auto visualGain = static_cast<float>(
-                    widgetFactory->getVisualGain(WaveformWidgetFactory::All));
-            diffGain = 255.0f - (255.0f / visualGain);
-        }
-
-        if (m_diffGain != diffGain || m_waveformImageScaled.isNull()) {
-            QRect sourceRect(0,
-                    static_cast<int>(diffGain),
-                    m_waveformSourceImage.width(),
-                    m_waveformSourceImage.height() -
-                            2 * static_cast<int>(diffGain));
-            QImage croppedImage = m_waveformSourceImage.copy(sourceRect);
-            if (m_orientation == Qt::Vertical) {
-                // Rotate pixmap
-                croppedImage = croppedImage.transformed(QTransform(0, 1, 1, 0, 0, 0));
-            }
-            m_waveformImageScaled = croppedImage.scaled(size() * m_devicePixelRatio,
-                    Qt::IgnoreAspectRatio,
-                    Qt::SmoothTransformation);
-            m_diffGain = diffGain;
-        }
-
         pPainter->drawImage(rect(), m_waveformImageScaled);
     }
 }
@@ -781,7 +892,7 @@ void WOverview::drawMinuteMarkers(QPainter* pPainter) {
 
 void WOverview::drawPlayedOverlay(QPainter* pPainter) {
     // Overlay the played part of the overview-waveform with a skin defined color
-    if (!m_waveformSourceImage.isNull() && m_playedOverlayColor.alpha() > 0) {
+    if (!m_waveformImageScaled.isNull() && m_playedOverlayColor.alpha() > 0) {
         if (m_orientation == Qt::Vertical) {
             pPainter->fillRect(0,
                     0,
@@ -1311,92 +1422,92 @@ void WOverview::drawMarkLabels(QPainter* pPainter, const float offset, const flo
 }
 
 void WOverview::drawPassthroughOverlay(QPainter* pPainter) {
-    if (!m_waveformSourceImage.isNull() && m_passthroughOverlayColor.alpha() > 0) {
+    if (!m_waveformImageScaled.isNull() && m_passthroughOverlayColor.alpha() > 0) {
         // Overlay the entire overview-waveform with a skin defined color
         pPainter->fillRect(rect(), m_passthroughOverlayColor);
     }
 }
 
-bool WOverview::drawNextPixmapPart() {
-    ConstWaveformPointer pWaveform = getWaveform();
+// static
+bool WOverview::drawNextPixmapPart(RenderJob* pJob) {
+    const ConstWaveformPointer& pWaveform = pJob->pWaveform;
     if (!pWaveform) {
         return false;
     }
 
     const int dataSize = pWaveform->getDataSize();
     const double audioVisualRatio = pWaveform->getAudioVisualRatio();
-    const double trackSamples = getTrackSamples();
+    const double trackSamples = pJob->trackSamples;
     if (dataSize <= 0 || audioVisualRatio <= 0 || trackSamples <= 0) {
         return false;
     }
 
-    if (m_waveformSourceImage.isNull()) {
+    if (pJob->sourceImage.isNull()) {
         // Waveform pixmap twice the height of the viewport to be scalable
         // by total_gain
         // We keep full range waveform data to scale it on paint
-        m_waveformSourceImage = QImage(
+        pJob->sourceImage = QImage(
                 static_cast<int>(trackSamples / audioVisualRatio / 2) + 1,
                 2 * 255,
                 QImage::Format_ARGB32_Premultiplied);
-        m_waveformSourceImage.fill(QColor(0, 0, 0, 0).value());
-        if (dataSize / 2 != m_waveformSourceImage.width()) {
+        pJob->sourceImage.fill(QColor(0, 0, 0, 0).value());
+        if (dataSize / 2 != pJob->sourceImage.width()) {
             qWarning() << "Track duration has changed since last analysis"
-                       << m_waveformSourceImage.width() << "!=" << dataSize / 2;
+                       << pJob->sourceImage.width() << "!=" << dataSize / 2;
         }
     }
-    DEBUG_ASSERT(!m_waveformSourceImage.isNull());
+    DEBUG_ASSERT(!pJob->sourceImage.isNull());
 
     // Always multiple of 2
     const int waveformCompletion = pWaveform->getCompletion();
     // Test if there is some new to draw (at least of pixel width)
-    const int completionIncrement = waveformCompletion - m_actualCompletion;
+    const int completionIncrement = waveformCompletion - pJob->actualCompletion;
 
-    int visiblePixelIncrement = completionIncrement * length() / dataSize;
+    int visiblePixelIncrement = completionIncrement * pJob->length / dataSize;
     if (waveformCompletion < (dataSize - 2) &&
             (completionIncrement < 2 || visiblePixelIncrement == 0)) {
         return false;
     }
 
-    const int nextCompletion = m_actualCompletion + completionIncrement;
+    const int nextCompletion = pJob->actualCompletion + completionIncrement;
 
     // qDebug() << "WOverview::drawNextPixmapPart() - nextCompletion:"
     //  << nextCompletion
-    //  << "m_actualCompletion:" << m_actualCompletion
+    //  << "actualCompletion:" << pJob->actualCompletion
     //  << "waveformCompletion:" << waveformCompletion
     //  << "completionIncrement:" << completionIncrement;
 
-    QPainter painter(&m_waveformSourceImage);
-    painter.translate(0.0, static_cast<double>(m_waveformSourceImage.height()) / 2.0);
+    QPainter painter(&pJob->sourceImage);
+    painter.translate(0.0, static_cast<double>(pJob->sourceImage.height()) / 2.0);
 
-    if (m_type == Type::Filtered) {
-        drawNextPixmapPartLMH(&painter, pWaveform, nextCompletion);
-    } else if (m_type == Type::HSV) {
-        drawNextPixmapPartHSV(&painter, pWaveform, nextCompletion);
+    if (pJob->type == Type::Filtered) {
+        drawNextPixmapPartLMH(&painter, pJob, nextCompletion);
+    } else if (pJob->type == Type::HSV) {
+        drawNextPixmapPartHSV(&painter, pJob, nextCompletion);
     } else { // Type::RGB:
-        drawNextPixmapPartRGB(&painter, pWaveform, nextCompletion);
+        drawNextPixmapPartRGB(&painter, pJob, nextCompletion);
     }
 
-    m_waveformImageScaled = QImage();
-    m_diffGain = 0;
-
     // Test if the complete waveform is done
-    if (m_actualCompletion >= dataSize - 2) {
-        m_pixmapDone = true;
-        // qDebug() << "m_waveformPeakRatio" << m_waveformPeak;
+    if (pJob->actualCompletion >= dataSize - 2) {
+        pJob->pixmapDone = true;
+        // qDebug() << "waveformPeak" << pJob->waveformPeak;
     }
 
     return true;
 }
 
+// static
 void WOverview::drawNextPixmapPartHSV(QPainter* pPainter,
-        ConstWaveformPointer pWaveform,
+        RenderJob* pJob,
         const int nextCompletion) {
-    DEBUG_ASSERT(!m_waveformSourceImage.isNull());
+    DEBUG_ASSERT(!pJob->sourceImage.isNull());
+    const ConstWaveformPointer& pWaveform = pJob->pWaveform;
     ScopedTimer t(QStringLiteral("WOverview::drawNextPixmapPartHSV"));
 
     // Get HSV of low color.
     float h, s, v;
-    getHsvF(m_signalColors.getLowColor(), &h, &s, &v);
+    getHsvF(pJob->signalColors.getLowColor(), &h, &s, &v);
 
     QColor color;
     float lo, hi, total;
@@ -1407,7 +1518,7 @@ void WOverview::drawNextPixmapPartHSV(QPainter* pPainter,
     unsigned char maxAll[2] = {0, 0};
 
     int currentCompletion = 0;
-    for (int currentCompletion = m_actualCompletion;
+    for (int currentCompletion = pJob->actualCompletion;
             currentCompletion < nextCompletion;
             currentCompletion += 2) {
         maxAll[0] = pWaveform->getAll(currentCompletion);
@@ -1444,35 +1555,37 @@ void WOverview::drawNextPixmapPartHSV(QPainter* pPainter,
     }
 
     // Evaluate waveform ratio peak
-    for (currentCompletion = m_actualCompletion;
+    for (currentCompletion = pJob->actualCompletion;
             currentCompletion < nextCompletion;
             currentCompletion += 2) {
-        m_waveformPeak = math_max3(
-                m_waveformPeak,
+        pJob->waveformPeak = math_max3(
+                pJob->waveformPeak,
                 static_cast<float>(pWaveform->getAll(currentCompletion)),
                 static_cast<float>(pWaveform->getAll(currentCompletion + 1)));
     }
 
-    m_actualCompletion = nextCompletion;
+    pJob->actualCompletion = nextCompletion;
 }
 
+// static
 void WOverview::drawNextPixmapPartLMH(QPainter* pPainter,
-        ConstWaveformPointer pWaveform,
+        RenderJob* pJob,
         const int nextCompletion) {
-    DEBUG_ASSERT(!m_waveformSourceImage.isNull());
+    DEBUG_ASSERT(!pJob->sourceImage.isNull());
+    const ConstWaveformPointer& pWaveform = pJob->pWaveform;
     ScopedTimer t(QStringLiteral("WOverview::drawNextPixmapPartLMH"));
 
-    QColor lowColor = m_signalColors.getLowColor();
+    QColor lowColor = pJob->signalColors.getLowColor();
     QPen lowColorPen(QBrush(lowColor), 1);
 
-    QColor midColor = m_signalColors.getMidColor();
+    QColor midColor = pJob->signalColors.getMidColor();
     QPen midColorPen(QBrush(midColor), 1);
 
-    QColor highColor = m_signalColors.getHighColor();
+    QColor highColor = pJob->signalColors.getHighColor();
     QPen highColorPen(QBrush(highColor), 1);
 
     int currentCompletion = 0;
-    for (currentCompletion = m_actualCompletion;
+    for (currentCompletion = pJob->actualCompletion;
             currentCompletion < nextCompletion;
             currentCompletion += 2) {
         unsigned char lowNeg = pWaveform->getLow(currentCompletion);
@@ -1484,7 +1597,7 @@ void WOverview::drawNextPixmapPartLMH(QPainter* pPainter,
         }
     }
 
-    for (currentCompletion = m_actualCompletion;
+    for (currentCompletion = pJob->actualCompletion;
             currentCompletion < nextCompletion;
             currentCompletion += 2) {
         pPainter->setPen(midColorPen);
@@ -1494,7 +1607,7 @@ void WOverview::drawNextPixmapPartLMH(QPainter* pPainter,
                         pWaveform->getMid(currentCompletion + 1)));
     }
 
-    for (currentCompletion = m_actualCompletion;
+    for (currentCompletion = pJob->actualCompletion;
             currentCompletion < nextCompletion;
             currentCompletion += 2) {
         pPainter->setPen(highColorPen);
@@ -1506,37 +1619,39 @@ void WOverview::drawNextPixmapPartLMH(QPainter* pPainter,
 
     // Evaluate waveform ratio peak
 
-    for (currentCompletion = m_actualCompletion;
+    for (currentCompletion = pJob->actualCompletion;
             currentCompletion < nextCompletion;
             currentCompletion += 2) {
-        m_waveformPeak = math_max3(
-                m_waveformPeak,
+        pJob->waveformPeak = math_max3(
+                pJob->waveformPeak,
                 static_cast<float>(pWaveform->getAll(currentCompletion)),
                 static_cast<float>(pWaveform->getAll(currentCompletion + 1)));
     }
 
-    m_actualCompletion = nextCompletion;
+    pJob->actualCompletion = nextCompletion;
 }
 
+// static
 void WOverview::drawNextPixmapPartRGB(QPainter* pPainter,
-        ConstWaveformPointer pWaveform,
+        RenderJob* pJob,
         const int nextCompletion) {
-    DEBUG_ASSERT(!m_waveformSourceImage.isNull());
+    DEBUG_ASSERT(!pJob->sourceImage.isNull());
+    const ConstWaveformPointer& pWaveform = pJob->pWaveform;
     ScopedTimer t(QStringLiteral("WOverview::drawNextPixmapPartRGB"));
 
     QColor color;
 
     float lowColor_r, lowColor_g, lowColor_b;
-    getRgbF(m_signalColors.getRgbLowColor(), &lowColor_r, &lowColor_g, &lowColor_b);
+    getRgbF(pJob->signalColors.getRgbLowColor(), &lowColor_r, &lowColor_g, &lowColor_b);
 
     float midColor_r, midColor_g, midColor_b;
-    getRgbF(m_signalColors.getRgbMidColor(), &midColor_r, &midColor_g, &midColor_b);
+    getRgbF(pJob->signalColors.getRgbMidColor(), &midColor_r, &midColor_g, &midColor_b);
 
     float highColor_r, highColor_g, highColor_b;
-    getRgbF(m_signalColors.getRgbHighColor(), &highColor_r, &highColor_g, &highColor_b);
+    getRgbF(pJob->signalColors.getRgbHighColor(), &highColor_r, &highColor_g, &highColor_b);
 
     int currentCompletion = 0;
-    for (currentCompletion = m_actualCompletion;
+    for (currentCompletion = pJob->actualCompletion;
             currentCompletion < nextCompletion;
             currentCompletion += 2) {
         unsigned char left = pWaveform->getAll(currentCompletion);
@@ -1582,16 +1697,16 @@ void WOverview::drawNextPixmapPartRGB(QPainter* pPainter,
     }
 
     // Evaluate waveform ratio peak
-    for (currentCompletion = m_actualCompletion;
+    for (currentCompletion = pJob->actualCompletion;
             currentCompletion < nextCompletion;
             currentCompletion += 2) {
-        m_waveformPeak = math_max3(
-                m_waveformPeak,
+        pJob->waveformPeak = math_max3(
+                pJob->waveformPeak,
                 static_cast<float>(pWaveform->getAll(currentCompletion)),
                 static_cast<float>(pWaveform->getAll(currentCompletion + 1)));
     }
 
-    m_actualCompletion = nextCompletion;
+    pJob->actualCompletion = nextCompletion;
 }
 
 void WOverview::paintText(const QString& text, QPainter* pPainter) {
@@ -1650,8 +1765,8 @@ void WOverview::resizeEvent(QResizeEvent* pEvent) {
 
     m_devicePixelRatio = devicePixelRatioF();
 
-    m_waveformImageScaled = QImage();
-    m_diffGain = 0;
+    // The current image is stretched until it has been rescaled
+    requestWaveformRender();
     Init();
 }
 
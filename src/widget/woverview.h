@@ -1,8 +1,11 @@
 #pragma once
 
 #include <QColor>
+#include <QElapsedTimer>
+#include <QFutureWatcher>
 #include <QList>
 #include <QPixmap>
+#include <QTimer>
 
 #include "analyzer/analyzerprogress.h"
 #include "track/track_decl.h"
@@ -28,6 +31,7 @@ class WOverview : public WWidget, public TrackDropTarget {
             PlayerManager* pPlayerManager,
             UserSettingsPointer pConfig,
             QWidget* parent = nullptr);
+    ~WOverview() override;
 
     void setup(const QDomNode& node, const SkinContext& context);
     virtual void initWithTrack(TrackPointer pTrack);
@@ -71,6 +75,7 @@ class WOverview : public WWidget, public TrackDropTarget {
     void receiveCuesUpdated();
 
     void slotWaveformSummaryUpdated();
+    void slotWaveformRendered();
     void slotCueMenuPopupAboutToHide();
 
     void slotTypeControlChanged(double v);
@@ -78,17 +83,50 @@ class WOverview : public WWidget, public TrackDropTarget {
     void slotNormalizeOrVisualGainChanged();
 
   private:
+    /// The waveform images are rendered on a worker thread. The job gets a
+    /// copy of everything it needs and hands the images back to the GUI
+    /// thread, which only blits the scaled image.
+    struct RenderJob {
+        // Increased whenever the waveform image is reset, results of
+        // outdated jobs are discarded
+        int generation = 0;
+        ConstWaveformPointer pWaveform;
+        Type type = Type::RGB;
+        WaveformSignalColors signalColors;
+        double trackSamples = 0.0;
+        int length = 0;
+        QSize scaledSize;
+        Qt::Orientation orientation = Qt::Horizontal;
+        bool normalize = false;
+        float visualGain = 1.0f;
+
+        // Carried over between jobs
+        QImage sourceImage;
+        QImage scaledImage;
+        int actualCompletion = 0;
+        bool pixmapDone = false;
+        float waveformPeak = -1.0f;
+        float diffGain = 0.0f;
+    };
+
+    static RenderJob renderWaveform(RenderJob job);
+    /// Start rendering the waveform images in the background, at most once
+    /// per kMinRenderIntervalMillis. Requests while a job is running are
+    /// coalesced into a single follow-up job.
+    void requestWaveformRender();
+    void resetWaveformImage();
+
     // Append the waveform overview pixmap according to available data
     // in waveform
-    bool drawNextPixmapPart();
-    void drawNextPixmapPartHSV(QPainter* pPainter,
-            ConstWaveformPointer pWaveform,
+    static bool drawNextPixmapPart(RenderJob* pJob);
+    static void drawNextPixmapPartHSV(QPainter* pPainter,
+            RenderJob* pJob,
             const int nextCompletion);
-    void drawNextPixmapPartLMH(QPainter* pPainter,
-            ConstWaveformPointer pWaveform,
+    static void drawNextPixmapPartLMH(QPainter* pPainter,
+            RenderJob* pJob,
             const int nextCompletion);
-    void drawNextPixmapPartRGB(QPainter* pPainter,
-            ConstWaveformPointer pWaveform,
+    static void drawNextPixmapPartRGB(QPainter* pPainter,
+            RenderJob* pJob,
             const int nextCompletion);
 
     void drawEndOfTrackBackground(QPainter* pPainter);
@@ -217,4 +255,9 @@ class WOverview : public WWidget, public TrackDropTarget {
     WaveformMarkLabel m_cuePositionLabel;
     WaveformMarkLabel m_cueTimeDistanceLabel;
 
+    int m_renderGeneration;
+    bool m_renderPending;
+    QFutureWatcher<RenderJob> m_renderWatcher;
+    QElapsedTimer m_lastRenderStart;
+    QTimer m_renderTimer;
 };